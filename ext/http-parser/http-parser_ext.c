@@ -9,8 +9,10 @@
 
 #include "ruby.h"
 #include "http_parser.h"
+#include "http_parser_table.h"
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #define true 1
 #define false 0
@@ -20,8 +22,20 @@ VALUE mHttp;                /* module Http */
 VALUE cHttpParser;          /* class Http::Parser */
 VALUE cHttpRequestParser;   /* class Http::RequestParser */
 VALUE cHttpResponseParser;  /* class Http::ResponseParser */
+VALUE cHttpRouter;          /* class Http::Router */
+VALUE cHttpParserTable;     /* class Http::ParserTable */
+VALUE cHttpParsedHeaders;   /* class Http::ParsedHeaders */
 VALUE eHttpParserError;     /* class Http::Parser::Error  */
 
+/* Http:: method constants, indexed by enum http_method */
+static VALUE hpe_methods[ HTTP_EXTENSION_METHOD ];
+
+/* Http::Parser::Error#code values, indexed by enum http_errno */
+static VALUE hpe_error_codes[ HPE_UNKNOWN + 1 ];
+
+/* interned once in Init_http_parser_ext */
+static ID hpe_id_query_string_buffer;   /* @query_string_buffer */
+
 /***
  * Callback Error handling:
  *
@@ -149,25 +163,333 @@ int hpe_##FOR##_data_cb( http_parser *parser,                          \
 };                                                                     \
 HPE_CALLBACK_SETTER(FOR,data_cb)
 
+/* generator for body forwarding callback methods, called with the stream
+ * offset and length of the bytes instead of the bytes */
+#define HPE_RANGE_CALLBACK(FOR)                                        \
+int hpe_##FOR##_range_cb( http_parser *parser,                         \
+                          uint64_t offset, size_t length)              \
+{                                                                      \
+    VALUE rb_parser = (VALUE)parser->data;                             \
+    VALUE callable  = rb_iv_get( rb_parser, "@" #FOR "_callback" );    \
+    int had_error   = false;                                           \
+                                                                       \
+    if ( Qnil != callable ) {                                          \
+        hpe_protected_t protected;                                     \
+        VALUE           result;                                        \
+        VALUE           cb_exception = Qnil;                           \
+        VALUE           args[3];                                       \
+                                                                       \
+        args[0] = rb_parser;                                           \
+        args[1] = ULL2NUM( offset );                                   \
+        args[2] = ULL2NUM( length );                                   \
+                                                                       \
+        protected.instance = (VALUE)callable;                          \
+        protected.method   = rb_intern("call");                        \
+        protected.argc     = 3;                                        \
+        protected.argv     = args;                                     \
+                                                                       \
+        result = rb_protect( hpe_wrap_funcall2, (VALUE)&protected,     \
+                             &had_error);                              \
+        if (had_error) {                                               \
+            cb_exception = rb_gv_get("$!");                            \
+        }                                                              \
+        rb_iv_set( rb_parser, "@callback_exception", cb_exception);    \
+    }                                                                  \
+    return had_error;                                                  \
+};                                                                     \
+HPE_CALLBACK_SETTER(FOR,range_cb)
+
 /* common callacks */
 HPE_CALLBACK(on_message_begin);
 HPE_DATA_CALLBACK(on_header_field);
 HPE_DATA_CALLBACK(on_header_value);
 HPE_CALLBACK(on_headers_complete);
+HPE_DATA_CALLBACK(on_chunk_extension);
+HPE_CALLBACK(on_chunk_header);
+HPE_CALLBACK(on_chunk_complete);
 HPE_DATA_CALLBACK(on_body);
 HPE_CALLBACK(on_message_complete);
+HPE_RANGE_CALLBACK(on_body_range);
+HPE_RANGE_CALLBACK(on_framing_range);
 
 /* only used by Http::Request */
+HPE_DATA_CALLBACK(on_extension_method);
+HPE_DATA_CALLBACK(on_scheme);
+HPE_DATA_CALLBACK(on_host);
 HPE_DATA_CALLBACK(on_path);
+HPE_CALLBACK(on_route);
 HPE_DATA_CALLBACK(on_query_string);
 HPE_DATA_CALLBACK(on_uri);
 HPE_DATA_CALLBACK(on_fragment);
 
+/*
+ * Request parsers with collect_query_string set have these two installed.
+ * They keep the raw query string of the current request in
+ * @query_string_buffer, across parse_chunk calls, for query_params and
+ * then hand on to the Ruby callbacks.
+ */
+int hpe_request_on_message_begin( http_parser *parser )
+{
+    rb_ivar_set( (VALUE)parser->data, hpe_id_query_string_buffer, Qnil );
+    return hpe_on_message_begin_cb( parser );
+}
+
+int hpe_request_on_query_string( http_parser *parser, const char *at, size_t length )
+{
+    VALUE rb_parser = (VALUE)parser->data;
+    VALUE buffer    = rb_ivar_get( rb_parser, hpe_id_query_string_buffer );
+
+    /* query_string_size includes this piece, so they are equal for the
+     * first piece of a query string */
+    if ( Qnil == buffer || parser->query_string_size == length ) {
+        rb_ivar_set( rb_parser, hpe_id_query_string_buffer, rb_str_new( at, length ) );
+    } else {
+        rb_str_cat( buffer, at, length );
+    }
+    return hpe_on_query_string_data_cb( parser, at, length );
+}
+
+#define HPE_COLLECTS_QUERY_STRING( parser ) \
+    ( (parser)->on_query_string == hpe_request_on_query_string )
+
+VALUE hpe_request_parser_on_message_begin( VALUE self, VALUE callable )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    rb_iv_set( self, "@on_message_begin_callback", callable );
+    if ( HPE_COLLECTS_QUERY_STRING( parser ) ) {
+        return callable;
+    }
+    return hpe_parser_on_message_begin( self, callable );
+}
+
+VALUE hpe_request_parser_on_query_string( VALUE self, VALUE callable )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    rb_iv_set( self, "@on_query_string_callback", callable );
+    if ( HPE_COLLECTS_QUERY_STRING( parser ) ) {
+        return callable;
+    }
+    return hpe_parser_on_query_string( self, callable );
+}
+
+/*
+ * call-seq:
+ *   request_parser.collect_query_string = true or false
+ *
+ * Keep the query string of each request, across parse_chunk calls, for
+ * +query_params+.  Off by default, so requests are not copied for a
+ * method that is never called.
+ */
+VALUE hpe_request_parser_set_collect_query_string( VALUE self, VALUE collect )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( RTEST( collect ) ) {
+        parser->on_message_begin = hpe_request_on_message_begin;
+        parser->on_query_string  = hpe_request_on_query_string;
+    } else {
+        rb_ivar_set( self, hpe_id_query_string_buffer, Qnil );
+        hpe_parser_on_message_begin( self, rb_iv_get( self, "@on_message_begin_callback" ) );
+        hpe_parser_on_query_string( self, rb_iv_get( self, "@on_query_string_callback" ) );
+    }
+    return collect;
+}
+
+static int hpe_unhex( char c )
+{
+    if ( c >= '0' && c <= '9' ) return c - '0';
+    return ( tolower( c ) - 'a' ) + 10;
+}
+
+/* a new String of the percent and '+' decoding of at[0 .. length) */
+static VALUE hpe_query_unescape( const char *at, long length )
+{
+    VALUE       str = rb_str_new( NULL, length );
+    char       *out = RSTRING_PTR( str );
+    const char *end = at + length;
+    long        n   = 0;
+
+    while ( at < end ) {
+        if ( '+' == *at ) {
+            out[n++] = ' ';
+            at += 1;
+        } else if ( '%' == *at && end - at > 2 && isxdigit( at[1] ) && isxdigit( at[2] ) ) {
+            out[n++] = (char)( hpe_unhex( at[1] ) << 4 | hpe_unhex( at[2] ) );
+            at += 3;
+        } else {
+            out[n++] = *at++;
+        }
+    }
+    rb_str_resize( str, n );
+    return str;
+}
+
+/* deepest a[b][c]... key query_params will nest */
+#define HPE_MAX_QUERY_DEPTH 32
+
+typedef struct hpe_segment {
+    const char *at;
+    long        length;
+} hpe_segment_t;
+
+/* the Hash or Array at params[key], created if it is not there yet */
+static VALUE hpe_query_child( VALUE params, VALUE key, VALUE klass )
+{
+    VALUE child = rb_hash_aref( params, key );
+
+    if ( Qnil == child ) {
+        child = ( rb_cArray == klass ) ? rb_ary_new() : rb_hash_new();
+        rb_hash_aset( params, key, child );
+    } else if ( !rb_obj_is_kind_of( child, klass ) ) {
+        rb_raise( rb_eTypeError, "expected %s (got %s) for param `%s'",
+                  rb_class2name( klass ), rb_obj_classname( child ),
+                  RSTRING_PTR( key ) );
+    }
+    return child;
+}
+
+/* Rack style nesting of value under the decoded key a[b][]... split into
+ * segs */
+static void hpe_query_nest( VALUE params, hpe_segment_t *segs, int nsegs, VALUE value )
+{
+    VALUE key = rb_obj_freeze( rb_str_new( segs[0].at, segs[0].length ) );
+    VALUE child, last;
+
+    if ( 1 == nsegs ) {
+        rb_hash_aset( params, key, value );
+    } else if ( 0 == segs[1].length ) {
+        child = hpe_query_child( params, key, rb_cArray );
+        if ( 2 == nsegs ) {
+            rb_ary_push( child, value );
+            return;
+        }
+        /* a[][b]=1&a[][c]=2 fill in one Hash, a[][b]=1&a[][b]=2 start another */
+        last = rb_ary_entry( child, -1 );
+        if ( Qnil == last || T_HASH != TYPE( last ) ||
+             Qundef != rb_hash_lookup2( last, rb_str_new( segs[2].at, segs[2].length ),
+                                        Qundef ) ) {
+            last = rb_hash_new();
+            rb_ary_push( child, last );
+        }
+        hpe_query_nest( last, segs + 2, nsegs - 2, value );
+    } else {
+        child = hpe_query_child( params, key, rb_cHash );
+        hpe_query_nest( child, segs + 1, nsegs - 1, value );
+    }
+}
+
+/* split at[0 .. length) into name[a][b]... segments, a key that is not of
+ * that form is a single segment */
+static int hpe_query_segments( const char *at, long length, hpe_segment_t *segs )
+{
+    const char *end = at + length;
+    const char *open = memchr( at, '[', length );
+    const char *close;
+    int         n = 1;
+
+    segs[0].at     = at;
+    segs[0].length = length;
+    if ( NULL == open || open == at || end[-1] != ']' ) {
+        return 1;
+    }
+    segs[0].length = open - at;
+    while ( open < end ) {
+        if ( '[' != *open || NULL == ( close = memchr( open, ']', end - open ) ) ||
+             HPE_MAX_QUERY_DEPTH == n ) {
+            segs[0].length = length;
+            return 1;
+        }
+        segs[n].at     = open + 1;
+        segs[n].length = close - open - 1;
+        n++;
+        open = close + 1;
+    }
+    return n;
+}
+
+/*
+ * call-seq:
+ *   request_parser.query_params( nested = false ) -> Hash
+ *
+ * The query string of the current request split into a Hash of its
+ * decoded parameters.  A parameter without an '=' has a nil value and
+ * when a name is repeated the last value wins.  Keys are frozen.
+ *
+ * With +nested+ keys are nested as Rack does, 'a[b]=1&a[c][]=2' gives
+ * { "a" => { "b" => "1", "c" => [ "2" ] } }.
+ *
+ * The query string is complete once the request line has been parsed,
+ * call this from +on_headers_complete+ or later in the same request.  nil
+ * unless +collect_query_string+ is set.
+ */
+VALUE hpe_parser_query_params( int argc, VALUE *argv, VALUE self )
+{
+    http_parser  *parser;
+    VALUE         nested;
+    VALUE         buffer = rb_ivar_get( self, hpe_id_query_string_buffer );
+    VALUE         params;
+    VALUE         key, value;
+    const char   *at, *end, *pair_end, *eq;
+    hpe_segment_t segs[ HPE_MAX_QUERY_DEPTH ];
+
+    rb_scan_args( argc, argv, "01", &nested );
+    Data_Get_Struct( self, http_parser, parser );
+    if ( !HPE_COLLECTS_QUERY_STRING( parser ) ) {
+        return Qnil;
+    }
+    params = rb_hash_new();
+    if ( Qnil == buffer ) {
+        return params;
+    }
+
+    at  = RSTRING_PTR( buffer );
+    end = at + RSTRING_LEN( buffer );
+    for ( ; at < end ; at = pair_end + 1 ) {
+        if ( NULL == ( pair_end = memchr( at, '&', end - at ) ) ) {
+            pair_end = end;
+        }
+        if ( pair_end == at ) {
+            continue;
+        }
+        if ( NULL != ( eq = memchr( at, '=', pair_end - at ) ) ) {
+            value = hpe_query_unescape( eq + 1, pair_end - eq - 1 );
+        } else {
+            eq    = pair_end;
+            value = Qnil;
+        }
+
+        key = hpe_query_unescape( at, eq - at );
+        if ( RTEST( nested ) ) {
+            hpe_query_nest( params, segs,
+                            hpe_query_segments( RSTRING_PTR( key ), RSTRING_LEN( key ), segs ),
+                            value );
+        } else {
+            rb_hash_aset( params, rb_obj_freeze( key ), value );
+        }
+    }
+    return params;
+}
+
 
 /* free the http_parser memory */
 void hpe_free( http_parser* parser )
 {
     parser->data = NULL;
+    xfree( parser->path_decoder.buf );
+    xfree( parser->query_string_decoder.buf );
+    xfree( (http_header_set *)parser->header_filter );
+    xfree( parser->header_name );
+    xfree( parser->route );
+    if ( parser->arena ) {
+        http_arena_free( parser->arena );
+        xfree( parser->arena );
+    }
+    xfree( parser->headers );
     xfree( parser );
     return;
 }
@@ -205,62 +527,111 @@ VALUE hpe_parser_status_code( VALUE self )
  * call-seq:
  *   request_parser.method -> String
  *
- * Return the HTTP Method used for the request.
+ * Return the HTTP Method used for the request.  For the known methods
+ * this is one of the Http method constants, e.g. Http::GET, for an
+ * extension method it is a new String.
  */
 VALUE hpe_parser_method( VALUE self )
 {
     http_parser *parser;
-    ID           const_get = rb_intern("const_get");
-    VALUE        method; 
-
-    Data_Get_Struct( self, http_parser, parser );
-    switch ( parser->method ) {
-    case HTTP_COPY:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("COPY"));       
-        break;
-    case HTTP_DELETE:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("DELETE"));
-        break;
-    case HTTP_GET:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("GET" ));
-        break;
-    case HTTP_HEAD:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("HEAD" ));
-        break;
-    case HTTP_LOCK:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("LOCK" ));
-        break;
-    case HTTP_MKCOL:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("MKCOL"));
-        break;
-    case HTTP_MOVE:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("MOVE"));
-        break;
-    case HTTP_OPTIONS:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("OPTIONS"));
-        break;
-    case HTTP_POST:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("POST"));
-        break;
-    case HTTP_PROPFIND:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("PROPFIND"));
-        break;
-    case HTTP_PROPPATCH:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("PROPPATCH" ));
-        break;
-    case HTTP_PUT:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("PUT"));
-        break;
-    case HTTP_TRACE:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("TRACE"));
-        break;
-    case HTTP_UNLOCK:
-        method = rb_funcall( mHttp, const_get, 1, rb_str_new2("UNLOCK"));
-        break;
-    default:
-      rb_raise(eHttpParserError, "Invalid Request Method");
-      break;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( HTTP_EXTENSION_METHOD == parser->method ) {
+        return rb_str_new( parser->method_token.buf, parser->method_size );
+    }
+    if ( HTTP_NO_METHOD == parser->method || parser->method > HTTP_EXTENSION_METHOD ) {
+        rb_raise(eHttpParserError, "Invalid Request Method");
+    }
+    return hpe_methods[ parser->method ];
+}
+
+/*
+ * call-seq:
+ *   request_parser.decode_buffer_size = size
+ *
+ * Percent-decode the path and query string of each request, into buffers
+ * of +size+ bytes, as they are parsed.  A path or query string that decodes
+ * to more than +size+ bytes is a parse error with the code
+ * :decode_overflow.  Set it to nil to stop decoding.  Raises ArgumentError
+ * unless +size+ is greater than 0.
+ */
+VALUE hpe_parser_set_decode_buffer_size( VALUE self, VALUE size )
+{
+    http_parser *parser;
+    size_t       n = 0;
+    char        *path_buf = NULL;
+    char        *query_buf = NULL;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( Qnil != size ) {
+        if ( NUM2LONG( size ) <= 0 ) {
+            rb_raise( rb_eArgError, "decode buffer size must be a number greater than 0" );
+        }
+        n         = NUM2SIZET( size );
+        path_buf  = xrealloc( parser->path_decoder.buf, n );
+        query_buf = xrealloc( parser->query_string_decoder.buf, n );
+    } else {
+        xfree( parser->path_decoder.buf );
+        xfree( parser->query_string_decoder.buf );
+    }
+    http_parser_decode_path( parser, path_buf, n );
+    http_parser_decode_query_string( parser, query_buf, n );
+    return size;
+}
+
+/*
+ * call-seq:
+ *   request_parser.decoded_path -> String or nil
+ *
+ * The percent-decoded path of the request, complete once the last
+ * +on_path+ callback has been made and available until the request is
+ * complete.  nil unless decode_buffer_size has been set.
+ */
+VALUE hpe_parser_decoded_path( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( NULL == parser->path_decoder.buf ) {
+        return Qnil;
+    }
+    return rb_str_new( parser->path_decoder.buf, parser->path_decoder.len );
+}
+
+/*
+ * call-seq:
+ *   request_parser.decoded_query_string -> String or nil
+ *
+ * As decoded_path, for the query string.  A '+' in the query string is
+ * decoded to a space.
+ */
+VALUE hpe_parser_decoded_query_string( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( NULL == parser->query_string_decoder.buf ) {
+        return Qnil;
+    }
+    return rb_str_new( parser->query_string_decoder.buf, parser->query_string_decoder.len );
+}
+
+/*
+ * call-seq:
+ *   request_parser.port -> Integer or nil
+ *
+ * The port given in an absolute-form request target, or in the
+ * host:port of a CONNECT, nil if the target did not have one.
+ */
+VALUE hpe_parser_port( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( 0 == parser->port ) {
+        return Qnil;
     }
+    return INT2FIX( parser->port );
 }
 
 /*
@@ -285,211 +656,1692 @@ VALUE hpe_parser_chunked_encoding( VALUE self )
 
 /*
  * call-seq:
- *   parser.version -> Version string
+ *   parser.trailer? -> true or false
  *
- * Return the version string of the request/response being parsed.
+ * Are the header callbacks currently being invoked for the trailing
+ * headers that follow the last chunk of a chunked body?
  *
  */
-VALUE hpe_parser_version( VALUE self )
+VALUE hpe_parser_trailer( VALUE self )
 {
     http_parser *parser;
-    char         v[4];
 
     Data_Get_Struct( self, http_parser, parser );
-
-    snprintf(v, 4, "%d.%d", parser->version_major, parser->version_minor );
-
-    return rb_str_new2( v );
+    if ( parser->flags & HTTP_FLAG_TRAILER ) {
+        return Qtrue;
+    }
+    return Qfalse;
 }
 
-
 /*
  * call-seq:
- *   parser.keep_alive? -> true or false
+ *   parser.skip_body? -> true or false
  *
- * Does this request/response support keep_alive?
+ * Will the current message be treated as having no body?
  *
  */
-VALUE hpe_parser_keep_alive( VALUE self )
+VALUE hpe_parser_skip_body( VALUE self )
 {
     http_parser *parser;
-    int          ka;
 
     Data_Get_Struct( self, http_parser, parser );
-    if ( http_parser_should_keep_alive( parser ) )  {
+    if ( parser->flags & HTTP_FLAG_SKIP_BODY ) {
         return Qtrue;
-    } else {
-        return Qfalse;
     }
+    return Qfalse;
 }
 
-
 /*
  * call-seq:
- *   parser.content_length -> Integer
+ *   parser.skip_body = true or false
  *
- * The content length of the body of the request/response being parsed.
+ * Tell the parser the current message has no body regardless of its
+ * Content-Length or Transfer-Encoding headers.  Set this before parsing
+ * the response to a HEAD request, or from +on_headers_complete+.  It is
+ * cleared after every message.
+ *
+ * Responses with a 1xx, 204 or 304 status never have a body, there is no
+ * need to set it for those.
  *
  */
-VALUE hpe_parser_content_length( VALUE self )
+VALUE hpe_parser_set_skip_body( VALUE self, VALUE skip )
 {
     http_parser *parser;
-    size_t       content_length;
-    VALUE        rc;
 
     Data_Get_Struct( self, http_parser, parser );
-    content_length = parser->content_length;
-    rc = ULL2NUM( content_length );
-   
-    return rc;
+    if ( RTEST( skip ) ) {
+        parser->flags |= HTTP_FLAG_SKIP_BODY;
+    } else {
+        parser->flags &= ~HTTP_FLAG_SKIP_BODY;
+    }
+    return skip;
 }
 
-
 /*
  * call-seq:
- *   parser.parse_chunk( String ) -> nil
- *
- * Parse the given hunk of data invoking the callbacks as appropriate.
- *
- * If an error is encountered, an exception is thrown.  This could be
- * one of two things:
- *
- * 1) The error happened in the callback, in that case that exception is
- *    reraised
- * 2) Internal error in the parser, in this case an new excpetion is
- *    raised
+ *   parser.expect_continue? -> true or false
  *
- * If there is an on_error callback, then it is invoked. In both cases
- * the parser and the input chunk are passed to the +on_error+ callback.
- * The receiver of the callback can interrogate the parser and see if
- * there was an error from some other callback.
+ * Did the request have an "Expect: 100-continue" header?  This is known
+ * by +on_headers_complete+, which is the time to send the interim
+ * "100 Continue" response, or to reject the request before the client
+ * sends the body.
  *
  */
-VALUE hpe_parser_parse_chunk( VALUE self, VALUE chunk )
+VALUE hpe_parser_expect_continue( VALUE self )
 {
     http_parser *parser;
-    VALUE       str = StringValue( chunk );
-    char*       chunk_p = RSTRING_PTR( str );
 
     Data_Get_Struct( self, http_parser, parser );
-    http_parser_execute( parser, chunk_p, RSTRING_LEN(str) );
-
-    if ( http_parser_has_error( parser ) ) {
-        VALUE callback = rb_iv_get( self, "@on_error_callback" );
-        VALUE exception = rb_iv_get( self, "@callback_exception" );
-
-        if ( Qnil == exception ) {
-            rb_iv_set( self, "@internal_parser_error", Qtrue );
-        }
-
-        if ( Qnil == callback ) {
-            rb_raise(eHttpParserError, "Failure during parsing of chunk [%s]",
-                    chunk_p);
-        } else {
-            rb_funcall( callback, rb_intern("call"), 2, self, chunk );
-        } 
+    if ( parser->flags & HTTP_FLAG_EXPECT_CONTINUE ) {
+        return Qtrue;
     }
-    return Qnil;
+    return Qfalse;
 }
 
 /*
  * call-seq:
- *   RequestParser.new
+ *   parser.upgrade? -> true or false
  *
- * Create a new HTTP Request parser.
+ * Was the message a CONNECT request or a protocol upgrade (e.g. a
+ * WebSocket handshake)?  If so +parse_chunk+ stopped at the end of the
+ * headers and returned the offset of the first tunnelled byte, and the
+ * parser will not parse anything else.
  *
  */
-VALUE hpe_request_parser_initialize( VALUE self )
+VALUE hpe_parser_upgrade( VALUE self )
 {
     http_parser *parser;
 
     Data_Get_Struct( self, http_parser, parser );
-    http_parser_init( parser, HTTP_REQUEST );
-
-    rb_call_super( 0, NULL );
-
-    /* we use the data field in the parser to point to the Ruby Object
-     * that wraps it
-     */
-    parser->data = (void*)self;
-    rb_iv_set( self, "@on_path_callback", Qnil);
-    rb_iv_set( self, "@on_uri_callback", Qnil);
-    rb_iv_set( self, "@on_fragment_callback", Qnil);
-    rb_iv_set( self, "@on_query_string_callback", Qnil);
-
-    return self;
+    if ( parser->flags & HTTP_FLAG_UPGRADE ) {
+        return Qtrue;
+    }
+    return Qfalse;
 }
 
 /*
  * call-seq:
- *   ResponseParser.new
+ *   parser.headers_only = true or false
  *
- * Create a new HTTP Response parser.
+ * Stop +parse_chunk+ at the start of every body.  It returns the offset of
+ * the body in the chunk, after +on_headers_complete+, and +body_pending?+
+ * is true until the message is complete.  The body can then be forwarded
+ * without the parser looking at it, telling it how much went by with
+ * +consume_body+, or given to +parse_chunk+ as usual.
  *
  */
-VALUE hpe_response_parser_initialize( VALUE self )
+VALUE hpe_parser_set_headers_only( VALUE self, VALUE headers_only )
 {
     http_parser *parser;
 
     Data_Get_Struct( self, http_parser, parser );
-    http_parser_init( parser, HTTP_RESPONSE );
-
-    rb_call_super( 0, NULL );
-
-    /* we use the data field in the parser to point to the Ruby Object
-     * that wraps it.
-     */
-    parser->data = (void*)self;
-
-    return self;
+    parser->headers_only = RTEST( headers_only ) ? 1 : 0;
+    return headers_only;
 }
 
-
-void Init_http_parser_ext()
-{
+/*
+ * call-seq:
+ *   parser.headers_only? -> true or false
+ *
+ */
+VALUE hpe_parser_headers_only( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( parser->headers_only ) {
+        return Qtrue;
+    }
+    return Qfalse;
+}
+
+/*
+ * call-seq:
+ *   parser.body_pending? -> true or false
+ *
+ * Did +parse_chunk+ stop at the start of a body because of
+ * +headers_only+, with the message not complete yet?
+ *
+ */
+VALUE hpe_parser_body_pending( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( parser->flags & HTTP_FLAG_BODY_PENDING ) {
+        return Qtrue;
+    }
+    return Qfalse;
+}
+
+/*
+ * call-seq:
+ *   parser.version -> Version string
+ *
+ * Return the version string of the request/response being parsed.
+ *
+ */
+VALUE hpe_parser_version( VALUE self )
+{
+    http_parser *parser;
+    char         v[16];
+
+    Data_Get_Struct( self, http_parser, parser );
+
+    snprintf(v, sizeof(v), "%u.%u", parser->version_major, parser->version_minor );
+
+    return rb_str_new2( v );
+}
+
+
+/*
+ * call-seq:
+ *   parser.keep_alive? -> true or false
+ *
+ * Does this request/response support keep_alive?
+ *
+ */
+VALUE hpe_parser_keep_alive( VALUE self )
+{
+    http_parser *parser;
+    int          ka;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( http_parser_should_keep_alive( parser ) )  {
+        return Qtrue;
+    } else {
+        return Qfalse;
+    }
+}
+
+
+/*
+ * call-seq:
+ *   parser.interesting_headers = [ "Host", "Content-Type", ... ]
+ *
+ * Only call +on_header_field+ and +on_header_value+ for the headers, and
+ * trailers, with these names.  All others are parsed and skipped without
+ * calling back.  Names compare case-insensitively and are at most 64
+ * bytes, up to 32 of them can be given.  Each matching name is given to
+ * +on_header_field+ whole, in a single call.  Set it to nil to have every
+ * header called back again.
+ */
+VALUE hpe_parser_set_interesting_headers( VALUE self, VALUE names )
+{
+    http_parser     *parser;
+    http_header_set *set;
+    VALUE            name;
+    VALUE            strings;
+    long             i;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( Qnil == names ) {
+        xfree( (http_header_set *)parser->header_filter );
+        xfree( parser->header_name );
+        parser->header_filter = NULL;
+        parser->header_name   = NULL;
+        return names;
+    }
+
+    /* everything that can raise before the set is allocated */
+    names   = rb_Array( names );
+    strings = rb_ary_new2( RARRAY_LEN( names ) );
+    for ( i = 0 ; i < RARRAY_LEN( names ) ; i++ ) {
+        name = rb_obj_as_string( rb_ary_entry( names, i ) );
+        StringValueCStr( name );
+        rb_ary_push( strings, name );
+    }
+
+    /* the parser keeps its old set until the new one is complete */
+    set = ALLOC( http_header_set );
+    http_header_set_init( set );
+    for ( i = 0 ; i < RARRAY_LEN( strings ) ; i++ ) {
+        name = rb_ary_entry( strings, i );
+        if ( 0 != http_header_set_add( set, RSTRING_PTR( name ) ) ) {
+            xfree( set );
+            rb_raise( rb_eArgError, "cannot add %s to the interesting headers", RSTRING_PTR( name ) );
+        }
+    }
+    if ( NULL == parser->header_name ) {
+        parser->header_name = ALLOC_N( char, HTTP_MAX_HEADER_NAME_SIZE );
+    }
+    xfree( (http_header_set *)parser->header_filter );
+    parser->header_filter = set;
+    return names;
+}
+
+/*
+ * The arena of a parser is set up by whichever of reassemble_tokens= and
+ * collect_headers= needs it.  It cannot change while it has something of
+ * the message in it.
+ */
+#define HPE_ARENA_BLOCK_SIZE 4096
+
+static void hpe_parser_check_arena( http_parser *parser )
+{
+    if ( parser->token_len > 0 ) {
+        rb_raise( eHttpParserError, "a string is being reassembled" );
+    }
+    if ( parser->headers && parser->headers->count > 0 ) {
+        rb_raise( eHttpParserError, "headers are being collected" );
+    }
+}
+
+/* a new arena of blocks of block_size, none for 0 */
+static void hpe_parser_set_arena( http_parser *parser, size_t block_size )
+{
+    if ( parser->arena ) {
+        http_arena_free( parser->arena );
+        xfree( parser->arena );
+        parser->arena = NULL;
+    }
+    parser->token_buf = NULL;
+    parser->token_buf_size = 0;
+    if ( block_size > 0 ) {
+        parser->arena = ALLOC( http_arena );
+        http_arena_init( parser->arena, block_size );
+    }
+}
+
+/*
+ * call-seq:
+ *   parser.reassemble_tokens = bytes
+ *
+ * Call +on_header_field+, +on_header_value+ and +on_path+ once with the
+ * whole string, even when it is split across +parse_chunk+ calls.  The
+ * pieces are gathered in an arena of blocks of +bytes+ that is kept for
+ * the next message.  With 0 there is no arena, unless headers are
+ * collected, and a split string is a :token_overflow error.  Set it to nil to have split strings given a
+ * piece at a time again.  An obsolete line folded header value is still
+ * given a line at a time.
+ */
+VALUE hpe_parser_set_reassemble_tokens( VALUE self, VALUE bytes )
+{
+    http_parser *parser;
+    long         size = 0;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( Qnil != bytes ) {
+        size = NUM2LONG( bytes );
+        if ( size < 0 ) {
+            rb_raise( rb_eArgError, "the token buffer size must be >= 0" );
+        }
+    }
+    hpe_parser_check_arena( parser );
+
+    parser->reassemble_tokens = ( Qnil != bytes );
+    if ( size > 0 ) {
+        hpe_parser_set_arena( parser, size );
+    } else if ( NULL == parser->headers ) {
+        hpe_parser_set_arena( parser, 0 );
+    }
+    return bytes;
+}
+
+/*
+ * call-seq:
+ *   parser.collect_headers = true or false
+ *
+ * Keep the headers, and trailers, of the message being parsed in the
+ * parser, for +header+.  They are kept until +on_message_complete+
+ * returns.  Header fields and values are reassembled as for
+ * +reassemble_tokens+, in an arena of 4096 byte blocks unless
+ * +reassemble_tokens+ has set one up.
+ */
+VALUE hpe_parser_set_collect_headers( VALUE self, VALUE collect )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    hpe_parser_check_arena( parser );
+
+    if ( RTEST( collect ) ) {
+        if ( NULL == parser->headers ) {
+            parser->headers = ALLOC( http_headers );
+            http_headers_clear( parser->headers );
+        }
+        if ( NULL == parser->arena ) {
+            hpe_parser_set_arena( parser, HPE_ARENA_BLOCK_SIZE );
+        }
+    } else {
+        xfree( parser->headers );
+        parser->headers = NULL;
+    }
+    return collect;
+}
+
+/*
+ * call-seq:
+ *   parser.header( name ) -> String or nil
+ *
+ * The value of the first collected header called +name+, compared
+ * case-insensitively, or nil.  Only the headers parsed so far are there,
+ * so call it from +on_headers_complete+ or a later callback.  Headers
+ * nobody asks for never become Ruby Strings.  See +collect_headers+.
+ */
+VALUE hpe_parser_header( VALUE self, VALUE name )
+{
+    http_parser       *parser;
+    const http_header *header;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( NULL == parser->headers ) {
+        return Qnil;
+    }
+    StringValue( name );
+    header = http_headers_lookup( parser->headers, RSTRING_PTR( name ), RSTRING_LEN( name ) );
+    if ( NULL == header ) {
+        return Qnil;
+    }
+    return rb_str_new( header->value, header->value_length );
+}
+
+/*
+ * Http::ParsedHeaders is a copy of the headers a parser has collected, the
+ * names and values in one buffer right after the spans that point into
+ * it.  Ruby Strings are only made for the headers that are read.  The
+ * headers with the same name are chained together, in C, the first time
+ * all of them are gone through, see hpe_headers_chain.
+ */
+typedef struct hpe_headers {
+    size_t          count;
+    http_header    *headers;
+    unsigned short  first[ HTTP_HEADER_IDS ]; /* as in http_headers */
+    int             chained;
+    size_t         *next;     /* index + 1 of the next header named the same, 0 for none */
+    unsigned char  *is_first; /* of its name */
+} hpe_headers;
+
+void hpe_headers_free( hpe_headers *headers )
+{
+    xfree( headers );
+}
+
+/*
+ * call-seq:
+ *   parser.headers -> Http::ParsedHeaders or nil
+ *
+ * The headers collected so far, see +collect_headers+, or nil if they are
+ * not being collected.  The copy is kept after the message is done.
+ */
+VALUE hpe_parser_headers( VALUE self )
+{
+    http_parser       *parser;
+    hpe_headers       *copy;
+    const http_header *header;
+    http_header       *span;
+    size_t             count, bytes = 0, i;
+    char              *at;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( NULL == parser->headers ) {
+        return Qnil;
+    }
+
+    count = parser->headers->count;
+    for ( i = 0; i < count; i++ ) {
+        header = http_headers_at( parser->headers, i );
+        bytes += header->name_length + header->value_length;
+    }
+
+    copy = (hpe_headers *)xmalloc( sizeof( hpe_headers ) +
+                                   count * ( sizeof( http_header ) + sizeof( size_t ) + 1 ) + bytes );
+    copy->count = count;
+    copy->headers = (http_header *)( copy + 1 );
+    memcpy( copy->first, parser->headers->first, sizeof( copy->first ) );
+    copy->chained = false;
+    copy->next = (size_t *)( copy->headers + count );
+    copy->is_first = (unsigned char *)( copy->next + count );
+
+    at = (char *)( copy->is_first + count );
+    for ( i = 0; i < count; i++ ) {
+        header = http_headers_at( parser->headers, i );
+        span = &copy->headers[ i ];
+        *span = *header;
+        memcpy( at, header->name, header->name_length );
+        span->name = at;
+        at += header->name_length;
+        memcpy( at, header->value, header->value_length );
+        span->value = at;
+        at += header->value_length;
+    }
+    return Data_Wrap_Struct( cHttpParsedHeaders, NULL, hpe_headers_free, copy );
+}
+
+/* case-insensitive FNV-1a of a header name */
+static size_t hpe_name_hash( const char *name, size_t length )
+{
+    size_t hash = 2166136261u;
+
+    while ( length-- ) {
+        hash = ( hash ^ (unsigned char)tolower( *name++ ) ) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Chain each header to the next one with the same name, in one pass, for
+ * going through all of them by name.  The last header seen with each name
+ * is kept by id for the well known ones and in a temporary open addressed
+ * table of header indexes, hashed on the name, for the rest.
+ */
+static void hpe_headers_chain( hpe_headers *headers )
+{
+    size_t             last[ HTTP_HEADER_IDS ];
+    size_t            *others;
+    size_t             slots = 16, mask, i, h;
+    const http_header *header;
+
+    if ( headers->chained ) {
+        return;
+    }
+    while ( slots < 2 * headers->count ) {
+        slots <<= 1;
+    }
+    mask   = slots - 1;
+    others = ALLOC_N( size_t, slots );
+    memset( others, 0, slots * sizeof( size_t ) );
+    memset( last, 0, sizeof( last ) );
+
+    for ( i = 0; i < headers->count; i++ ) {
+        size_t *seen;
+
+        header = &headers->headers[ i ];
+        if ( HTTP_HEADER_OTHER != header->id ) {
+            seen = &last[ header->id ];
+        } else {
+            h = hpe_name_hash( header->name, header->name_length ) & mask;
+            while ( others[ h ] &&
+                    !http_header_is( &headers->headers[ others[ h ] - 1 ], HTTP_HEADER_OTHER,
+                                     header->name, header->name_length ) ) {
+                h = ( h + 1 ) & mask;
+            }
+            seen = &others[ h ];
+        }
+        headers->next[ i ] = 0;
+        headers->is_first[ i ] = ( 0 == *seen );
+        if ( *seen ) {
+            headers->next[ *seen - 1 ] = i + 1;
+        }
+        *seen = i + 1;
+    }
+    xfree( others );
+    headers->chained = true;
+}
+
+/* the value of all the headers from the i-th on named as it is, a String
+ * for one and an Array for more.  Follows the chain once there is one,
+ * a single lookup scans the rest of the headers instead. */
+static VALUE hpe_headers_value_at( hpe_headers *headers, size_t i )
+{
+    const http_header *header = &headers->headers[ i ];
+    const http_header *other;
+    VALUE              value  = rb_str_new( header->value, header->value_length );
+    VALUE              values = Qnil;
+    size_t             j;
+
+    if ( headers->chained ) {
+        for ( j = headers->next[ i ]; j > 0; j = headers->next[ j - 1 ] ) {
+            other = &headers->headers[ j - 1 ];
+            if ( Qnil == values ) {
+                values = rb_ary_new3( 1, value );
+            }
+            rb_ary_push( values, rb_str_new( other->value, other->value_length ) );
+        }
+    } else {
+        for ( j = i + 1; j < headers->count; j++ ) {
+            other = &headers->headers[ j ];
+            if ( http_header_is( other, header->id, header->name, header->name_length ) ) {
+                if ( Qnil == values ) {
+                    values = rb_ary_new3( 1, value );
+                }
+                rb_ary_push( values, rb_str_new( other->value, other->value_length ) );
+            }
+        }
+    }
+    return ( Qnil == values ) ? value : values;
+}
+
+/* is the i-th header the first one named as it is */
+static int hpe_headers_first_at( hpe_headers *headers, size_t i )
+{
+    hpe_headers_chain( headers );
+    return headers->is_first[ i ];
+}
+
+/* index of the first header named name, -1 for none */
+static long hpe_headers_index( hpe_headers *headers, VALUE name )
+{
+    enum http_header_id id;
+    size_t              i;
+
+    name = rb_obj_as_string( name );
+    id = http_header_id( RSTRING_PTR( name ), RSTRING_LEN( name ) );
+    if ( HTTP_HEADER_OTHER != id ) {
+        return (long)headers->first[ id ] - 1;
+    }
+    for ( i = 0; i < headers->count; i++ ) {
+        if ( http_header_is( &headers->headers[ i ], id, RSTRING_PTR( name ), RSTRING_LEN( name ) ) ) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * call-seq:
+ *   headers[key] -> value
+ *   headers.fetch( key ) -> value
+ *
+ * The value of the header +key+, compared case-insensitively, as
+ * Http::Headers has it: a String, an Array of them if the header was
+ * there more than once, or nil.
+ */
+VALUE hpe_headers_fetch( VALUE self, VALUE name )
+{
+    hpe_headers *headers;
+    long         i;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    i = hpe_headers_index( headers, name );
+    return ( i < 0 ) ? Qnil : hpe_headers_value_at( headers, i );
+}
+
+/*
+ * call-seq:
+ *   headers.key?( key ) -> true or false
+ *
+ * Is there a header +key+, compared case-insensitively.
+ */
+VALUE hpe_headers_has_key( VALUE self, VALUE name )
+{
+    hpe_headers *headers;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    return ( hpe_headers_index( headers, name ) < 0 ) ? Qfalse : Qtrue;
+}
+
+/*
+ * call-seq:
+ *   headers.each { |key, value| ... } -> headers
+ *
+ * Yields every header once, with the name it first had and its value as
+ * +fetch+ gives it, in the order they were first seen.
+ */
+VALUE hpe_headers_each( VALUE self )
+{
+    hpe_headers       *headers;
+    const http_header *header;
+    size_t             i;
+
+    RETURN_ENUMERATOR( self, 0, 0 );
+    Data_Get_Struct( self, hpe_headers, headers );
+    for ( i = 0; i < headers->count; i++ ) {
+        if ( hpe_headers_first_at( headers, i ) ) {
+            header = &headers->headers[ i ];
+            rb_yield_values( 2, rb_str_new( header->name, header->name_length ),
+                                hpe_headers_value_at( headers, i ) );
+        }
+    }
+    return self;
+}
+
+/*
+ * call-seq:
+ *   headers.keys -> Array
+ *
+ * The names of the headers, as they were first seen.
+ */
+VALUE hpe_headers_keys( VALUE self )
+{
+    hpe_headers       *headers;
+    const http_header *header;
+    VALUE              keys = rb_ary_new();
+    size_t             i;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    for ( i = 0; i < headers->count; i++ ) {
+        if ( hpe_headers_first_at( headers, i ) ) {
+            header = &headers->headers[ i ];
+            rb_ary_push( keys, rb_str_new( header->name, header->name_length ) );
+        }
+    }
+    return keys;
+}
+
+/*
+ * call-seq:
+ *   headers.values -> Array
+ *
+ * The values of the headers, in the same order as +keys+.
+ */
+VALUE hpe_headers_values( VALUE self )
+{
+    hpe_headers *headers;
+    VALUE        values = rb_ary_new();
+    size_t       i;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    for ( i = 0; i < headers->count; i++ ) {
+        if ( hpe_headers_first_at( headers, i ) ) {
+            rb_ary_push( values, hpe_headers_value_at( headers, i ) );
+        }
+    }
+    return values;
+}
+
+/*
+ * call-seq:
+ *   headers.to_hash -> Hash
+ *
+ * All the headers in a Hash, keyed by +keys+.
+ */
+VALUE hpe_headers_to_hash( VALUE self )
+{
+    hpe_headers       *headers;
+    const http_header *header;
+    VALUE              hash = rb_hash_new();
+    size_t             i;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    for ( i = 0; i < headers->count; i++ ) {
+        if ( hpe_headers_first_at( headers, i ) ) {
+            header = &headers->headers[ i ];
+            rb_hash_aset( hash, rb_str_new( header->name, header->name_length ),
+                                hpe_headers_value_at( headers, i ) );
+        }
+    }
+    return hash;
+}
+
+/*
+ * call-seq:
+ *   headers.size -> Integer
+ *
+ * The number of different headers.
+ */
+VALUE hpe_headers_size( VALUE self )
+{
+    hpe_headers *headers;
+    long         size = 0;
+    size_t       i;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    for ( i = 0; i < headers->count; i++ ) {
+        size += hpe_headers_first_at( headers, i );
+    }
+    return LONG2NUM( size );
+}
+
+/*
+ * call-seq:
+ *   headers.empty? -> true or false
+ *
+ * Were there no headers.
+ */
+VALUE hpe_headers_empty( VALUE self )
+{
+    hpe_headers *headers;
+
+    Data_Get_Struct( self, hpe_headers, headers );
+    return ( 0 == headers->count ) ? Qtrue : Qfalse;
+}
+
+/*
+ * call-seq:
+ *   parser.chunk_size -> Integer
+ *
+ * The size of the current chunk of a chunked body.  During the
+ * +on_chunk_header+ callback this is the full size of the chunk that is
+ * about to be delivered, 0 for the last chunk.
+ *
+ */
+VALUE hpe_parser_chunk_size( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    return ULL2NUM( parser->chunk_size );
+}
+
+/*
+ * call-seq:
+ *   parser.stream_offset -> Integer
+ *
+ * How many bytes of the stream have been parsed, or passed over with
+ * +consume_body+, before the current +parse_chunk+.  The offsets given to
+ * +on_body_range+ and +on_framing_range+ count from the same place.
+ *
+ */
+VALUE hpe_parser_stream_offset( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    return ULL2NUM( parser->stream_offset );
+}
+
+/*
+ * call-seq:
+ *   parser.content_length -> Integer
+ *
+ * The content length of the body of the request/response being parsed.
+ *
+ */
+VALUE hpe_parser_content_length( VALUE self )
+{
+    http_parser *parser;
+    size_t       content_length;
+    VALUE        rc;
+
+    Data_Get_Struct( self, http_parser, parser );
+    content_length = parser->content_length;
+    rc = ULL2NUM( content_length );
+   
+    return rc;
+}
+
+
+/*
+ * call-seq:
+ *   parser.error_code -> Symbol or nil
+ *
+ * The reason the parser failed, for example :invalid_method or
+ * :callback_abort.  nil if there has not been an error.
+ *
+ */
+VALUE hpe_parser_error_code( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( HPE_OK == parser->http_errno ) {
+        return Qnil;
+    }
+    return hpe_error_codes[ parser->http_errno ];
+}
+
+/*
+ * call-seq:
+ *   parser.error_offset -> Integer or nil
+ *
+ * The offset of the byte that caused the error within the chunk that was
+ * being parsed.  nil if there has not been an error.
+ *
+ */
+VALUE hpe_parser_error_offset( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( HPE_OK == parser->http_errno ) {
+        return Qnil;
+    }
+    return ULL2NUM( parser->error_offset );
+}
+
+/*
+ * The Http::Parser::Error for the failure parser stopped at.
+ */
+static VALUE hpe_parser_error( http_parser *parser )
+{
+    char  msg[128];
+    VALUE error;
+
+    /* never put the chunk itself in the message, it may be huge or
+     * binary, the offset is enough to find the bad byte */
+    snprintf( msg, sizeof( msg ),
+              "Failure during parsing of chunk at offset %lu: %s",
+              (unsigned long)parser->error_offset,
+              http_errno_description( parser->http_errno ) );
+    error = rb_exc_new2( eHttpParserError, msg );
+    rb_iv_set( error, "@code", hpe_error_codes[ parser->http_errno ] );
+    rb_iv_set( error, "@offset", ULL2NUM( parser->error_offset ) );
+    return error;
+}
+
+/*
+ * Common error handling for parse_chunk and finish, either raise an
+ * Http::Parser::Error or hand the failure to the on_error callback.
+ */
+static void hpe_parser_handle_error( VALUE self, http_parser *parser, VALUE chunk )
+{
+    VALUE callback = rb_iv_get( self, "@on_error_callback" );
+    VALUE exception = rb_iv_get( self, "@callback_exception" );
+
+    if ( Qnil == exception ) {
+        rb_iv_set( self, "@internal_parser_error", Qtrue );
+    }
+
+    if ( Qnil == callback ) {
+        rb_exc_raise( hpe_parser_error( parser ) );
+    } else {
+        rb_funcall( callback, rb_intern("call"), 2, self, chunk );
+    } 
+}
+
+/*
+ * call-seq:
+ *   parser.parse_chunk( String ) -> Integer
+ *
+ * Parse the given hunk of data invoking the callbacks as appropriate.
+ * Returns the number of bytes parsed.  This is less than the size of the
+ * chunk only after an upgrade, see +upgrade?+, in which case the rest of
+ * the chunk is the start of the tunnelled data.
+ *
+ * If an error is encountered, an exception is thrown.  This could be
+ * one of two things:
+ *
+ * 1) The error happened in the callback, in that case that exception is
+ *    reraised
+ * 2) Internal error in the parser, in this case an new excpetion is
+ *    raised
+ *
+ * The raised Http::Parser::Error has the +code+ and +offset+ of the
+ * failure, the same values as +error_code+ and +error_offset+.
+ *
+ * If there is an on_error callback, then it is invoked. In both cases
+ * the parser and the input chunk are passed to the +on_error+ callback.
+ * The receiver of the callback can interrogate the parser and see if
+ * there was an error from some other callback.
+ *
+ */
+VALUE hpe_parser_parse_chunk( VALUE self, VALUE chunk )
+{
+    http_parser *parser;
+    VALUE       str = StringValue( chunk );
+    char*       chunk_p = RSTRING_PTR( str );
+    size_t      parsed;
+
+    Data_Get_Struct( self, http_parser, parser );
+    parsed = http_parser_execute( parser, chunk_p, RSTRING_LEN(str) );
+
+    if ( http_parser_has_error( parser ) ) {
+        hpe_parser_handle_error( self, parser, chunk );
+    }
+    return ULL2NUM( parsed );
+}
+
+/*
+ * call-seq:
+ *   parser.parse_chunk!( String ) -> Integer
+ *
+ * +parse_chunk+ that modifies the chunk.  The body in it is moved down
+ * over the framing of a chunked body and +on_body+ is called once with
+ * all of the body in the chunk, or once per message if the chunk has the
+ * end of one, instead of once per piece of a chunk.
+ *
+ */
+VALUE hpe_parser_parse_chunk_bang( VALUE self, VALUE chunk )
+{
+    http_parser *parser;
+    VALUE       str = StringValue( chunk );
+    size_t      parsed;
+
+    rb_str_modify( str );
+    Data_Get_Struct( self, http_parser, parser );
+    parsed = http_parser_execute_inplace( parser, RSTRING_PTR( str ), RSTRING_LEN( str ) );
+
+    if ( http_parser_has_error( parser ) ) {
+        hpe_parser_handle_error( self, parser, chunk );
+    }
+    return ULL2NUM( parsed );
+}
+
+/*
+ * call-seq:
+ *   Http::Parser.parse_chunks( parsers, chunks ) -> Array
+ *
+ * +parse_chunk+ of each of +chunks+ with the parser at the same index of
+ * +parsers+, e.g. for every connection a select() found readable.
+ * Returns the number of bytes each parser parsed.  Every chunk is parsed
+ * before any error is handled, then the first parser that failed handles
+ * it as +parse_chunk+ would.
+ *
+ */
+VALUE hpe_parser_s_parse_chunks( VALUE klass, VALUE parsers, VALUE chunks )
+{
+    size_t        n, i, failed;
+    http_parser **p;
+    const char  **bufs;
+    size_t       *lens;
+    size_t       *parsed;
+    size_t        errors;
+    VALUE         strs, rc;
+
+    (void)klass; /* the same for RequestParser and ResponseParser */
+
+    Check_Type( parsers, T_ARRAY );
+    Check_Type( chunks, T_ARRAY );
+    if ( RARRAY_LEN( parsers ) != RARRAY_LEN( chunks ) ) {
+        rb_raise( rb_eArgError, "need one chunk per parser" );
+    }
+    n = (size_t)RARRAY_LEN( parsers );
+
+    /* copies, so a callback changing either Array or a chunk cannot move
+     * the bytes of one that is still to be parsed */
+    parsers = rb_ary_dup( parsers );
+    strs = rb_ary_new2( (long)n );
+    for ( i = 0 ; i < n ; i++ ) {
+        VALUE chunk = rb_ary_entry( chunks, (long)i );
+
+        if ( !rb_obj_is_kind_of( rb_ary_entry( parsers, (long)i ), cHttpParser ) ) {
+            rb_raise( rb_eTypeError, "not an Http::Parser" );
+        }
+        rb_ary_push( strs, rb_str_new_frozen( StringValue( chunk ) ) );
+    }
+
+    p      = ALLOC_N( http_parser *, n );
+    bufs   = ALLOC_N( const char *, n );
+    lens   = ALLOC_N( size_t, n );
+    parsed = ALLOC_N( size_t, n );
+    for ( i = 0 ; i < n ; i++ ) {
+        VALUE str = rb_ary_entry( strs, (long)i );
+
+        Data_Get_Struct( rb_ary_entry( parsers, (long)i ), http_parser, p[i] );
+        bufs[i] = RSTRING_PTR( str );
+        lens[i] = RSTRING_LEN( str );
+    }
+    errors = http_parser_execute_batch( p, bufs, lens, parsed, n );
+    RB_GC_GUARD( strs );
+
+    rc = rb_ary_new2( (long)n );
+    for ( i = 0 ; i < n ; i++ ) {
+        rb_ary_push( rc, ULL2NUM( parsed[i] ) );
+    }
+    for ( failed = 0 ; errors > 0 && !http_parser_has_error( p[failed] ) ; failed++ ) {
+        ;
+    }
+    xfree( p );
+    xfree( bufs );
+    xfree( lens );
+    xfree( parsed );
+
+    if ( errors > 0 ) {
+        VALUE        self = rb_ary_entry( parsers, (long)failed );
+        http_parser *parser;
+
+        Data_Get_Struct( self, http_parser, parser );
+        hpe_parser_handle_error( self, parser, rb_ary_entry( strs, (long)failed ) );
+    }
+    return rc;
+}
+
+/*
+ * call-seq:
+ *   parser.finish -> nil
+ *
+ * Tell the parser the input has ended, e.g. the connection was closed.
+ *
+ * A response with neither a Content-Length nor chunked encoding has a
+ * body that runs until the connection closes.  Its body is passed to
+ * +on_body+ as it arrives and +finish+ invokes its +on_message_complete+.
+ *
+ * If the input ended in the middle of any other message that is an
+ * error, handled the same way as an error in +parse_chunk+.
+ *
+ */
+VALUE hpe_parser_finish( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( http_parser_finish( parser ) ) {
+        hpe_parser_handle_error( self, parser, rb_str_new2( "" ) );
+    }
+    return Qnil;
+}
+
+/*
+ * call-seq:
+ *   parser.consume_body( bytes ) -> Integer
+ *
+ * Tell the parser +bytes+ of a pending Content-Length, or read until
+ * close, body went by without it.  Returns how many of them were body,
+ * fewer if the message ended first, in which case +on_message_complete+
+ * was called.  Chunked bodies have to go through +parse_chunk+ and return
+ * 0 here.
+ *
+ */
+VALUE hpe_parser_consume_body( VALUE self, VALUE bytes )
+{
+    http_parser *parser;
+    size_t       consumed;
+
+    Data_Get_Struct( self, http_parser, parser );
+    consumed = http_parser_consume_body( parser, NUM2SIZET( bytes ) );
+    if ( http_parser_has_error( parser ) ) {
+        hpe_parser_handle_error( self, parser, rb_str_new2( "" ) );
+    }
+    return ULL2NUM( consumed );
+}
+
+/*
+ * Http::Router wraps an http_router, the route names given to add are
+ * kept in @routes, indexed by the route_id they were given.
+ */
+void hpe_router_free( http_router *router )
+{
+    http_router_free( router );
+}
+
+VALUE hpe_router_alloc( VALUE klass )
+{
+    http_router *router = http_router_new();
+
+    if ( NULL == router ) {
+        rb_memerror();
+    }
+    return Data_Wrap_Struct( klass, NULL, hpe_router_free, router );
+}
+
+/*
+ * call-seq:
+ *   Router.new
+ *
+ * Create a new, empty, Router.  Give it to RequestParser#router= to have
+ * the path of each request routed as it is parsed.
+ */
+VALUE hpe_router_initialize( VALUE self )
+{
+    rb_iv_set( self, "@routes", rb_ary_new() );
+    return self;
+}
+
+/*
+ * call-seq:
+ *   router.add( pattern, name ) -> router
+ *
+ * Add a route.  Segments of the pattern that start with ':' match any
+ * one segment of the path and are captured, "/users/:id" matches
+ * "/users/42" with the parameter "id" = "42".  A literal segment is
+ * preferred over a parameter and there is no backtracking, so with
+ * "/users/new" and "/users/:id/posts" added "/users/new/posts" does not
+ * match.  +name+ is what RequestParser#route returns for a match.
+ *
+ * Raises ArgumentError if the pattern does not start with '/', has too
+ * many parameters or names a parameter differently than an earlier
+ * pattern does at the same position.
+ */
+VALUE hpe_router_add( VALUE self, VALUE pattern, VALUE name )
+{
+    http_router *router;
+    VALUE        routes = rb_iv_get( self, "@routes" );
+
+    Data_Get_Struct( self, http_router, router );
+    if ( 0 != http_router_add( router, StringValueCStr( pattern ), (int)RARRAY_LEN( routes ) ) ) {
+        rb_raise( rb_eArgError, "invalid route pattern %s", RSTRING_PTR( pattern ) );
+    }
+    rb_ary_push( routes, name );
+    return self;
+}
+
+/*
+ * call-seq:
+ *   request_parser.router = router
+ *
+ * Route the path of each request against the Http::Router +router+ as it
+ * is parsed, see route, route_params and on_route.  Set it to nil to stop
+ * routing.
+ */
+VALUE hpe_parser_set_router( VALUE self, VALUE router )
+{
+    http_parser *parser;
+    http_router *r = NULL;
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( Qnil != router ) {
+        if ( !rb_obj_is_kind_of( router, cHttpRouter ) ) {
+            rb_raise( rb_eTypeError, "expected an Http::Router" );
+        }
+        Data_Get_Struct( router, http_router, r );
+    }
+    if ( NULL != r && NULL == parser->route ) {
+        parser->route = ALLOC( http_route_match );
+        parser->route->route_id = HTTP_NO_ROUTE;
+        parser->route->nparams  = 0;
+        parser->route->node     = NULL;
+    } else if ( NULL == r ) {
+        xfree( parser->route );
+        parser->route = NULL;
+    }
+    rb_iv_set( self, "@router", router );
+    parser->router = r;
+    return router;
+}
+
+/*
+ * call-seq:
+ *   request_parser.route -> name or nil
+ *
+ * The name the matching route was added to the router with, nil if the
+ * path did not match a route.  This is known from +on_route+ until the
+ * request is complete.
+ */
+VALUE hpe_parser_route( VALUE self )
+{
+    http_parser *parser;
+    VALUE        router = rb_iv_get( self, "@router" );
+
+    Data_Get_Struct( self, http_parser, parser );
+    if ( Qnil == router || HTTP_NO_ROUTE == parser->route->route_id ) {
+        return Qnil;
+    }
+    return rb_ary_entry( rb_iv_get( router, "@routes" ), parser->route->route_id );
+}
+
+/*
+ * call-seq:
+ *   request_parser.route_params -> Hash
+ *
+ * The parameters captured by the matching route, { "id" => "42" } for
+ * "/users/:id".  Empty if the path did not match a route.
+ */
+VALUE hpe_parser_route_params( VALUE self )
+{
+    http_parser      *parser;
+    http_route_match *match;
+    VALUE             params = rb_hash_new();
+    int               i;
+
+    Data_Get_Struct( self, http_parser, parser );
+    match = parser->route;
+    if ( NULL == match || HTTP_NO_ROUTE == match->route_id ) {
+        return params;
+    }
+    for ( i = 0 ; i < match->nparams ; i++ ) {
+        rb_hash_aset( params,
+                      rb_obj_freeze( rb_str_new2( match->params[i].name ) ),
+                      rb_str_new( match->buf + match->params[i].offset, match->params[i].length ) );
+    }
+    return params;
+}
+
+/*
+ * Http::ParserTable wraps an http_parser_table.  The callbacks are the
+ * table's, kept in @on_*_callback of the ParserTable, and are called with
+ * the slot.  Each slot's data points at its entry in slots.
+ */
+typedef struct hpe_table_slot {
+    VALUE  table;
+    size_t slot;
+} hpe_table_slot_t;
+
+typedef struct hpe_table {
+    http_parser_table *table;
+    hpe_table_slot_t  *slots;
+} hpe_table_t;
+
+void hpe_table_free( hpe_table_t *t )
+{
+    http_parser_table_free( t->table );
+    xfree( t->slots );
+    xfree( t );
+}
+
+VALUE hpe_table_alloc( VALUE klass )
+{
+    hpe_table_t *t = xcalloc( 1, sizeof( hpe_table_t ) );
+
+    return Data_Wrap_Struct( klass, NULL, hpe_table_free, t );
+}
+
+/* call the table's callback +name+ with the slot, and the string for a
+ * data callback */
+static int hpe_table_call( http_parser *parser, const char *name, const char *at, size_t length, int argc )
+{
+    hpe_table_slot_t *s        = (hpe_table_slot_t *)parser->data;
+    VALUE             callable = rb_iv_get( s->table, name );
+    int               had_error = false;
+
+    if ( Qnil != callable ) {
+        hpe_protected_t protected;
+        VALUE           cb_exception = Qnil;
+        VALUE           args[2];
+
+        args[0] = SIZET2NUM( s->slot );
+        if ( argc > 1 ) {
+            args[1] = rb_str_new( at, length );
+        }
+        protected.instance = callable;
+        protected.method   = rb_intern("call");
+        protected.argc     = argc;
+        protected.argv     = args;
+
+        rb_protect( hpe_wrap_funcall2, (VALUE)&protected, &had_error );
+        if ( had_error ) {
+            cb_exception = rb_gv_get("$!");
+        }
+        rb_iv_set( s->table, "@callback_exception", cb_exception );
+    }
+    return had_error;
+}
+
+/* the table of self, raises if it was never initialized */
+static hpe_table_t *hpe_table_of( VALUE self )
+{
+    hpe_table_t *t;
+
+    Data_Get_Struct( self, hpe_table_t, t );
+    if ( NULL == t->table ) {
+        rb_raise( eHttpParserError, "ParserTable is not initialized" );
+    }
+    return t;
+}
+
+#define HPE_TABLE_CALLBACK(FOR)                                             \
+int hpe_table_##FOR##_cb( http_parser *parser )                             \
+{                                                                           \
+    return hpe_table_call( parser, "@" #FOR "_callback", NULL, 0, 1 );      \
+}
+
+#define HPE_TABLE_DATA_CALLBACK(FOR)                                        \
+int hpe_table_##FOR##_data_cb( http_parser *parser,                         \
+                               const char *at, size_t length )              \
+{                                                                           \
+    return hpe_table_call( parser, "@" #FOR "_callback", at, length, 2 );   \
+}
+
+#define HPE_TABLE_CALLBACK_SETTER(FOR,CB_TYPE)                              \
+VALUE hpe_table_##FOR( VALUE self, VALUE callable )                         \
+{                                                                           \
+    hpe_table_t *t = hpe_table_of( self );                                  \
+                                                                            \
+    rb_iv_set( self, "@" #FOR "_callback", callable );                      \
+    t->table->settings.FOR =                                                \
+        ( Qnil == callable ) ? NULL : hpe_table_##FOR##_##CB_TYPE;          \
+    return callable;                                                        \
+}
+
+HPE_TABLE_CALLBACK(on_message_begin);
+HPE_TABLE_CALLBACK_SETTER(on_message_begin,cb)
+HPE_TABLE_CALLBACK(on_headers_complete);
+HPE_TABLE_CALLBACK_SETTER(on_headers_complete,cb)
+HPE_TABLE_DATA_CALLBACK(on_body);
+HPE_TABLE_CALLBACK_SETTER(on_body,data_cb)
+HPE_TABLE_CALLBACK(on_message_complete);
+HPE_TABLE_CALLBACK_SETTER(on_message_complete,cb)
+
+/*
+ * call-seq:
+ *   ParserTable.new( size ) -> table
+ *   ParserTable.new( size, :response ) -> table
+ *
+ * Parsers for +size+ connections, the slots 0 to size - 1, of requests
+ * or of responses.  The callbacks are set once for the whole table and
+ * are called with the slot, and the String for +on_body+.
+ */
+VALUE hpe_table_initialize( int argc, VALUE *argv, VALUE self )
+{
+    hpe_table_t          *t;
+    VALUE                 size, type;
+    enum http_parser_type parser_type = HTTP_REQUEST;
+    long                  n, i;
+
+    rb_scan_args( argc, argv, "11", &size, &type );
+    n = NUM2LONG( size );
+    if ( n <= 0 ) {
+        rb_raise( rb_eArgError, "table size must be a number greater than 0" );
+    }
+    if ( Qnil != type ) {
+        if ( ID2SYM( rb_intern( "response" ) ) == type ) {
+            parser_type = HTTP_RESPONSE;
+        } else if ( ID2SYM( rb_intern( "request" ) ) != type ) {
+            rb_raise( rb_eArgError, "table type must be :request or :response" );
+        }
+    }
+
+    Data_Get_Struct( self, hpe_table_t, t );
+    if ( NULL != t->table ) {
+        rb_raise( eHttpParserError, "ParserTable is already initialized" );
+    }
+    t->slots = ALLOC_N( hpe_table_slot_t, n );
+    t->table = http_parser_table_new( (size_t)n, parser_type );
+    if ( NULL == t->table ) {
+        rb_memerror();
+    }
+    for ( i = 0 ; i < n ; i++ ) {
+        t->slots[i].table = self;
+        t->slots[i].slot  = (size_t)i;
+        t->table->data[i] = &t->slots[i];
+    }
+    rb_iv_set( self, "@on_message_begin_callback", Qnil );
+    rb_iv_set( self, "@on_headers_complete_callback", Qnil );
+    rb_iv_set( self, "@on_body_callback", Qnil );
+    rb_iv_set( self, "@on_message_complete_callback", Qnil );
+    rb_iv_set( self, "@callback_exception", Qnil );
+    return self;
+}
+
+/* the table of self and slot as an index into it */
+static hpe_table_t *hpe_table_get( VALUE self, VALUE slot, size_t *index )
+{
+    hpe_table_t *t = hpe_table_of( self );
+    long         i = NUM2LONG( slot );
+
+    if ( i < 0 || (size_t)i >= t->table->size ) {
+        rb_raise( rb_eIndexError, "slot %ld outside of the table", i );
+    }
+    *index = (size_t)i;
+    return t;
+}
+
+/*
+ * call-seq:
+ *   table.size -> Integer
+ *
+ * The number of slots.
+ */
+VALUE hpe_table_size( VALUE self )
+{
+    hpe_table_t *t;
+
+    Data_Get_Struct( self, hpe_table_t, t );
+    return SIZET2NUM( t->table ? t->table->size : 0 );
+}
+
+/*
+ * call-seq:
+ *   table.open( slot ) -> table
+ *
+ * Start a new connection in +slot+.
+ */
+VALUE hpe_table_open( VALUE self, VALUE slot )
+{
+    size_t       i;
+    hpe_table_t *t = hpe_table_get( self, slot, &i );
+
+    http_parser_table_open( t->table, i );
+    t->table->data[i] = &t->slots[i];
+    return self;
+}
+
+/*
+ * The failure of the slot just run: the exception a callback raised, as it
+ * was raised, or an Http::Parser::Error.  The failing slot is still loaded
+ * in the table's parser.
+ */
+static void hpe_table_raise( VALUE self, hpe_table_t *t )
+{
+    VALUE exception = rb_iv_get( self, "@callback_exception" );
+
+    if ( Qnil != exception ) {
+        rb_exc_raise( exception );
+    }
+    rb_exc_raise( hpe_parser_error( &t->table->parser ) );
+}
+
+/*
+ * call-seq:
+ *   table.parse_chunk( slot, String ) -> Integer
+ *
+ * Parser#parse_chunk for the connection in +slot+.  If a callback raises
+ * that exception is reraised, any other failure raises an
+ * Http::Parser::Error.  Other slots carry on.
+ */
+VALUE hpe_table_parse_chunk( VALUE self, VALUE slot, VALUE chunk )
+{
+    size_t       i;
+    hpe_table_t *t = hpe_table_get( self, slot, &i );
+    VALUE        str = StringValue( chunk );
+    size_t       parsed;
+
+    rb_iv_set( self, "@callback_exception", Qnil );
+    parsed = http_parser_table_execute( t->table, i, RSTRING_PTR( str ), RSTRING_LEN( str ) );
+    if ( http_parser_table_has_error( t->table, i ) ) {
+        hpe_table_raise( self, t );
+    }
+    return ULL2NUM( parsed );
+}
+
+/*
+ * call-seq:
+ *   table.finish( slot ) -> nil
+ *
+ * Parser#finish for the connection in +slot+, failures are raised as for
+ * +parse_chunk+.
+ */
+VALUE hpe_table_finish( VALUE self, VALUE slot )
+{
+    size_t       i;
+    hpe_table_t *t = hpe_table_get( self, slot, &i );
+
+    rb_iv_set( self, "@callback_exception", Qnil );
+    if ( http_parser_table_finish( t->table, i ) ) {
+        hpe_table_raise( self, t );
+    }
+    return Qnil;
+}
+
+/*
+ * call-seq:
+ *   table.error?( slot ) -> true or false
+ *
+ * Has parsing failed for the connection in +slot+.
+ */
+VALUE hpe_table_has_error( VALUE self, VALUE slot )
+{
+    size_t       i;
+    hpe_table_t *t = hpe_table_get( self, slot, &i );
+
+    return http_parser_table_has_error( t->table, i ) ? Qtrue : Qfalse;
+}
+
+/*
+ * call-seq:
+ *   parser.dump -> String
+ *
+ * A snapshot of the state of the message being parsed, for Parser.load to
+ * carry on parsing it, in this or another process.  Callbacks and
+ * settings such as interesting_headers are not part of it and neither is
+ * the route of a request, see http_parser_snapshot() in http_parser.h.
+ *
+ * Raises Http::Parser::Error in the middle of routing a request path, of
+ * reassembling a string, see reassemble_tokens=, once headers have been
+ * collected, see collect_headers=, from a callback of parse_chunk! or
+ * after parsing failed.
+ */
+VALUE hpe_parser_dump( VALUE self )
+{
+    http_parser *parser;
+    char         buf[ HTTP_PARSER_SNAPSHOT_SIZE ];
+    size_t       length;
+
+    Data_Get_Struct( self, http_parser, parser );
+    length = http_parser_snapshot( parser, buf, sizeof( buf ) );
+    if ( 0 == length ) {
+        rb_raise( eHttpParserError, "Cannot dump the parser while routing a path, reassembling a string, collecting headers or in parse_chunk!, or after an error" );
+    }
+    return rb_str_new( buf, length );
+}
+
+static VALUE hpe_parser_load_as( VALUE klass, VALUE dump )
+{
+    VALUE        obj = rb_class_new_instance( 0, NULL, klass );
+    http_parser *parser;
+
+    Data_Get_Struct( obj, http_parser, parser );
+    if ( 0 != http_parser_restore( parser, RSTRING_PTR( dump ), RSTRING_LEN( dump ) ) ) {
+        return Qnil;
+    }
+    return obj;
+}
+
+/*
+ * call-seq:
+ *   Http::Parser.load( dump ) -> parser
+ *   Http::RequestParser.load( dump ) -> request_parser
+ *
+ * A new parser that carries on from where the parser +dump+ was taken
+ * from had got to.  Set its callbacks before parsing any more with it.
+ * Http::Parser.load gives a RequestParser or ResponseParser, whichever
+ * the dump was taken from.
+ *
+ * Raises ArgumentError if +dump+ is not from Parser#dump, of this version
+ * of the parser.
+ */
+VALUE hpe_parser_s_load( VALUE klass, VALUE dump )
+{
+    VALUE obj = Qnil;
+
+    StringValue( dump );
+    if ( cHttpParser == klass ) {
+        obj = hpe_parser_load_as( cHttpRequestParser, dump );
+        if ( Qnil == obj ) {
+            obj = hpe_parser_load_as( cHttpResponseParser, dump );
+        }
+    } else {
+        obj = hpe_parser_load_as( klass, dump );
+    }
+    if ( Qnil == obj ) {
+        rb_raise( rb_eArgError, "not a dump of an %s", rb_class2name( klass ) );
+    }
+    return obj;
+}
+
+/*
+ * call-seq:
+ *   RequestParser.new
+ *
+ * Create a new HTTP Request parser.
+ *
+ */
+VALUE hpe_request_parser_initialize( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    http_parser_init( parser, HTTP_REQUEST );
+
+    rb_call_super( 0, NULL );
+
+    /* we use the data field in the parser to point to the Ruby Object
+     * that wraps it
+     */
+    parser->data = (void*)self;
+    rb_iv_set( self, "@on_extension_method_callback", Qnil);
+    rb_iv_set( self, "@on_scheme_callback", Qnil);
+    rb_iv_set( self, "@on_host_callback", Qnil);
+    rb_iv_set( self, "@on_path_callback", Qnil);
+    rb_iv_set( self, "@on_route_callback", Qnil);
+    rb_iv_set( self, "@router", Qnil);
+    rb_iv_set( self, "@on_uri_callback", Qnil);
+    rb_iv_set( self, "@on_fragment_callback", Qnil);
+    rb_iv_set( self, "@on_query_string_callback", Qnil);
+    rb_iv_set( self, "@query_string_buffer", Qnil);
+
+    return self;
+}
+
+/*
+ * call-seq:
+ *   ResponseParser.new
+ *
+ * Create a new HTTP Response parser.
+ *
+ */
+VALUE hpe_response_parser_initialize( VALUE self )
+{
+    http_parser *parser;
+
+    Data_Get_Struct( self, http_parser, parser );
+    http_parser_init( parser, HTTP_RESPONSE );
+
+    rb_call_super( 0, NULL );
+
+    /* we use the data field in the parser to point to the Ruby Object
+     * that wraps it.
+     */
+    parser->data = (void*)self;
+
+    return self;
+}
+
+
+void Init_http_parser_ext()
+{
+    int i;
+
     mHttp               = rb_define_module( "Http" );
     cHttpParser         = rb_define_class_under( mHttp, "Parser", rb_cObject);
     cHttpRequestParser  = rb_define_class_under( mHttp, "RequestParser", cHttpParser );
     cHttpResponseParser = rb_define_class_under( mHttp, "ResponseParser", cHttpParser );
     eHttpParserError    = rb_define_class_under( cHttpParser, "Error", rb_eStandardError );
+    cHttpRouter         = rb_define_class_under( mHttp, "Router", rb_cObject);
+    cHttpParserTable    = rb_define_class_under( mHttp, "ParserTable", rb_cObject);
+    cHttpParsedHeaders  = rb_define_class_under( mHttp, "ParsedHeaders", rb_cObject);
 
     /* Http:: Constants */
     /* methods */
-    rb_define_const( mHttp, "COPY"      ,rb_str_new2("COPY") );
-    rb_define_const( mHttp, "DELETE"    ,rb_str_new2("DELETE") );
-    rb_define_const( mHttp, "GET"       ,rb_str_new2("GET") );
-    rb_define_const( mHttp, "HEAD"      ,rb_str_new2("HEAD") );
-    rb_define_const( mHttp, "LOCK"      ,rb_str_new2("LOCK") );
-    rb_define_const( mHttp, "MKCOL"     ,rb_str_new2("MKCOL") );
-    rb_define_const( mHttp, "MOVE"      ,rb_str_new2("MOVE") );
-    rb_define_const( mHttp, "OPTIONS"   ,rb_str_new2("OPTIONS") );
-    rb_define_const( mHttp, "POST"      ,rb_str_new2("POST") );
-    rb_define_const( mHttp, "PROPFIND"  ,rb_str_new2("PROPFIND") );
-    rb_define_const( mHttp, "PROPPATCH" ,rb_str_new2("PROPPATCH") );
-    rb_define_const( mHttp, "PUT"       ,rb_str_new2("PUT") );
-    rb_define_const( mHttp, "TRACE"     ,rb_str_new2("TRACE") );
-    rb_define_const( mHttp, "UNLOCK"    ,rb_str_new2("UNLOCK") );
+#define HPE_METHOD_CONST(NAME, STRING)                                  \
+    hpe_methods[ HTTP_##NAME ] = rb_obj_freeze( rb_str_new2( STRING ) );  \
+    rb_define_const( mHttp, #NAME, hpe_methods[ HTTP_##NAME ] );
+    HTTP_METHOD_MAP(HPE_METHOD_CONST)
+#undef HPE_METHOD_CONST
 
     /* transer encodings */
     rb_define_const( mHttp, "IDENTITY" ,rb_str_new2("IDENTITY") );
     rb_define_const( mHttp, "CHUNKED"  ,rb_str_new2("CHUNKED") );
 
+    /* error codes, HPE_INVALID_METHOD becomes :invalid_method */
+    for ( i = 0 ; i <= HPE_UNKNOWN ; i++ ) {
+        char        code[64];
+        const char *name = http_errno_name( i ) + strlen( "HPE_" );
+        int         j;
+
+        for ( j = 0 ; name[j] && j < (int)sizeof( code ) - 1 ; j++ ) {
+            code[j] = tolower( name[j] );
+        }
+        code[j] = '\0';
+        hpe_error_codes[i] = ID2SYM( rb_intern( code ) );
+    }
+
+    hpe_id_query_string_buffer = rb_intern( "@query_string_buffer" );
+
 
     /******************************************************************
      * Http::Parser 
     ******************************************************************/
     rb_define_method( cHttpParser, "chunked_encoding?" ,hpe_parser_chunked_encoding , 0 ); 
+    rb_define_method( cHttpParser, "trailer?"          ,hpe_parser_trailer          , 0 );
+    rb_define_method( cHttpParser, "skip_body?"        ,hpe_parser_skip_body        , 0 );
+    rb_define_method( cHttpParser, "skip_body="        ,hpe_parser_set_skip_body    , 1 );
+    rb_define_method( cHttpParser, "upgrade?"          ,hpe_parser_upgrade          , 0 );
+    rb_define_method( cHttpParser, "expect_continue?"  ,hpe_parser_expect_continue  , 0 );
+    rb_define_method( cHttpParser, "headers_only="     ,hpe_parser_set_headers_only , 1 );
+    rb_define_method( cHttpParser, "headers_only?"     ,hpe_parser_headers_only     , 0 );
+    rb_define_method( cHttpParser, "body_pending?"     ,hpe_parser_body_pending     , 0 );
+    rb_define_method( cHttpParser, "consume_body"      ,hpe_parser_consume_body     , 1 );
     rb_define_method( cHttpParser, "version"           ,hpe_parser_version          , 0 );
     rb_define_method( cHttpParser, "keep_alive?"       ,hpe_parser_keep_alive       , 0 );
     rb_define_method( cHttpParser, "content_length"    ,hpe_parser_content_length   , 0 );
+    rb_define_method( cHttpParser, "chunk_size"        ,hpe_parser_chunk_size       , 0 );
+    rb_define_method( cHttpParser, "stream_offset"     ,hpe_parser_stream_offset    , 0 );
+    rb_define_method( cHttpParser, "interesting_headers=" ,hpe_parser_set_interesting_headers , 1 );
+    rb_define_method( cHttpParser, "reassemble_tokens="   ,hpe_parser_set_reassemble_tokens   , 1 );
+    rb_define_method( cHttpParser, "collect_headers="     ,hpe_parser_set_collect_headers     , 1 );
+    rb_define_method( cHttpParser, "header"            ,hpe_parser_header           , 1 );
+    rb_define_method( cHttpParser, "headers"           ,hpe_parser_headers          , 0 );
     rb_define_method( cHttpParser, "parse_chunk"       ,hpe_parser_parse_chunk      , 1 );
+    rb_define_method( cHttpParser, "parse_chunk!"      ,hpe_parser_parse_chunk_bang , 1 );
+    rb_define_method( cHttpParser, "finish"            ,hpe_parser_finish           , 0 );
+    rb_define_singleton_method( cHttpParser, "parse_chunks" ,hpe_parser_s_parse_chunks , 2 );
+    rb_define_method( cHttpParser, "dump"              ,hpe_parser_dump             , 0 );
+    rb_define_singleton_method( cHttpParser, "load"    ,hpe_parser_s_load           , 1 );
+    rb_define_method( cHttpParser, "error_code"        ,hpe_parser_error_code       , 0 );
+    rb_define_method( cHttpParser, "error_offset"      ,hpe_parser_error_offset     , 0 );
 
     /* the common callbacks */
     rb_define_method( cHttpParser, "on_message_begin="    ,hpe_parser_on_message_begin   , 1 );
     rb_define_method( cHttpParser, "on_header_field="     ,hpe_parser_on_header_field    , 1 );
     rb_define_method( cHttpParser, "on_header_value="     ,hpe_parser_on_header_value    , 1 );
     rb_define_method( cHttpParser, "on_headers_complete=" ,hpe_parser_on_headers_complete, 1 );
+    rb_define_method( cHttpParser, "on_chunk_extension="  ,hpe_parser_on_chunk_extension , 1 );
+    rb_define_method( cHttpParser, "on_chunk_header="     ,hpe_parser_on_chunk_header    , 1 );
+    rb_define_method( cHttpParser, "on_chunk_complete="   ,hpe_parser_on_chunk_complete  , 1 );
     rb_define_method( cHttpParser, "on_body="             ,hpe_parser_on_body            , 1 );
+    rb_define_method( cHttpParser, "on_body_range="       ,hpe_parser_on_body_range      , 1 );
+    rb_define_method( cHttpParser, "on_framing_range="    ,hpe_parser_on_framing_range   , 1 );
     rb_define_method( cHttpParser, "on_message_complete=" ,hpe_parser_on_message_complete, 1 );
 
 
@@ -499,9 +2351,24 @@ void Init_http_parser_ext()
     rb_define_alloc_func( cHttpRequestParser, hpe_alloc);
     rb_define_method( cHttpRequestParser, "initialize",hpe_request_parser_initialize, 0 );
     rb_define_method( cHttpRequestParser, "method"    ,hpe_parser_method            , 0 );
+    rb_define_method( cHttpRequestParser, "port"      ,hpe_parser_port              , 0 );
+    rb_define_method( cHttpRequestParser, "decode_buffer_size=" ,hpe_parser_set_decode_buffer_size , 1 );
+    rb_define_method( cHttpRequestParser, "decoded_path"        ,hpe_parser_decoded_path           , 0 );
+    rb_define_method( cHttpRequestParser, "decoded_query_string",hpe_parser_decoded_query_string   , 0 );
+    rb_define_method( cHttpRequestParser, "query_params"        ,hpe_parser_query_params           , -1 );
+    rb_define_method( cHttpRequestParser, "collect_query_string=" ,hpe_request_parser_set_collect_query_string , 1 );
+    rb_define_method( cHttpRequestParser, "router="             ,hpe_parser_set_router             , 1 );
+    rb_define_method( cHttpRequestParser, "route"               ,hpe_parser_route                  , 0 );
+    rb_define_method( cHttpRequestParser, "route_params"        ,hpe_parser_route_params           , 0 );
+    rb_define_method( cHttpRequestParser, "on_message_begin="   ,hpe_request_parser_on_message_begin , 1 );
+    rb_define_method( cHttpRequestParser, "on_query_string="    ,hpe_request_parser_on_query_string  , 1 );
 
     /* additional request callbacks */
+    rb_define_method( cHttpParser, "on_extension_method=",hpe_parser_on_extension_method, 1 );
+    rb_define_method( cHttpParser, "on_scheme="         ,hpe_parser_on_scheme        , 1 );
+    rb_define_method( cHttpParser, "on_host="           ,hpe_parser_on_host          , 1 );
     rb_define_method( cHttpParser, "on_path="           ,hpe_parser_on_path          , 1 );
+    rb_define_method( cHttpParser, "on_route="          ,hpe_parser_on_route         , 1 );
     rb_define_method( cHttpParser, "on_query_string="   ,hpe_parser_on_query_string  , 1 );
     rb_define_method( cHttpParser, "on_uri="            ,hpe_parser_on_uri           , 1 );
     rb_define_method( cHttpParser, "on_fragment="       ,hpe_parser_on_fragment      , 1 );
@@ -514,6 +2381,44 @@ void Init_http_parser_ext()
     rb_define_method( cHttpResponseParser, "initialize"  ,hpe_response_parser_initialize, 0 );
     rb_define_method( cHttpResponseParser, "status_code" ,hpe_parser_status_code        , 0 );
 
+    /******************************************************************
+     * Http::Router
+     ******************************************************************/
+    rb_define_alloc_func( cHttpRouter, hpe_router_alloc);
+    rb_define_method( cHttpRouter, "initialize" ,hpe_router_initialize , 0 );
+    rb_define_method( cHttpRouter, "add"        ,hpe_router_add        , 2 );
+
+    /******************************************************************
+     * Http::ParserTable
+     ******************************************************************/
+    rb_define_alloc_func( cHttpParserTable, hpe_table_alloc);
+    rb_define_method( cHttpParserTable, "initialize"  ,hpe_table_initialize  , -1 );
+    rb_define_method( cHttpParserTable, "size"        ,hpe_table_size        , 0 );
+    rb_define_method( cHttpParserTable, "open"        ,hpe_table_open        , 1 );
+    rb_define_method( cHttpParserTable, "parse_chunk" ,hpe_table_parse_chunk , 2 );
+    rb_define_method( cHttpParserTable, "finish"      ,hpe_table_finish      , 1 );
+    rb_define_method( cHttpParserTable, "error?"      ,hpe_table_has_error   , 1 );
+    rb_define_method( cHttpParserTable, "on_message_begin="    ,hpe_table_on_message_begin    , 1 );
+    rb_define_method( cHttpParserTable, "on_headers_complete=" ,hpe_table_on_headers_complete , 1 );
+    rb_define_method( cHttpParserTable, "on_body="             ,hpe_table_on_body             , 1 );
+    rb_define_method( cHttpParserTable, "on_message_complete=" ,hpe_table_on_message_complete , 1 );
+
+    /******************************************************************
+     * Http::ParsedHeaders
+     ******************************************************************/
+    rb_undef_alloc_func( cHttpParsedHeaders );
+    rb_include_module( cHttpParsedHeaders, rb_mEnumerable );
+    rb_define_method( cHttpParsedHeaders, "fetch"    ,hpe_headers_fetch   , 1 );
+    rb_define_method( cHttpParsedHeaders, "[]"       ,hpe_headers_fetch   , 1 );
+    rb_define_method( cHttpParsedHeaders, "key?"     ,hpe_headers_has_key , 1 );
+    rb_define_method( cHttpParsedHeaders, "include?" ,hpe_headers_has_key , 1 );
+    rb_define_method( cHttpParsedHeaders, "each"     ,hpe_headers_each    , 0 );
+    rb_define_method( cHttpParsedHeaders, "keys"     ,hpe_headers_keys    , 0 );
+    rb_define_method( cHttpParsedHeaders, "values"   ,hpe_headers_values  , 0 );
+    rb_define_method( cHttpParsedHeaders, "to_hash"  ,hpe_headers_to_hash , 0 );
+    rb_define_method( cHttpParsedHeaders, "size"     ,hpe_headers_size    , 0 );
+    rb_define_method( cHttpParsedHeaders, "empty?"   ,hpe_headers_empty   , 0 );
+
 }
 
 
@@ -0,0 +1,91 @@
+/* Bump pointer allocation for parsers, see http_arena.h */
+#include "http_arena.h"
+#include <stdlib.h>
+
+struct http_arena_block {
+  http_arena_block *next;
+  size_t size;
+  size_t used;
+};
+
+#define ALIGNMENT 16
+#define ALIGN(n) (((n) + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1))
+#define BLOCK_DATA(block) ((char *)(block) + ALIGN(sizeof(http_arena_block)))
+
+void
+http_arena_init (http_arena *arena, size_t block_size)
+{
+  arena->block_size = block_size;
+  arena->first = NULL;
+  arena->current = NULL;
+}
+
+void *
+http_arena_alloc (http_arena *arena, size_t size)
+{
+  http_arena_block *block = arena->current;
+  http_arena_block *last = NULL;
+  size_t block_size;
+
+  size = ALIGN(size);
+  while (block) {
+    if (block->size - block->used >= size) {
+      arena->current = block;
+      block->used += size;
+      return BLOCK_DATA(block) + block->used - size;
+    }
+    last = block;
+    /* blocks after the current one are free since the last reset */
+    if ((block = block->next)) block->used = 0;
+  }
+
+  block_size = size > arena->block_size ? size : arena->block_size;
+  block = malloc(ALIGN(sizeof(http_arena_block)) + block_size);
+  if (block == NULL) return NULL;
+  block->next = NULL;
+  block->size = block_size;
+  block->used = size;
+  if (last) {
+    last->next = block;
+  } else {
+    arena->first = block;
+  }
+  arena->current = block;
+  return BLOCK_DATA(block);
+}
+
+int
+http_arena_grow (http_arena *arena, void *ptr, size_t size, size_t new_size)
+{
+  http_arena_block *block = arena->current;
+
+  size = ALIGN(size);
+  new_size = ALIGN(new_size);
+  if (block == NULL || size == 0 || block->used < size ||
+      (char *)ptr != BLOCK_DATA(block) + block->used - size ||
+      block->size - block->used < new_size - size) {
+    return -1;
+  }
+  block->used += new_size - size;
+  return 0;
+}
+
+void
+http_arena_reset (http_arena *arena)
+{
+  arena->current = arena->first;
+  if (arena->first) arena->first->used = 0;
+}
+
+void
+http_arena_free (http_arena *arena)
+{
+  http_arena_block *block, *next;
+
+  for (block = arena->first; block; block = next) {
+    next = block->next;
+    free(block);
+  }
+  arena->first = NULL;
+  arena->current = NULL;
+}
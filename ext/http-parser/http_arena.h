@@ -0,0 +1,48 @@
+/* Bump pointer allocation for the storage a parser needs for a message.
+ *
+ * An arena hands out memory from blocks of block_size bytes, or larger for
+ * a bigger request, chained as they fill up. Nothing is freed on its own,
+ * http_arena_reset() makes all of it available again and keeps the blocks,
+ * so once an arena has grown to what a message needs parsing more messages
+ * allocates nothing. Attached to a parser, see parser->arena, it is reset
+ * at the end of every message.
+ */
+#ifndef http_arena_h
+#define http_arena_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+
+typedef struct http_arena http_arena;
+typedef struct http_arena_block http_arena_block;
+
+struct http_arena {
+  /** PRIVATE **/
+  size_t block_size;
+  http_arena_block *first;
+  http_arena_block *current; /* being allocated from */
+};
+
+/* No memory is allocated until it is needed. */
+void http_arena_init (http_arena *arena, size_t block_size);
+
+/* Returns NULL if memory ran out. The memory is suitably aligned for any
+ * type and stays valid until the arena is reset or freed.
+ */
+void *http_arena_alloc (http_arena *arena, size_t size);
+
+/* Grows ptr, the last size bytes allocated, to new_size where it is.
+ * Returns 0, or -1 if something was allocated after it or there is no
+ * room for it to grow, when it is left as it was.
+ */
+int http_arena_grow (http_arena *arena, void *ptr, size_t size, size_t new_size);
+
+void http_arena_reset (http_arena *arena);
+void http_arena_free (http_arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,235 @@
+/* Headers collected by the parser, see http_headers.h */
+#include "http_headers.h"
+#include <limits.h>
+#include <string.h>
+
+#define LOWER(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+
+static const struct {
+  const char *name;
+  size_t length;
+} header_ids[] = {
+  { NULL, 0 },
+#define HTTP_HEADER_ENTRY(n, s) { s, sizeof(s) - 1 },
+  HTTP_HEADER_MAP(HTTP_HEADER_ENTRY)
+#undef HTTP_HEADER_ENTRY
+};
+
+static int
+same_name (const char *a, const char *b, size_t length)
+{
+  while (length--) {
+    if (LOWER(*a) != LOWER(*b)) return 0;
+    a++;
+    b++;
+  }
+  return 1;
+}
+
+/* the only well known header name could be, told by its length and one
+ * of its letters, in step with HTTP_HEADER_MAP */
+static enum http_header_id
+header_candidate (const char *name, size_t length)
+{
+  switch (length) {
+  case 4:
+    switch (LOWER(name[0])) {
+    case 'd': return HTTP_HEADER_DATE;
+    case 'e': return HTTP_HEADER_ETAG;
+    case 'h': return HTTP_HEADER_HOST;
+    }
+    break;
+  case 5:  return HTTP_HEADER_RANGE;
+  case 6:
+    switch (LOWER(name[0])) {
+    case 'a': return HTTP_HEADER_ACCEPT;
+    case 'c': return HTTP_HEADER_COOKIE;
+    case 'e': return HTTP_HEADER_EXPECT;
+    case 'o': return HTTP_HEADER_ORIGIN;
+    case 's': return HTTP_HEADER_SERVER;
+    }
+    break;
+  case 7:
+    switch (LOWER(name[0])) {
+    case 'r': return HTTP_HEADER_REFERER;
+    case 'u': return HTTP_HEADER_UPGRADE;
+    }
+    break;
+  case 8:  return HTTP_HEADER_LOCATION;
+  case 10:
+    switch (LOWER(name[0])) {
+    case 'c': return HTTP_HEADER_CONNECTION;
+    case 's': return HTTP_HEADER_SET_COOKIE;
+    case 'u': return HTTP_HEADER_USER_AGENT;
+    }
+    break;
+  case 12: return HTTP_HEADER_CONTENT_TYPE;
+  case 13:
+    switch (LOWER(name[0])) {
+    case 'a': return HTTP_HEADER_AUTHORIZATION;
+    case 'c': return HTTP_HEADER_CACHE_CONTROL;
+    case 'i': return HTTP_HEADER_IF_NONE_MATCH;
+    case 'l': return HTTP_HEADER_LAST_MODIFIED;
+    }
+    break;
+  case 14: return HTTP_HEADER_CONTENT_LENGTH;
+  case 15:
+    switch (LOWER(name[7])) {
+    case 'e': return HTTP_HEADER_ACCEPT_ENCODING;
+    case 'l': return HTTP_HEADER_ACCEPT_LANGUAGE;
+    case 'r': return HTTP_HEADER_X_FORWARDED_FOR;
+    }
+    break;
+  case 16: return HTTP_HEADER_CONTENT_ENCODING;
+  case 17:
+    switch (LOWER(name[0])) {
+    case 'i': return HTTP_HEADER_IF_MODIFIED_SINCE;
+    case 't': return HTTP_HEADER_TRANSFER_ENCODING;
+    }
+    break;
+  }
+  return HTTP_HEADER_OTHER;
+}
+
+enum http_header_id
+http_header_id (const char *name, size_t length)
+{
+  enum http_header_id id = header_candidate(name, length);
+
+  if (id != HTTP_HEADER_OTHER &&
+      same_name(header_ids[id].name, name, length)) {
+    return id;
+  }
+  return HTTP_HEADER_OTHER;
+}
+
+const char *
+http_header_id_name (enum http_header_id id)
+{
+  if ((unsigned)id >= HTTP_HEADER_IDS) return NULL;
+  return header_ids[id].name;
+}
+
+void
+http_headers_clear (http_headers *headers)
+{
+  headers->count = 0;
+  headers->more = NULL;
+  headers->more_size = 0;
+  memset(headers->first, 0, sizeof(headers->first));
+}
+
+/* room for one more header, growing the ones in the arena by doubling */
+static http_header *
+header_slot (http_headers *headers, http_arena *arena)
+{
+  size_t i = headers->count;
+  http_header *more;
+  size_t size;
+
+  if (i < HTTP_HEADERS_INLINE) return &headers->inline_headers[i];
+  i -= HTTP_HEADERS_INLINE;
+  if (i == headers->more_size) {
+    size = headers->more_size ? 2 * headers->more_size : HTTP_HEADERS_INLINE;
+    more = http_arena_alloc(arena, size * sizeof(http_header));
+    if (more == NULL) return NULL;
+    if (headers->more) {
+      memcpy(more, headers->more, headers->more_size * sizeof(http_header));
+    }
+    headers->more = more;
+    headers->more_size = size;
+  }
+  return &headers->more[i];
+}
+
+int
+http_headers_add (http_headers *headers, http_arena *arena,
+                  const char *name, size_t length)
+{
+  http_header *header;
+  char *copy;
+
+  if (arena == NULL) return -1;
+  if ((header = header_slot(headers, arena)) == NULL) return -1;
+  if ((copy = http_arena_alloc(arena, length)) == NULL) return -1;
+  memcpy(copy, name, length);
+
+  header->name = copy;
+  header->name_length = length;
+  header->value = "";
+  header->value_length = 0;
+  header->id = http_header_id(name, length);
+  if (header->id != HTTP_HEADER_OTHER && headers->first[header->id] == 0 &&
+      headers->count < USHRT_MAX) {
+    headers->first[header->id] = (unsigned short)(headers->count + 1);
+  }
+  headers->count++;
+  return 0;
+}
+
+int
+http_headers_add_value (http_headers *headers, http_arena *arena,
+                        const char *at, size_t length)
+{
+  http_header *header;
+  char *copy;
+
+  if (headers->count == 0 || length == 0) return 0;
+  header = (http_header *)http_headers_at(headers, headers->count - 1);
+
+  /* more than one piece only for a folded value, which is usually still
+   * the last thing in the arena and grows where it is */
+  if (header->value_length > 0 &&
+      http_arena_grow(arena, (char *)header->value, header->value_length,
+                      header->value_length + length) == 0) {
+    memcpy((char *)header->value + header->value_length, at, length);
+    header->value_length += length;
+    return 0;
+  }
+  copy = http_arena_alloc(arena, header->value_length + length);
+  if (copy == NULL) return -1;
+  memcpy(copy, header->value, header->value_length);
+  memcpy(copy + header->value_length, at, length);
+  header->value = copy;
+  header->value_length += length;
+  return 0;
+}
+
+const http_header *
+http_headers_at (const http_headers *headers, size_t i)
+{
+  if (i < HTTP_HEADERS_INLINE) return &headers->inline_headers[i];
+  return &headers->more[i - HTTP_HEADERS_INLINE];
+}
+
+const http_header *
+http_headers_find (const http_headers *headers, enum http_header_id id)
+{
+  if ((unsigned)id >= HTTP_HEADER_IDS || headers->first[id] == 0) return NULL;
+  return http_headers_at(headers, headers->first[id] - 1);
+}
+
+const http_header *
+http_headers_lookup (const http_headers *headers,
+                     const char *name, size_t length)
+{
+  enum http_header_id id = http_header_id(name, length);
+  const http_header *header;
+  size_t i;
+
+  if (id != HTTP_HEADER_OTHER) return http_headers_find(headers, id);
+  for (i = 0; i < headers->count; i++) {
+    header = http_headers_at(headers, i);
+    if (http_header_is(header, id, name, length)) return header;
+  }
+  return NULL;
+}
+
+int
+http_header_is (const http_header *header, enum http_header_id id,
+                const char *name, size_t length)
+{
+  if (header->id != id) return 0;
+  if (id != HTTP_HEADER_OTHER) return 1;
+  return header->name_length == length && same_name(header->name, name, length);
+}
@@ -0,0 +1,117 @@
+/* The headers of a message, collected by the parser, see parser->headers.
+ *
+ * The first HTTP_HEADERS_INLINE headers are kept in the struct and any more
+ * in the parser's arena, as are all the names and values, so they are
+ * valid until the end of the message, when the arena is reset. Well known
+ * headers have an id, see HTTP_HEADER_MAP, and the first header with an id
+ * is found with http_headers_find() in a single array read. Trailers are
+ * collected after the headers.
+ */
+#ifndef http_headers_h
+#define http_headers_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+#include "http_arena.h"
+
+#define HTTP_HEADERS_INLINE 32
+
+#define HTTP_HEADER_MAP(XX)                      \
+  XX(ACCEPT,            "Accept")                \
+  XX(ACCEPT_ENCODING,   "Accept-Encoding")       \
+  XX(ACCEPT_LANGUAGE,   "Accept-Language")       \
+  XX(AUTHORIZATION,     "Authorization")         \
+  XX(CACHE_CONTROL,     "Cache-Control")         \
+  XX(CONNECTION,        "Connection")            \
+  XX(CONTENT_ENCODING,  "Content-Encoding")      \
+  XX(CONTENT_LENGTH,    "Content-Length")        \
+  XX(CONTENT_TYPE,      "Content-Type")          \
+  XX(COOKIE,            "Cookie")                \
+  XX(DATE,              "Date")                  \
+  XX(ETAG,              "ETag")                  \
+  XX(EXPECT,            "Expect")                \
+  XX(HOST,              "Host")                  \
+  XX(IF_MODIFIED_SINCE, "If-Modified-Since")     \
+  XX(IF_NONE_MATCH,     "If-None-Match")         \
+  XX(LAST_MODIFIED,     "Last-Modified")         \
+  XX(LOCATION,          "Location")              \
+  XX(ORIGIN,            "Origin")                \
+  XX(RANGE,             "Range")                 \
+  XX(REFERER,           "Referer")               \
+  XX(SERVER,            "Server")                \
+  XX(SET_COOKIE,        "Set-Cookie")            \
+  XX(TRANSFER_ENCODING, "Transfer-Encoding")     \
+  XX(UPGRADE,           "Upgrade")               \
+  XX(USER_AGENT,        "User-Agent")            \
+  XX(X_FORWARDED_FOR,   "X-Forwarded-For")
+
+#define HTTP_HEADER_GEN(n, s) HTTP_HEADER_##n,
+enum http_header_id {
+  HTTP_HEADER_OTHER,
+  HTTP_HEADER_MAP(HTTP_HEADER_GEN)
+  HTTP_HEADER_IDS
+};
+#undef HTTP_HEADER_GEN
+
+typedef struct http_header http_header;
+struct http_header {
+  const char *name;
+  size_t name_length;
+  const char *value;    /* "" until a value is parsed */
+  size_t value_length;
+  enum http_header_id id;
+};
+
+typedef struct http_headers http_headers;
+struct http_headers {
+  /** READ-ONLY **/
+  size_t count;
+
+  /** PRIVATE **/
+  http_header inline_headers[HTTP_HEADERS_INLINE];
+  http_header *more;      /* the rest, in the arena */
+  size_t more_size;
+  unsigned short first[HTTP_HEADER_IDS]; /* index + 1 of the first header
+                                            with each id, 0 for none */
+};
+
+/* Empties headers. The parser does this at the end of every message. */
+void http_headers_clear (http_headers *headers);
+
+/* Used by the parser. http_headers_add() adds a header named name and
+ * http_headers_add_value() appends to the value of the last one added,
+ * both copying into arena. They return 0, or -1 if the arena could not
+ * allocate.
+ */
+int http_headers_add (http_headers *headers, http_arena *arena,
+                      const char *name, size_t length);
+int http_headers_add_value (http_headers *headers, http_arena *arena,
+                            const char *at, size_t length);
+
+/* The i-th header, in the order they were parsed, i < headers->count. */
+const http_header *http_headers_at (const http_headers *headers, size_t i);
+
+/* The first header with the id, NULL if there is none. */
+const http_header *http_headers_find (const http_headers *headers,
+                                      enum http_header_id id);
+
+/* The first header named name, compared case-insensitively, NULL if there
+ * is none. */
+const http_header *http_headers_lookup (const http_headers *headers,
+                                        const char *name, size_t length);
+
+/* Whether header is named name, compared case-insensitively. id is
+ * http_header_id() of name, well known headers are told apart by it. */
+int http_header_is (const http_header *header, enum http_header_id id,
+                    const char *name, size_t length);
+
+/* The id of a header name, HTTP_HEADER_OTHER if it is not well known. */
+enum http_header_id http_header_id (const char *name, size_t length);
+const char *http_header_id_name (enum http_header_id id);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
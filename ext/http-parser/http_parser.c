@@ -26,6 +26,10 @@
 #include "http_parser.h"
 #include <limits.h>
 #include <assert.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 static int unhex[] = {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
                      ,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
@@ -39,17 +43,43 @@ static int unhex[] = {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
 #define TRUE 1
 #define FALSE 0
 #define MIN(a,b) (a < b ? a : b)
+#ifndef NULL
 #define NULL (void*)(0)
+#endif
 
 #define MAX_FIELD_SIZE 80*1024
 
-#define REMAINING (pe - p)
+#if defined(__GNUC__)
+# define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+# define PREFETCH(addr)
+#endif
+
+#define REMAINING (unsigned long)(pe - p)
+
+#define SET_ERROR(ERRNO)                                             \
+do {                                                                 \
+  parser->error = TRUE;                                              \
+  parser->http_errno = (ERRNO);                                      \
+  parser->error_offset = p - buffer;                                 \
+} while(0)
+
+/* Used by the ragel error actions. More than one may be embedded in the
+ * failing state, so the first (innermost) one to run wins.
+ */
+#define SET_PARSE_ERROR(ERRNO)                                       \
+do {                                                                 \
+  if (parser->http_errno == HPE_OK) {                                \
+    SET_ERROR(ERRNO);                                                \
+  }                                                                  \
+} while(0)
+
 #define CALLBACK(FOR)                                                \
 do {                                                                 \
   if (parser->FOR##_mark) {                                          \
     parser->FOR##_size += p - parser->FOR##_mark;                    \
     if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
-      parser->error = TRUE;                                          \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
       return 0;                                                      \
     }                                                                \
     if (parser->on_##FOR) {                                          \
@@ -60,38 +90,215 @@ do {                                                                 \
   }                                                                  \
 } while(0)
 
+#define DECODE(FOR)                                                  \
+do {                                                                 \
+  if (parser->FOR##_mark && parser->FOR##_decoder.buf) {             \
+    if (http_decoder_feed(&parser->FOR##_decoder,                    \
+          parser->FOR##_mark, p - parser->FOR##_mark)) {             \
+      SET_ERROR(HPE_DECODE_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* with a header_filter field names are gathered in header_name, up to
+ * HTTP_MAX_HEADER_NAME_SIZE, instead of being passed to on_header_field */
+#define BUFFER_FIELD                                                 \
+do {                                                                 \
+  if (parser->header_field_mark) {                                   \
+    tmp = p - parser->header_field_mark;                             \
+    if (parser->header_field_size + tmp <= HTTP_MAX_HEADER_NAME_SIZE) { \
+      memcpy(parser->header_name + parser->header_field_size,        \
+             parser->header_field_mark, tmp);                        \
+    }                                                                \
+    parser->header_field_size += tmp;                                \
+    if (parser->header_field_size > MAX_FIELD_SIZE) {                \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* CALLBACK without the callback, for the values of skipped headers */
+#define SKIP_CALLBACK(FOR)                                           \
+do {                                                                 \
+  if (parser->FOR##_mark) {                                          \
+    parser->FOR##_size += p - parser->FOR##_mark;                    \
+    if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* if KEEP the piece of FOR at the end of the data is kept until the rest
+ * of it is parsed */
+#define PARTIAL_CALLBACK(FOR, KEEP)                                  \
+do {                                                                 \
+  if ((KEEP) && parser->FOR##_mark) {                                \
+    tmp = p - parser->FOR##_mark;                                    \
+    parser->FOR##_size += tmp;                                       \
+    if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+    if (token_append(parser, parser->FOR##_mark, tmp) != 0) {        \
+      SET_ERROR(HPE_TOKEN_OVERFLOW);                                 \
+      return 0;                                                      \
+    }                                                                \
+  } else {                                                           \
+    CALLBACK(FOR);                                                   \
+  }                                                                  \
+} while(0)
+
+/* the end of FOR in token_at and token_length, all of it if pieces have
+ * been kept */
+#define TOKEN(FOR)                                                   \
+do {                                                                 \
+  tmp = p - parser->FOR##_mark;                                      \
+  parser->FOR##_size += tmp;                                         \
+  if (parser->FOR##_size > MAX_FIELD_SIZE) {                         \
+    SET_ERROR(HPE_HEADER_OVERFLOW);                                  \
+    return 0;                                                        \
+  }                                                                  \
+  if (parser->token_len > 0) {                                       \
+    if (token_append(parser, parser->FOR##_mark, tmp) != 0) {        \
+      SET_ERROR(HPE_TOKEN_OVERFLOW);                                 \
+      return 0;                                                      \
+    }                                                                \
+    token_at = parser->token_buf;                                    \
+    token_length = parser->token_len;                                \
+    parser->token_len = 0;                                           \
+  } else {                                                           \
+    token_at = parser->FOR##_mark;                                   \
+    token_length = tmp;                                              \
+  }                                                                  \
+} while(0)
+
+#define TOKEN_CALLBACK(FOR)                                          \
+do {                                                                 \
+  TOKEN(FOR);                                                        \
+  if (parser->on_##FOR) {                                            \
+    callback_return_value = parser->on_##FOR(parser,                 \
+      token_at, token_length);                                       \
+  }                                                                  \
+} while(0)
+
+#define ROUTE                                                        \
+do {                                                                 \
+  if (parser->path_mark && parser->router) {                         \
+    http_route_feed(parser->route,                                   \
+        parser->path_mark, p - parser->path_mark);                   \
+  }                                                                  \
+} while(0)
+
 #define RESET_PARSER(parser)                                         \
     parser->chunk_size = 0;                                          \
     parser->eating = 0;                                              \
+    parser->skip_header = 0;                                         \
+    parser->framing = 0;                                             \
+    parser->token_len = 0;                                           \
+    parser->token_buf = NULL;                                        \
+    parser->token_buf_size = 0;                                      \
+    if (parser->arena) http_arena_reset(parser->arena);              \
+    if (parser->headers) http_headers_clear(parser->headers);        \
     parser->header_field_mark = NULL;                                \
     parser->header_value_mark = NULL;                                \
     parser->query_string_mark = NULL;                                \
     parser->path_mark = NULL;                                        \
     parser->uri_mark = NULL;                                         \
     parser->fragment_mark = NULL;                                    \
+    parser->chunk_extension_mark = NULL;                             \
+    parser->scheme_mark = NULL;                                      \
+    parser->host_mark = NULL;                                        \
     parser->status_code = 0;                                         \
     parser->method = 0;                                              \
+    parser->port = 0;                                                \
+    parser->path_decoder.len = 0;                                    \
+    parser->path_decoder.state = 0;                                  \
+    parser->query_string_decoder.len = 0;                            \
+    parser->query_string_decoder.state = 0;                          \
+    if (parser->route) {                                             \
+      parser->route->route_id = HTTP_NO_ROUTE;                       \
+      parser->route->nparams = 0;                                    \
+      parser->route->node = NULL;                                    \
+    }                                                                \
     parser->transfer_encoding = HTTP_IDENTITY;                       \
     parser->version_major = 0;                                       \
     parser->version_minor = 0;                                       \
     parser->keep_alive = -1;                                         \
+    parser->flags = 0;                                               \
     parser->content_length = 0;                                      \
     parser->body_read = 0; 
 
 #define END_REQUEST                                                  \
 do {                                                                 \
-    if (parser->on_message_complete) {                               \
+    if (parser->inplace_begin) {                                     \
+      callback_return_value = inplace_flush(parser);                 \
+    }                                                                \
+    if (callback_return_value == 0 && parser->on_message_complete) { \
       callback_return_value =                                        \
         parser->on_message_complete(parser);                         \
     }                                                                \
     RESET_PARSER(parser);                                            \
 } while (0)
 
+/* where q is in the stream */
+#define STREAM_OFFSET(q) (parser->stream_offset + (uint64_t)((q) - buffer))
+
+/* a response body with no Content-Length, or whose last transfer coding is
+ * not chunked, runs until the connection closes */
+#define UNFRAMED_RESPONSE                                            \
+  (!(parser->flags & HTTP_FLAG_CONTENT_LENGTH) ||                    \
+   (parser->flags & HTTP_FLAG_UNCHUNKED))
+
+/* body bytes go to on_body, or only where they are to on_body_range */
+#define BODY(at, length)                                             \
+do {                                                                 \
+  if (parser->on_body_range) {                                       \
+    callback_return_value = parser->on_body_range(parser,            \
+        STREAM_OFFSET(at), (length));                                \
+  } else if (parser->on_body) {                                      \
+    callback_return_value = parser->on_body(parser, (at), (length)); \
+  }                                                                  \
+} while (0)
+
+/* the chunk framing from framing_offset up to q */
+#define FRAMING(q)                                                   \
+do {                                                                 \
+  if (parser->on_framing_range &&                                    \
+      STREAM_OFFSET(q) > parser->framing_offset) {                   \
+    callback_return_value = parser->on_framing_range(parser,         \
+        parser->framing_offset,                                      \
+        STREAM_OFFSET(q) - parser->framing_offset);                  \
+  }                                                                  \
+  parser->framing_offset = STREAM_OFFSET(q);                         \
+} while (0)
+
+/* moves the body down to the end of what has been moved so far */
+#define INPLACE(at, length)                                          \
+do {                                                                 \
+  if (parser->inplace_begin == NULL) {                               \
+    parser->inplace_begin = parser->inplace_end = (char *)(at);      \
+  } else if (parser->inplace_end != (at)) {                          \
+    memmove(parser->inplace_end, (at), (length));                    \
+  }                                                                  \
+  parser->inplace_end += (length);                                   \
+} while (0)
+
 #define SKIP_BODY(nskip)                                             \
 do {                                                                 \
   tmp = (nskip);                                                     \
-  if (parser->on_body && tmp > 0) {                                  \
-    callback_return_value = parser->on_body(parser, p, tmp);         \
+  if (parser->framing) {                                             \
+    FRAMING(p);                                                      \
+    parser->framing = FALSE;                                         \
+  }                                                                  \
+  if (callback_return_value == 0 && tmp > 0) {                       \
+    if (parser->inplace) {                                           \
+      INPLACE(p, tmp);                                               \
+    } else {                                                         \
+      BODY(p, tmp);                                                  \
+    }                                                                \
   }                                                                  \
   if (callback_return_value == 0) {                                  \
     p += tmp;                                                        \
@@ -101,6 +308,9 @@ do {                                                                 \
       parser->eating = FALSE;                                        \
       if (parser->transfer_encoding == HTTP_IDENTITY) {              \
         END_REQUEST;                                                 \
+      } else {                                                       \
+        parser->framing = TRUE;                                      \
+        parser->framing_offset = STREAM_OFFSET(p);                   \
       }                                                              \
     } else {                                                         \
       parser->eating = TRUE;                                         \
@@ -108,84 +318,358 @@ do {                                                                 \
   }                                                                  \
 } while (0)
 
-#line 413 "http_parser.rl"
+/* the body moved together by http_parser_execute_inplace() goes to
+ * on_body in one piece */
+static int
+inplace_flush (http_parser *parser)
+{
+  size_t length = parser->inplace_end - parser->inplace_begin;
+  int callback_return_value = 0;
+
+  if (parser->on_body && length > 0) {
+    callback_return_value = parser->on_body(parser, parser->inplace_begin, length);
+  }
+  parser->inplace_begin = parser->inplace_end = NULL;
+  return callback_return_value;
+}
+
+/* the string being reassembled is kept in the arena, from when the first
+ * string of a message is split, and doubles when it outgrows that */
+static int
+token_append (http_parser *parser, const char *at, size_t length)
+{
+  size_t len = parser->token_len + length;
+
+  if (length == 0) return 0;
+  if (len > parser->token_buf_size) {
+    /* the old buffer goes back with the rest of the arena at the end of
+     * the message */
+    size_t size = len > 2 * parser->token_buf_size ?
+                  len : 2 * parser->token_buf_size;
+    char *buf;
+
+    if (size < HTTP_TOKEN_BUF_SIZE) size = HTTP_TOKEN_BUF_SIZE;
+    if (parser->arena == NULL) return -1;
+    buf = http_arena_alloc(parser->arena, size);
+    if (buf == NULL) return -1;
+    if (parser->token_len > 0) memcpy(buf, parser->token_buf, parser->token_len);
+    parser->token_buf = buf;
+    parser->token_buf_size = size;
+  }
+  memcpy(parser->token_buf + parser->token_len, at, length);
+  parser->token_len = len;
+  return 0;
+}
+
+#define LOWER(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+
+/* FNV-1a of the lower cased name */
+static unsigned int
+header_hash (const char *name, size_t length)
+{
+  unsigned int hash = 2166136261u;
+
+  while (length--) {
+    hash ^= (unsigned char)LOWER(*name);
+    hash *= 16777619u;
+    name++;
+  }
+  return hash;
+}
+
+static int
+header_set_contains (const http_header_set *set, const char *name, size_t length)
+{
+  unsigned int i = header_hash(name, length) & (HTTP_HEADER_SET_SLOTS - 1);
+  unsigned int n, j;
+
+  for (n = 0; n < HTTP_HEADER_SET_SLOTS; n++) {
+    if (set->length[i] == 0) return FALSE;
+    if (set->length[i] == length) {
+      for (j = 0; j < length && set->name[i][j] == LOWER(name[j]); j++) ;
+      if (j == length) return TRUE;
+    }
+    i = (i + 1) & (HTTP_HEADER_SET_SLOTS - 1);
+  }
+  return FALSE;
+}
+
+void
+http_header_set_init (http_header_set *set)
+{
+  memset(set->length, 0, sizeof(set->length));
+}
+
+int
+http_header_set_add (http_header_set *set, const char *name)
+{
+  size_t length = strlen(name);
+  unsigned int i, n, j;
+
+  if (length == 0 || length > HTTP_MAX_HEADER_NAME_SIZE) return -1;
+  if (header_set_contains(set, name, length)) return 0;
+
+  i = header_hash(name, length) & (HTTP_HEADER_SET_SLOTS - 1);
+  for (n = 0; n < HTTP_HEADER_SET_SLOTS; n++) {
+    if (set->length[i] == 0) {
+      for (j = 0; j < length; j++) set->name[i][j] = LOWER(name[j]);
+      set->length[i] = length;
+      return 0;
+    }
+    i = (i + 1) & (HTTP_HEADER_SET_SLOTS - 1);
+  }
+  return -1;
+}
+
+/* Returns the first '%', or '+' when that decodes to a space, in
+ * [p, end) or end if there is none.
+ */
+static const char *
+decoder_scan (const char *p, const char *end, int plus_is_space)
+{
+#ifdef __SSE2__
+  const __m128i percent = _mm_set1_epi8('%');
+  const __m128i plus = _mm_set1_epi8(plus_is_space ? '+' : '%');
+  __m128i chunk;
+  int mask;
+
+  while (end - p >= 16) {
+    chunk = _mm_loadu_si128((const __m128i *)p);
+    mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, percent),
+                                          _mm_cmpeq_epi8(chunk, plus)));
+    if (mask) return p + __builtin_ctz(mask);
+    p += 16;
+  }
+#endif
+  while (p < end && *p != '%' && !(plus_is_space && *p == '+')) p++;
+  return p;
+}
+
+/* Appends the decoding of [at, at + length) to dec->buf. An escape may be
+ * split across calls, the grammar has already checked its hex digits.
+ * Returns non-zero if dec->buf is full.
+ */
+static int
+http_decoder_feed (http_decoder *dec, const char *at, size_t length)
+{
+  const char *end = at + length;
+  const char *run;
+
+  while (at < end) {
+    if (dec->state == 2) {
+      dec->hi = unhex[(unsigned char)*at++];
+      dec->state = 1;
+      continue;
+    }
+    if (dec->state == 1) {
+      if (dec->len == dec->size) return 1;
+      dec->buf[dec->len++] = (char)(dec->hi << 4 | unhex[(unsigned char)*at++]);
+      dec->state = 0;
+      continue;
+    }
+
+    run = decoder_scan(at, end, dec->plus_is_space);
+    if ((size_t)(run - at) > dec->size - dec->len) return 1;
+    memcpy(dec->buf + dec->len, at, run - at);
+    dec->len += run - at;
+    at = run;
+
+    if (at == end) break;
+    if (*at == '+') {
+      if (dec->len == dec->size) return 1;
+      dec->buf[dec->len++] = ' ';
+    } else {
+      dec->state = 2;
+    }
+    at++;
+  }
+  return 0;
+}
+
+/* The known methods, in the order of HTTP_METHOD_MAP. The names are zero
+ * padded to 16 bytes so a token is compared a word at a time rather than a
+ * character at a time.
+ */
+static const struct {
+  union {
+    char     name[16];
+    uint64_t word[2];
+  } token;
+  unsigned char size;
+  unsigned char method;
+} methods[] = {
+#define HTTP_METHOD_ENTRY_GEN(n, s) { { s }, sizeof(s) - 1, HTTP_##n },
+  HTTP_METHOD_MAP(HTTP_METHOD_ENTRY_GEN)
+#undef HTTP_METHOD_ENTRY_GEN
+};
+
+static enum http_method
+lookup_method (http_parser *parser)
+{
+  unsigned int i;
+
+  if (parser->method_size > sizeof(methods[0].token.name)) {
+    return HTTP_EXTENSION_METHOD;
+  }
+  for (i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+    if (methods[i].size == parser->method_size &&
+        methods[i].token.word[0] == parser->method_token.word[0] &&
+        methods[i].token.word[1] == parser->method_token.word[1]) {
+      return methods[i].method;
+    }
+  }
+  return HTTP_EXTENSION_METHOD;
+}
+
+#line 1127 "http_parser.rl"
 
 
 
-#line 116 "http_parser.c"
+#line 529 "http_parser.c"
 static const int http_parser_start = 1;
-static const int http_parser_first_final = 266;
+static const int http_parser_first_final = 338;
 static const int http_parser_error = 0;
 
 static const int http_parser_en_ChunkedBody = 2;
-static const int http_parser_en_ChunkedBody_chunk_chunk_end = 12;
-static const int http_parser_en_Requests = 268;
-static const int http_parser_en_Responses = 269;
+static const int http_parser_en_ChunkedBody_chunk_chunk_end = 16;
+static const int http_parser_en_Requests = 340;
+static const int http_parser_en_Responses = 341;
 static const int http_parser_en_main = 1;
 
-#line 416 "http_parser.rl"
+#line 1130 "http_parser.rl"
 
 void
 http_parser_init (http_parser *parser, enum http_parser_type type) 
 {
   int cs = 0;
   
-#line 134 "http_parser.c"
+#line 547 "http_parser.c"
 	{
 	cs = http_parser_start;
 	}
-#line 422 "http_parser.rl"
+#line 1136 "http_parser.rl"
   parser->cs = cs;
   parser->type = type;
   parser->error = 0;
+  parser->http_errno = HPE_OK;
+  parser->error_offset = 0;
 
   parser->data = NULL;
+  parser->router = NULL;
+  parser->route = NULL;
+  parser->header_filter = NULL;
+  parser->header_name = NULL;
+  parser->headers_only = FALSE;
+  parser->reassemble_tokens = FALSE;
+  parser->arena = NULL;
+  parser->headers = NULL;
 
   parser->on_message_begin = NULL;
+  parser->on_extension_method = NULL;
+  parser->on_scheme = NULL;
+  parser->on_host = NULL;
   parser->on_path = NULL;
+  parser->on_route = NULL;
   parser->on_query_string = NULL;
   parser->on_uri = NULL;
   parser->on_fragment = NULL;
   parser->on_header_field = NULL;
   parser->on_header_value = NULL;
   parser->on_headers_complete = NULL;
+  parser->on_chunk_extension = NULL;
+  parser->on_chunk_header = NULL;
+  parser->on_chunk_complete = NULL;
   parser->on_body = NULL;
   parser->on_message_complete = NULL;
+  parser->on_body_range = NULL;
+  parser->on_framing_range = NULL;
+  parser->stream_offset = 0;
+  parser->inplace = FALSE;
+  parser->inplace_begin = parser->inplace_end = NULL;
+
+  http_parser_decode_path(parser, NULL, 0);
+  http_parser_decode_query_string(parser, NULL, 0);
 
   RESET_PARSER(parser);
 }
 
+void
+http_parser_decode_path (http_parser *parser, char *buf, size_t size)
+{
+  parser->path_decoder.buf = buf;
+  parser->path_decoder.size = size;
+  parser->path_decoder.len = 0;
+  parser->path_decoder.state = 0;
+  parser->path_decoder.plus_is_space = FALSE;
+}
+
+void
+http_parser_decode_query_string (http_parser *parser, char *buf, size_t size)
+{
+  parser->query_string_decoder.buf = buf;
+  parser->query_string_decoder.size = size;
+  parser->query_string_decoder.len = 0;
+  parser->query_string_decoder.state = 0;
+  parser->query_string_decoder.plus_is_space = TRUE;
+}
+
 /** exec **/
 size_t
 http_parser_execute (http_parser *parser, const char *buffer, size_t len)
 {
   size_t tmp; // REMOVE ME this is extremely hacky
+  const char *token_at;
+  size_t token_length;
   int callback_return_value = 0;
   const char *p, *pe;
+  const char *eof = NULL; /* the end of a buffer is not the end of the stream */
   int cs = parser->cs;
 
   p = buffer;
   pe = buffer+len;
 
+  if (parser->flags & HTTP_FLAG_UPGRADE) {
+    /* nothing after an upgrade is ours to parse */
+    return 0;
+  }
+
   if (0 < parser->chunk_size && parser->eating) {
     /* eat body */
     SKIP_BODY(MIN(len, parser->chunk_size));
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
   }
 
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    /* all of it is body until http_parser_finish() */
+    if (len > 0) {
+      BODY(p, len);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    parser->body_read += len;
+    parser->stream_offset += len;
+    return len;
+  }
+
   if (parser->header_field_mark)   parser->header_field_mark   = buffer;
   if (parser->header_value_mark)   parser->header_value_mark   = buffer;
   if (parser->fragment_mark)       parser->fragment_mark       = buffer;
   if (parser->query_string_mark)   parser->query_string_mark   = buffer;
   if (parser->path_mark)           parser->path_mark           = buffer;
   if (parser->uri_mark)            parser->uri_mark            = buffer;
+  if (parser->chunk_extension_mark) parser->chunk_extension_mark = buffer;
+  if (parser->scheme_mark)         parser->scheme_mark         = buffer;
+  if (parser->host_mark)           parser->host_mark           = buffer;
 
   
-#line 188 "http_parser.c"
+#line 671 "http_parser.c"
 	{
+	short _widec;
 	if ( p == pe )
 		goto _test_eof;
 	goto _resume;
@@ -193,14 +677,14 @@ http_parser_execute (http_parser *parser, const char *buffer, size_t len)
 _again:
 	switch ( cs ) {
 		case 1: goto st1;
-		case 266: goto st266;
+		case 338: goto st338;
 		case 0: goto st0;
 		case 2: goto st2;
 		case 3: goto st3;
 		case 4: goto st4;
 		case 5: goto st5;
 		case 6: goto st6;
-		case 267: goto st267;
+		case 339: goto st339;
 		case 7: goto st7;
 		case 8: goto st8;
 		case 9: goto st9;
@@ -214,11 +698,11 @@ _again:
 		case 17: goto st17;
 		case 18: goto st18;
 		case 19: goto st19;
-		case 268: goto st268;
 		case 20: goto st20;
 		case 21: goto st21;
 		case 22: goto st22;
 		case 23: goto st23;
+		case 340: goto st340;
 		case 24: goto st24;
 		case 25: goto st25;
 		case 26: goto st26;
@@ -377,7 +861,6 @@ _again:
 		case 179: goto st179;
 		case 180: goto st180;
 		case 181: goto st181;
-		case 269: goto st269;
 		case 182: goto st182;
 		case 183: goto st183;
 		case 184: goto st184;
@@ -395,6 +878,7 @@ _again:
 		case 196: goto st196;
 		case 197: goto st197;
 		case 198: goto st198;
+		case 341: goto st341;
 		case 199: goto st199;
 		case 200: goto st200;
 		case 201: goto st201;
@@ -462,6 +946,78 @@ _again:
 		case 263: goto st263;
 		case 264: goto st264;
 		case 265: goto st265;
+		case 266: goto st266;
+		case 267: goto st267;
+		case 268: goto st268;
+		case 269: goto st269;
+		case 270: goto st270;
+		case 271: goto st271;
+		case 272: goto st272;
+		case 273: goto st273;
+		case 274: goto st274;
+		case 275: goto st275;
+		case 276: goto st276;
+		case 277: goto st277;
+		case 278: goto st278;
+		case 279: goto st279;
+		case 280: goto st280;
+		case 281: goto st281;
+		case 282: goto st282;
+		case 283: goto st283;
+		case 284: goto st284;
+		case 285: goto st285;
+		case 286: goto st286;
+		case 287: goto st287;
+		case 288: goto st288;
+		case 289: goto st289;
+		case 290: goto st290;
+		case 291: goto st291;
+		case 292: goto st292;
+		case 293: goto st293;
+		case 294: goto st294;
+		case 295: goto st295;
+		case 296: goto st296;
+		case 297: goto st297;
+		case 298: goto st298;
+		case 299: goto st299;
+		case 300: goto st300;
+		case 301: goto st301;
+		case 302: goto st302;
+		case 303: goto st303;
+		case 304: goto st304;
+		case 305: goto st305;
+		case 306: goto st306;
+		case 307: goto st307;
+		case 308: goto st308;
+		case 309: goto st309;
+		case 310: goto st310;
+		case 311: goto st311;
+		case 312: goto st312;
+		case 313: goto st313;
+		case 314: goto st314;
+		case 315: goto st315;
+		case 316: goto st316;
+		case 317: goto st317;
+		case 318: goto st318;
+		case 319: goto st319;
+		case 320: goto st320;
+		case 321: goto st321;
+		case 322: goto st322;
+		case 323: goto st323;
+		case 324: goto st324;
+		case 325: goto st325;
+		case 326: goto st326;
+		case 327: goto st327;
+		case 328: goto st328;
+		case 329: goto st329;
+		case 330: goto st330;
+		case 331: goto st331;
+		case 332: goto st332;
+		case 333: goto st333;
+		case 334: goto st334;
+		case 335: goto st335;
+		case 336: goto st336;
+		case 337: goto st337;
 	default: break;
 	}
 
@@ -476,31 +1032,75 @@ st1:
 case 1:
 	goto tr0;
 tr0:
-#line 404 "http_parser.rl"
+#line 1118 "http_parser.rl"
 	{
     p--;
     if (parser->type == HTTP_REQUEST) {
-      {goto st268;}
+      {goto st340;}
     } else {
-      {goto st269;}
+      {goto st341;}
     }
   }
-	goto st266;
-st266:
+	goto st338;
+st338:
 	if ( ++p == pe )
-		goto _test_eof266;
-case 266:
-#line 494 "http_parser.c"
+		goto _test_eof338;
+case 338:
+#line 1050 "http_parser.c"
+	goto st0;
+tr1:
+#line 813 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK_SIZE);     }
+#line 814 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK);          }
+	goto st0;
+tr6:
+#line 814 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK);          }
+	goto st0;
+tr35:
+#line 808 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_METHOD);         }
+	goto st0;
+tr38:
+#line 809 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_URI);            }
+	goto st0;
+tr51:
+#line 810 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_VERSION);        }
+	goto st0;
+tr62:
+#line 812 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_HEADER);         }
 	goto st0;
+tr291:
+#line 811 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_STATUS);         }
+	goto st0;
+#line 1082 "http_parser.c"
 st0:
 cs = 0;
 	goto _out;
+tr26:
+#line 757 "http_parser.rl"
+	{
+    if(parser->on_chunk_complete) {
+      callback_return_value = parser->on_chunk_complete(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+	goto st2;
 st2:
 	if ( ++p == pe )
 		goto _test_eof2;
 case 2:
+#line 1102 "http_parser.c"
 	if ( (*p) == 48 )
-		goto tr1;
+		goto tr2;
 	if ( (*p) < 65 ) {
 		if ( 49 <= (*p) && (*p) <= 57 )
 			goto tr3;
@@ -509,10 +1109,14 @@ case 2:
 			goto tr3;
 	} else
 		goto tr3;
-	goto st0;
-tr1:
-#line 253 "http_parser.rl"
+	goto tr1;
+tr2:
+#line 866 "http_parser.rl"
 	{
+    if (parser->chunk_size > INT_MAX) {
+      SET_ERROR(HPE_CHUNK_SIZE_OVERFLOW);
+      return 0;
+    }
     parser->chunk_size *= 16;
     parser->chunk_size += unhex[(int)*p];
   }
@@ -521,11 +1125,11 @@ st3:
 	if ( ++p == pe )
 		goto _test_eof3;
 case 3:
-#line 525 "http_parser.c"
+#line 1129 "http_parser.c"
 	switch( (*p) ) {
 		case 13: goto st4;
-		case 48: goto tr1;
-		case 59: goto st17;
+		case 48: goto tr2;
+		case 59: goto tr5;
 	}
 	if ( (*p) < 65 ) {
 		if ( 49 <= (*p) && (*p) <= 57 )
@@ -535,74 +1139,129 @@ case 3:
 			goto tr3;
 	} else
 		goto tr3;
-	goto st0;
+	goto tr1;
+tr31:
+#line 737 "http_parser.rl"
+	{
+    CALLBACK(chunk_extension);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->chunk_extension_mark = NULL;
+    parser->chunk_extension_size = 0;
+  }
+	goto st4;
 st4:
 	if ( ++p == pe )
 		goto _test_eof4;
 case 4:
+#line 1160 "http_parser.c"
 	if ( (*p) == 10 )
-		goto st5;
-	goto st0;
+		goto tr7;
+	goto tr6;
+tr7:
+#line 747 "http_parser.rl"
+	{
+    if(parser->on_chunk_header) {
+      callback_return_value = parser->on_chunk_header(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+#line 757 "http_parser.rl"
+	{
+    if(parser->on_chunk_complete) {
+      callback_return_value = parser->on_chunk_complete(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+#line 890 "http_parser.rl"
+	{
+    parser->flags |= HTTP_FLAG_TRAILER;
+  }
+	goto st5;
 st5:
 	if ( ++p == pe )
 		goto _test_eof5;
 case 5:
+#line 1194 "http_parser.c"
 	switch( (*p) ) {
 		case 13: goto st6;
-		case 33: goto st7;
-		case 124: goto st7;
-		case 126: goto st7;
+		case 33: goto tr9;
+		case 124: goto tr9;
+		case 126: goto tr9;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st7;
+				goto tr9;
 		} else if ( (*p) >= 35 )
-			goto st7;
+			goto tr9;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st7;
+				goto tr9;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st7;
+				goto tr9;
 		} else
-			goto st7;
+			goto tr9;
 	} else
-		goto st7;
-	goto st0;
+		goto tr9;
+	goto tr6;
 st6:
 	if ( ++p == pe )
 		goto _test_eof6;
 case 6:
 	if ( (*p) == 10 )
-		goto tr9;
-	goto st0;
-tr9:
-	cs = 267;
-#line 273 "http_parser.rl"
+		goto tr10;
+	goto tr6;
+tr10:
+	cs = 339;
+#line 894 "http_parser.rl"
 	{
+    if (parser->framing) {
+      FRAMING(p + 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
     END_REQUEST;
     if (parser->type == HTTP_REQUEST) {
-      cs = 268;
+      cs = 340;
     } else {
-      cs = 269;
+      cs = 341;
     }
   }
 	goto _again;
-st267:
+st339:
 	if ( ++p == pe )
-		goto _test_eof267;
-case 267:
-#line 598 "http_parser.c"
+		goto _test_eof339;
+case 339:
+#line 1249 "http_parser.c"
 	goto st0;
+tr9:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st7;
 st7:
 	if ( ++p == pe )
 		goto _test_eof7;
 case 7:
+#line 1262 "http_parser.c"
 	switch( (*p) ) {
 		case 33: goto st7;
-		case 58: goto st8;
+		case 58: goto tr12;
 		case 124: goto st7;
 		case 126: goto st7;
 	}
@@ -623,29 +1282,199 @@ case 7:
 			goto st7;
 	} else
 		goto st7;
-	goto st0;
+	goto tr6;
+tr12:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st8;
 st8:
 	if ( ++p == pe )
 		goto _test_eof8;
 case 8:
-	if ( (*p) == 13 )
-		goto st4;
-	goto st8;
-tr3:
-#line 253 "http_parser.rl"
+#line 1324 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr14;
+		case 32: goto st8;
+	}
+	goto tr13;
+tr13:
+#line 558 "http_parser.rl"
 	{
-    parser->chunk_size *= 16;
-    parser->chunk_size += unhex[(int)*p];
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
   }
 	goto st9;
 st9:
 	if ( ++p == pe )
 		goto _test_eof9;
 case 9:
-#line 646 "http_parser.c"
+#line 1341 "http_parser.c"
+	if ( (*p) == 13 )
+		goto tr17;
+	goto st9;
+tr14:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st10;
+tr17:
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st10;
+st10:
+	if ( ++p == pe )
+		goto _test_eof10;
+case 10:
+#line 1398 "http_parser.c"
+	if ( (*p) == 10 )
+		goto st11;
+	goto tr6;
+st11:
+	if ( ++p == pe )
+		goto _test_eof11;
+case 11:
+	switch( (*p) ) {
+		case 9: goto tr19;
+		case 13: goto st6;
+		case 32: goto tr19;
+		case 33: goto tr9;
+		case 124: goto tr9;
+		case 126: goto tr9;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr9;
+		} else if ( (*p) >= 35 )
+			goto tr9;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr9;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr9;
+		} else
+			goto tr9;
+	} else
+		goto tr9;
+	goto tr6;
+tr19:
+#line 833 "http_parser.rl"
+	{
+    if (parser->on_header_value && !parser->skip_header) {
+      callback_return_value = parser->on_header_value(parser, " ", 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add_value(parser->headers, parser->arena, " ", 1) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+  }
+	goto st12;
+st12:
+	if ( ++p == pe )
+		goto _test_eof12;
+case 12:
+#line 1453 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st12;
+		case 13: goto tr14;
+		case 32: goto st12;
+	}
+	goto tr13;
+tr3:
+#line 866 "http_parser.rl"
+	{
+    if (parser->chunk_size > INT_MAX) {
+      SET_ERROR(HPE_CHUNK_SIZE_OVERFLOW);
+      return 0;
+    }
+    parser->chunk_size *= 16;
+    parser->chunk_size += unhex[(int)*p];
+  }
+	goto st13;
+st13:
+	if ( ++p == pe )
+		goto _test_eof13;
+case 13:
+#line 1475 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto st10;
-		case 59: goto st14;
+		case 13: goto st14;
+		case 59: goto tr22;
 	}
 	if ( (*p) < 65 ) {
 		if ( 48 <= (*p) && (*p) <= 57 )
@@ -655,247 +1484,358 @@ case 9:
 			goto tr3;
 	} else
 		goto tr3;
-	goto st0;
-st10:
+	goto tr1;
+tr27:
+#line 737 "http_parser.rl"
+	{
+    CALLBACK(chunk_extension);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->chunk_extension_mark = NULL;
+    parser->chunk_extension_size = 0;
+  }
+	goto st14;
+st14:
 	if ( ++p == pe )
-		goto _test_eof10;
-case 10:
+		goto _test_eof14;
+case 14:
+#line 1505 "http_parser.c"
 	if ( (*p) == 10 )
-		goto st11;
-	goto st0;
-st11:
+		goto tr23;
+	goto tr6;
+tr23:
+#line 747 "http_parser.rl"
+	{
+    if(parser->on_chunk_header) {
+      callback_return_value = parser->on_chunk_header(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+	goto st15;
+st15:
 	if ( ++p == pe )
-		goto _test_eof11;
-case 11:
-	goto tr14;
-tr14:
-#line 258 "http_parser.rl"
+		goto _test_eof15;
+case 15:
+#line 1525 "http_parser.c"
+	goto tr24;
+tr24:
+#line 875 "http_parser.rl"
 	{
     SKIP_BODY(MIN(parser->chunk_size, REMAINING));
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
 
     p--; 
     if (parser->chunk_size > REMAINING) {
-      {p++; cs = 12; goto _out;}
+      {p++; cs = 16; goto _out;}
     } else {
-      {goto st12;} 
+      {goto st16;} 
     }
   }
-	goto st12;
-st12:
+	goto st16;
+st16:
 	if ( ++p == pe )
-		goto _test_eof12;
-case 12:
-#line 693 "http_parser.c"
+		goto _test_eof16;
+case 16:
+#line 1548 "http_parser.c"
 	if ( (*p) == 13 )
-		goto st13;
-	goto st0;
-st13:
+		goto st17;
+	goto tr6;
+st17:
 	if ( ++p == pe )
-		goto _test_eof13;
-case 13:
+		goto _test_eof17;
+case 17:
 	if ( (*p) == 10 )
-		goto st2;
-	goto st0;
-st14:
+		goto tr26;
+	goto tr6;
+tr22:
+#line 584 "http_parser.rl"
+	{
+    parser->chunk_extension_mark = p;
+    parser->chunk_extension_size = 0;
+  }
+	goto st18;
+st18:
 	if ( ++p == pe )
-		goto _test_eof14;
-case 14:
+		goto _test_eof18;
+case 18:
+#line 1570 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto st10;
-		case 32: goto st14;
-		case 33: goto st15;
-		case 59: goto st14;
-		case 61: goto st16;
-		case 124: goto st15;
-		case 126: goto st15;
+		case 13: goto tr27;
+		case 32: goto st18;
+		case 33: goto st19;
+		case 59: goto st18;
+		case 61: goto st20;
+		case 124: goto st19;
+		case 126: goto st19;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st15;
+				goto st19;
 		} else if ( (*p) >= 35 )
-			goto st15;
+			goto st19;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st15;
+				goto st19;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st15;
+				goto st19;
 		} else
-			goto st15;
+			goto st19;
 	} else
-		goto st15;
-	goto st0;
-st15:
+		goto st19;
+	goto tr6;
+st19:
 	if ( ++p == pe )
-		goto _test_eof15;
-case 15:
+		goto _test_eof19;
+case 19:
 	switch( (*p) ) {
-		case 13: goto st10;
-		case 33: goto st15;
-		case 59: goto st14;
-		case 61: goto st16;
-		case 124: goto st15;
-		case 126: goto st15;
+		case 13: goto tr27;
+		case 33: goto st19;
+		case 59: goto st18;
+		case 61: goto st20;
+		case 124: goto st19;
+		case 126: goto st19;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st15;
+				goto st19;
 		} else if ( (*p) >= 35 )
-			goto st15;
+			goto st19;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st15;
+				goto st19;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st15;
+				goto st19;
 		} else
-			goto st15;
+			goto st19;
 	} else
-		goto st15;
-	goto st0;
-st16:
+		goto st19;
+	goto tr6;
+st20:
 	if ( ++p == pe )
-		goto _test_eof16;
-case 16:
+		goto _test_eof20;
+case 20:
 	switch( (*p) ) {
-		case 13: goto st10;
-		case 33: goto st16;
-		case 59: goto st14;
-		case 124: goto st16;
-		case 126: goto st16;
+		case 13: goto tr27;
+		case 33: goto st20;
+		case 59: goto st18;
+		case 124: goto st20;
+		case 126: goto st20;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st16;
+				goto st20;
 		} else if ( (*p) >= 35 )
-			goto st16;
+			goto st20;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st16;
+				goto st20;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st16;
+				goto st20;
 		} else
-			goto st16;
+			goto st20;
 	} else
-		goto st16;
-	goto st0;
-st17:
+		goto st20;
+	goto tr6;
+tr5:
+#line 584 "http_parser.rl"
+	{
+    parser->chunk_extension_mark = p;
+    parser->chunk_extension_size = 0;
+  }
+	goto st21;
+st21:
 	if ( ++p == pe )
-		goto _test_eof17;
-case 17:
+		goto _test_eof21;
+case 21:
+#line 1668 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto st4;
-		case 32: goto st17;
-		case 33: goto st18;
-		case 59: goto st17;
-		case 61: goto st19;
-		case 124: goto st18;
-		case 126: goto st18;
+		case 13: goto tr31;
+		case 32: goto st21;
+		case 33: goto st22;
+		case 59: goto st21;
+		case 61: goto st23;
+		case 124: goto st22;
+		case 126: goto st22;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st18;
+				goto st22;
 		} else if ( (*p) >= 35 )
-			goto st18;
+			goto st22;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st18;
+				goto st22;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st18;
+				goto st22;
 		} else
-			goto st18;
+			goto st22;
 	} else
-		goto st18;
-	goto st0;
-st18:
+		goto st22;
+	goto tr6;
+st22:
 	if ( ++p == pe )
-		goto _test_eof18;
-case 18:
+		goto _test_eof22;
+case 22:
 	switch( (*p) ) {
-		case 13: goto st4;
-		case 33: goto st18;
-		case 59: goto st17;
-		case 61: goto st19;
-		case 124: goto st18;
-		case 126: goto st18;
+		case 13: goto tr31;
+		case 33: goto st22;
+		case 59: goto st21;
+		case 61: goto st23;
+		case 124: goto st22;
+		case 126: goto st22;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st18;
+				goto st22;
 		} else if ( (*p) >= 35 )
-			goto st18;
+			goto st22;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st18;
+				goto st22;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st18;
+				goto st22;
 		} else
-			goto st18;
+			goto st22;
 	} else
-		goto st18;
-	goto st0;
-st19:
+		goto st22;
+	goto tr6;
+st23:
 	if ( ++p == pe )
-		goto _test_eof19;
-case 19:
+		goto _test_eof23;
+case 23:
 	switch( (*p) ) {
-		case 13: goto st4;
-		case 33: goto st19;
-		case 59: goto st17;
-		case 124: goto st19;
-		case 126: goto st19;
+		case 13: goto tr31;
+		case 33: goto st23;
+		case 59: goto st21;
+		case 124: goto st23;
+		case 126: goto st23;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st19;
+				goto st23;
 		} else if ( (*p) >= 35 )
-			goto st19;
+			goto st23;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st19;
+				goto st23;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st19;
+				goto st23;
 		} else
-			goto st19;
+			goto st23;
 	} else
-		goto st19;
-	goto st0;
-tr45:
-	cs = 268;
-#line 203 "http_parser.rl"
+		goto st23;
+	goto tr6;
+tr69:
+	cs = 340;
+#line 767 "http_parser.rl"
 	{
+    if (parser->type == HTTP_REQUEST && parser->flags & HTTP_FLAG_UNCHUNKED) {
+      /* there is no telling where the body ends, RFC 7230 3.3.3 */
+      SET_ERROR(HPE_INVALID_TRANSFER_ENCODING);
+      return 0;
+    }
     if(parser->on_headers_complete) {
       callback_return_value = parser->on_headers_complete(parser);
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
     }
   }
-#line 282 "http_parser.rl"
+#line 910 "http_parser.rl"
 	{
-    if (parser->transfer_encoding == HTTP_CHUNKED) {
+    if ((parser->type == HTTP_REQUEST && 
+         (parser->method == HTTP_CONNECT || 
+          (parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+           parser->flags & HTTP_FLAG_UPGRADE_HEADER))) ||
+        (parser->type == HTTP_RESPONSE &&
+         parser->status_code == 101 && 
+         parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+         parser->flags & HTTP_FLAG_UPGRADE_HEADER)) {
+      /* the rest of the stream is another protocol, stop right after the
+       * headers and leave it to the caller */
+      parser->flags |= HTTP_FLAG_UPGRADE;
+      if (parser->on_message_complete) {
+        callback_return_value = parser->on_message_complete(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      {p++; goto _out;}
+    } else if (parser->flags & HTTP_FLAG_SKIP_BODY || 
+        (parser->type == HTTP_RESPONSE &&
+         (parser->status_code / 100 == 1 || 
+          parser->status_code == 204 || 
+          parser->status_code == 304))) {
+      /* no body whatever the headers say, go straight to the next message */
+      END_REQUEST;
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    } else if (parser->headers_only &&
+               (parser->transfer_encoding == HTTP_CHUNKED ||
+                parser->content_length > 0 ||
+                (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE))) {
+      /* stop at the start of the body, the caller takes it from here */
+      parser->flags |= HTTP_FLAG_BODY_PENDING;
+      if (parser->transfer_encoding == HTTP_CHUNKED) {
+        parser->framing = TRUE;
+        parser->framing_offset = STREAM_OFFSET(p + 1);
+        cs = 2;
+      } else if (UNFRAMED_RESPONSE) {
+        parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      } else {
+        parser->chunk_size = parser->content_length;
+        parser->eating = TRUE;
+      }
+      {p++; goto _out;}
+    } else if (parser->transfer_encoding == HTTP_CHUNKED) {
+      parser->framing = TRUE;
+      parser->framing_offset = STREAM_OFFSET(p + 1);
       cs = 2;
+    } else if (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE) {
+      /* no framing, everything up to the connection closing is body */
+      parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      p += 1;
+      if (REMAINING > 0) {
+        BODY(p, REMAINING);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      parser->body_read += REMAINING;
+      p = pe;
+      p--;
+      {p++; goto _out;}
     } else {
       /* this is pretty stupid. i'd prefer to combine this with skip_chunk_data */
       parser->chunk_size = parser->content_length;
@@ -904,7 +1844,7 @@ tr45:
       SKIP_BODY(MIN(REMAINING, parser->content_length));
 
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
 
@@ -915,4857 +1855,11416 @@ tr45:
     }
   }
 	goto _again;
-st268:
+st340:
 	if ( ++p == pe )
-		goto _test_eof268;
-case 268:
-#line 923 "http_parser.c"
-	switch( (*p) ) {
-		case 67: goto tr310;
-		case 68: goto tr311;
-		case 71: goto tr312;
-		case 72: goto tr313;
-		case 76: goto tr314;
-		case 77: goto tr315;
-		case 79: goto tr316;
-		case 80: goto tr317;
-		case 84: goto tr318;
-		case 85: goto tr319;
+		goto _test_eof340;
+case 340:
+#line 1863 "http_parser.c"
+	switch( (*p) ) {
+		case 33: goto tr459;
+		case 124: goto tr459;
+		case 126: goto tr459;
 	}
-	goto st0;
-tr310:
-#line 213 "http_parser.rl"
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr459;
+		} else if ( (*p) >= 35 )
+			goto tr459;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr459;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr459;
+		} else
+			goto tr459;
+	} else
+		goto tr459;
+	goto tr35;
+tr37:
+#line 533 "http_parser.rl"
+	{
+    if (parser->method_size == HTTP_MAX_METHOD_SIZE) {
+      SET_ERROR(HPE_INVALID_METHOD);
+      return 0;
+    }
+    parser->method_token.buf[parser->method_size++] = *p;
+  }
+	goto st24;
+tr459:
+#line 782 "http_parser.rl"
 	{
+    parser->flags |= HTTP_FLAG_IN_MESSAGE;
     if(parser->on_message_begin) {
       callback_return_value = parser->on_message_begin(parser);
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
     }
   }
-	goto st20;
-st20:
-	if ( ++p == pe )
-		goto _test_eof20;
-case 20:
-#line 953 "http_parser.c"
-	if ( (*p) == 79 )
-		goto st21;
-	goto st0;
-st21:
-	if ( ++p == pe )
-		goto _test_eof21;
-case 21:
-	if ( (*p) == 80 )
-		goto st22;
-	goto st0;
-st22:
-	if ( ++p == pe )
-		goto _test_eof22;
-case 22:
-	if ( (*p) == 89 )
-		goto st23;
-	goto st0;
-st23:
-	if ( ++p == pe )
-		goto _test_eof23;
-case 23:
-	if ( (*p) == 32 )
-		goto tr24;
-	goto st0;
-tr24:
-#line 329 "http_parser.rl"
-	{ parser->method = HTTP_COPY;      }
-	goto st24;
-tr154:
-#line 330 "http_parser.rl"
-	{ parser->method = HTTP_DELETE;    }
-	goto st24;
-tr157:
-#line 331 "http_parser.rl"
-	{ parser->method = HTTP_GET;       }
-	goto st24;
-tr161:
-#line 332 "http_parser.rl"
-	{ parser->method = HTTP_HEAD;      }
-	goto st24;
-tr165:
-#line 333 "http_parser.rl"
-	{ parser->method = HTTP_LOCK;      }
-	goto st24;
-tr171:
-#line 334 "http_parser.rl"
-	{ parser->method = HTTP_MKCOL;     }
-	goto st24;
-tr174:
-#line 335 "http_parser.rl"
-	{ parser->method = HTTP_MOVE;      }
-	goto st24;
-tr181:
-#line 336 "http_parser.rl"
-	{ parser->method = HTTP_OPTIONS;   }
-	goto st24;
-tr187:
-#line 337 "http_parser.rl"
-	{ parser->method = HTTP_POST;      }
-	goto st24;
-tr195:
-#line 338 "http_parser.rl"
-	{ parser->method = HTTP_PROPFIND;  }
-	goto st24;
-tr200:
-#line 339 "http_parser.rl"
-	{ parser->method = HTTP_PROPPATCH; }
-	goto st24;
-tr202:
-#line 340 "http_parser.rl"
-	{ parser->method = HTTP_PUT;       }
-	goto st24;
-tr207:
-#line 341 "http_parser.rl"
-	{ parser->method = HTTP_TRACE;     }
-	goto st24;
-tr213:
-#line 342 "http_parser.rl"
-	{ parser->method = HTTP_UNLOCK;    }
-	goto st24;
-st24:
+#line 526 "http_parser.rl"
+	{
+    parser->method_token.word[0] = 0;
+    parser->method_token.word[1] = 0;
+    parser->method_token.word[2] = 0;
+    parser->method_size = 0;
+  }
+#line 533 "http_parser.rl"
+	{
+    if (parser->method_size == HTTP_MAX_METHOD_SIZE) {
+      SET_ERROR(HPE_INVALID_METHOD);
+      return 0;
+    }
+    parser->method_token.buf[parser->method_size++] = *p;
+  }
+	goto st24;
+st24:
 	if ( ++p == pe )
 		goto _test_eof24;
 case 24:
-#line 1038 "http_parser.c"
+#line 1929 "http_parser.c"
 	switch( (*p) ) {
-		case 42: goto tr25;
-		case 43: goto tr26;
-		case 47: goto tr27;
-		case 58: goto tr28;
+		case 32: goto tr36;
+		case 33: goto tr37;
+		case 124: goto tr37;
+		case 126: goto tr37;
 	}
-	if ( (*p) < 65 ) {
-		if ( 45 <= (*p) && (*p) <= 57 )
-			goto tr26;
-	} else if ( (*p) > 90 ) {
-		if ( 97 <= (*p) && (*p) <= 122 )
-			goto tr26;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr37;
+		} else if ( (*p) >= 35 )
+			goto tr37;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr37;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr37;
+		} else
+			goto tr37;
 	} else
-		goto tr26;
-	goto st0;
-tr25:
-#line 138 "http_parser.rl"
+		goto tr37;
+	goto tr35;
+tr36:
+#line 541 "http_parser.rl"
 	{
-    parser->uri_mark = p;
-    parser->uri_size = 0;
+    parser->method = lookup_method(parser);
+    if (parser->method == HTTP_EXTENSION_METHOD && parser->on_extension_method) {
+      callback_return_value = parser->on_extension_method(parser,
+        parser->method_token.buf, parser->method_size);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
   }
 	goto st25;
 st25:
 	if ( ++p == pe )
 		goto _test_eof25;
 case 25:
-#line 1065 "http_parser.c"
+#line 1972 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 47 ) {
+		if ( (*p) < 39 ) {
+			if ( (*p) < 33 ) {
+				if ( (*p) <= -1 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) > 33 ) {
+				if ( 36 <= (*p) && (*p) <= 37 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 42 ) {
+			if ( (*p) < 44 ) {
+				if ( 43 <= (*p) && (*p) <= 43 ) {
+					_widec = (short)(640 + ((*p) - -128));
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) > 44 ) {
+				if ( 45 <= (*p) && (*p) <= 46 ) {
+					_widec = (short)(1152 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+				}
+			} else {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 47 ) {
+		if ( (*p) < 91 ) {
+			if ( (*p) < 58 ) {
+				if ( 48 <= (*p) && (*p) <= 57 ) {
+					_widec = (short)(1152 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+				}
+			} else if ( (*p) > 58 ) {
+				if ( 65 <= (*p) && (*p) <= 90 ) {
+					_widec = (short)(1152 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+				}
+			} else {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 92 ) {
+			if ( (*p) < 97 ) {
+				if ( 94 <= (*p) && (*p) <= 96 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) > 122 ) {
+				if ( 123 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else {
+				_widec = (short)(1152 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 289: goto tr38;
+		case 298: goto tr40;
+		case 300: goto tr38;
+		case 545: goto tr41;
+		case 548: goto tr41;
+		case 549: goto tr42;
+		case 554: goto tr43;
+		case 556: goto tr41;
+		case 603: goto tr44;
+		case 604: goto tr41;
+		case 811: goto tr38;
+		case 815: goto tr38;
+		case 826: goto tr38;
+		case 1067: goto tr45;
+		case 1071: goto tr46;
+		case 1082: goto tr47;
+	}
+	if ( _widec < 1345 ) {
+		if ( _widec < 379 ) {
+			if ( _widec < 295 ) {
+				if ( _widec > 255 ) {
+					if ( 292 <= _widec && _widec <= 293 )
+						goto tr38;
+				} else
+					goto tr38;
+			} else if ( _widec > 297 ) {
+				if ( _widec > 348 ) {
+					if ( 350 <= _widec && _widec <= 352 )
+						goto tr38;
+				} else if ( _widec >= 347 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 382 ) {
+			if ( _widec < 606 ) {
+				if ( _widec > 511 ) {
+					if ( 551 <= _widec && _widec <= 553 )
+						goto tr41;
+				} else if ( _widec >= 384 )
+					goto tr41;
+			} else if ( _widec > 608 ) {
+				if ( _widec < 1325 ) {
+					if ( 635 <= _widec && _widec <= 638 )
+						goto tr41;
+				} else if ( _widec > 1326 ) {
+					if ( 1328 <= _widec && _widec <= 1337 )
+						goto tr38;
+				} else
+					goto tr38;
+			} else
+				goto tr41;
+		} else
+			goto tr38;
+	} else if ( _widec > 1370 ) {
+		if ( _widec < 1840 ) {
+			if ( _widec < 1584 ) {
+				if ( _widec > 1402 ) {
+					if ( 1581 <= _widec && _widec <= 1582 )
+						goto tr41;
+				} else if ( _widec >= 1377 )
+					goto tr38;
+			} else if ( _widec > 1593 ) {
+				if ( _widec < 1633 ) {
+					if ( 1601 <= _widec && _widec <= 1626 )
+						goto tr41;
+				} else if ( _widec > 1658 ) {
+					if ( 1837 <= _widec && _widec <= 1838 )
+						goto tr45;
+				} else
+					goto tr41;
+			} else
+				goto tr41;
+		} else if ( _widec > 1849 ) {
+			if ( _widec < 2093 ) {
+				if ( _widec > 1882 ) {
+					if ( 1889 <= _widec && _widec <= 1914 )
+						goto tr45;
+				} else if ( _widec >= 1857 )
+					goto tr45;
+			} else if ( _widec > 2094 ) {
+				if ( _widec < 2113 ) {
+					if ( 2096 <= _widec && _widec <= 2105 )
+						goto tr48;
+				} else if ( _widec > 2138 ) {
+					if ( 2145 <= _widec && _widec <= 2170 )
+						goto tr48;
+				} else
+					goto tr48;
+			} else
+				goto tr48;
+		} else
+			goto tr45;
+	} else
+		goto tr38;
+	goto st0;
+tr40:
+#line 579 "http_parser.rl"
+	{
+    parser->uri_mark = p;
+    parser->uri_size = 0;
+  }
+	goto st26;
+st26:
+	if ( ++p == pe )
+		goto _test_eof26;
+case 26:
+#line 2197 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr29;
-		case 35: goto tr30;
+		case 32: goto tr49;
+		case 35: goto tr50;
 	}
-	goto st0;
-tr29:
-#line 163 "http_parser.rl"
+	goto tr38;
+tr49:
+#line 650 "http_parser.rl"
 	{ 
     CALLBACK(uri);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->uri_mark = NULL;
     parser->uri_size = 0;
   }
-	goto st26;
-tr124:
-#line 123 "http_parser.rl"
+	goto st27;
+tr225:
+#line 563 "http_parser.rl"
 	{
     parser->fragment_mark = p;
     parser->fragment_size = 0;
   }
-#line 173 "http_parser.rl"
+#line 660 "http_parser.rl"
 	{ 
     CALLBACK(fragment);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->fragment_mark = NULL;
     parser->fragment_size = 0;
   }
-	goto st26;
-tr127:
-#line 173 "http_parser.rl"
+	goto st27;
+tr228:
+#line 660 "http_parser.rl"
 	{ 
     CALLBACK(fragment);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->fragment_mark = NULL;
     parser->fragment_size = 0;
   }
-	goto st26;
-tr135:
-#line 193 "http_parser.rl"
+	goto st27;
+tr250:
+#line 714 "http_parser.rl"
 	{
-    CALLBACK(path);
+    CALLBACK(host);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
+  }
+	goto st27;
+tr258:
+#line 681 "http_parser.rl"
+	{
+    DECODE(path);
+    ROUTE;
+    TOKEN_CALLBACK(path);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->path_mark = NULL;
     parser->path_size = 0;
+
+    if (parser->router) {
+      http_route_finish(parser->route);
+      if (parser->on_route) {
+        callback_return_value = parser->on_route(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+    }
   }
-#line 163 "http_parser.rl"
+#line 650 "http_parser.rl"
 	{ 
     CALLBACK(uri);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->uri_mark = NULL;
     parser->uri_size = 0;
   }
-	goto st26;
-tr141:
-#line 128 "http_parser.rl"
+	goto st27;
+tr264:
+#line 568 "http_parser.rl"
 	{
     parser->query_string_mark = p;
     parser->query_string_size = 0;
   }
-#line 183 "http_parser.rl"
+#line 670 "http_parser.rl"
 	{ 
+    DECODE(query_string);
     CALLBACK(query_string);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->query_string_mark = NULL;
     parser->query_string_size = 0;
   }
-#line 163 "http_parser.rl"
+#line 650 "http_parser.rl"
 	{ 
     CALLBACK(uri);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->uri_mark = NULL;
     parser->uri_size = 0;
   }
-	goto st26;
-tr145:
-#line 183 "http_parser.rl"
+	goto st27;
+tr268:
+#line 670 "http_parser.rl"
 	{ 
+    DECODE(query_string);
     CALLBACK(query_string);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->query_string_mark = NULL;
     parser->query_string_size = 0;
   }
-#line 163 "http_parser.rl"
+#line 650 "http_parser.rl"
 	{ 
     CALLBACK(uri);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->uri_mark = NULL;
     parser->uri_size = 0;
   }
-	goto st26;
-st26:
-	if ( ++p == pe )
-		goto _test_eof26;
-case 26:
-#line 1187 "http_parser.c"
-	if ( (*p) == 72 )
-		goto st27;
-	goto st0;
+	goto st27;
 st27:
 	if ( ++p == pe )
 		goto _test_eof27;
 case 27:
-	if ( (*p) == 84 )
+#line 2356 "http_parser.c"
+	if ( (*p) == 72 )
 		goto st28;
-	goto st0;
+	goto tr51;
 st28:
 	if ( ++p == pe )
 		goto _test_eof28;
 case 28:
 	if ( (*p) == 84 )
 		goto st29;
-	goto st0;
+	goto tr51;
 st29:
 	if ( ++p == pe )
 		goto _test_eof29;
 case 29:
-	if ( (*p) == 80 )
+	if ( (*p) == 84 )
 		goto st30;
-	goto st0;
+	goto tr51;
 st30:
 	if ( ++p == pe )
 		goto _test_eof30;
 case 30:
-	if ( (*p) == 47 )
+	if ( (*p) == 80 )
 		goto st31;
-	goto st0;
+	goto tr51;
 st31:
 	if ( ++p == pe )
 		goto _test_eof31;
 case 31:
+	if ( (*p) == 47 )
+		goto st32;
+	goto tr51;
+st32:
+	if ( ++p == pe )
+		goto _test_eof32;
+case 32:
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr36;
-	goto st0;
-tr36:
-#line 243 "http_parser.rl"
+		goto tr57;
+	goto tr51;
+tr57:
+#line 848 "http_parser.rl"
 	{
+    if (parser->version_major > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
+      return 0;
+    }
     parser->version_major *= 10;
     parser->version_major += *p - '0';
   }
-	goto st32;
-st32:
-	if ( ++p == pe )
-		goto _test_eof32;
-case 32:
-#line 1237 "http_parser.c"
-	if ( (*p) == 46 )
-		goto st33;
-	goto st0;
+	goto st33;
 st33:
 	if ( ++p == pe )
 		goto _test_eof33;
 case 33:
+#line 2410 "http_parser.c"
+	if ( (*p) == 46 )
+		goto st34;
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr38;
-	goto st0;
-tr38:
-#line 248 "http_parser.rl"
-	{
-    parser->version_minor *= 10;
-    parser->version_minor += *p - '0';
-  }
-	goto st34;
+		goto tr57;
+	goto tr51;
 st34:
 	if ( ++p == pe )
 		goto _test_eof34;
 case 34:
-#line 1259 "http_parser.c"
-	if ( (*p) == 13 )
-		goto st35;
-	goto st0;
-tr49:
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
-#line 153 "http_parser.rl"
-	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
-  }
-	goto st35;
-tr52:
-#line 153 "http_parser.rl"
-	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
-  }
-	goto st35;
-tr71:
-#line 241 "http_parser.rl"
-	{ parser->keep_alive = FALSE; }
-#line 153 "http_parser.rl"
-	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
-  }
-	goto st35;
-tr81:
-#line 240 "http_parser.rl"
-	{ parser->keep_alive = TRUE; }
-#line 153 "http_parser.rl"
-	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
-  }
-	goto st35;
-tr122:
-#line 237 "http_parser.rl"
-	{ parser->transfer_encoding = HTTP_IDENTITY; }
-#line 153 "http_parser.rl"
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr59;
+	goto tr51;
+tr59:
+#line 857 "http_parser.rl"
 	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
+    if (parser->version_minor > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
       return 0;
     }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->version_minor *= 10;
+    parser->version_minor += *p - '0';
   }
 	goto st35;
 st35:
 	if ( ++p == pe )
 		goto _test_eof35;
 case 35:
-#line 1338 "http_parser.c"
-	if ( (*p) == 10 )
+#line 2438 "http_parser.c"
+	if ( (*p) == 13 )
 		goto st36;
-	goto st0;
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr59;
+	goto tr51;
 st36:
 	if ( ++p == pe )
 		goto _test_eof36;
 case 36:
+	if ( (*p) == 10 )
+		goto st37;
+	goto st0;
+st37:
+	if ( ++p == pe )
+		goto _test_eof37;
+case 37:
 	switch( (*p) ) {
-		case 13: goto st37;
-		case 33: goto tr42;
-		case 67: goto tr43;
-		case 84: goto tr44;
-		case 99: goto tr43;
-		case 116: goto tr44;
-		case 124: goto tr42;
-		case 126: goto tr42;
+		case 13: goto st38;
+		case 33: goto tr64;
+		case 67: goto tr65;
+		case 69: goto tr66;
+		case 84: goto tr67;
+		case 85: goto tr68;
+		case 99: goto tr65;
+		case 101: goto tr66;
+		case 116: goto tr67;
+		case 117: goto tr68;
+		case 124: goto tr64;
+		case 126: goto tr64;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto tr42;
+				goto tr64;
 		} else if ( (*p) >= 35 )
-			goto tr42;
+			goto tr64;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto tr42;
+				goto tr64;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto tr42;
+				goto tr64;
 		} else
-			goto tr42;
+			goto tr64;
 	} else
-		goto tr42;
-	goto st0;
-st37:
+		goto tr64;
+	goto tr62;
+st38:
 	if ( ++p == pe )
-		goto _test_eof37;
-case 37:
+		goto _test_eof38;
+case 38:
 	if ( (*p) == 10 )
-		goto tr45;
-	goto st0;
-tr42:
-#line 113 "http_parser.rl"
+		goto tr69;
+	goto tr62;
+tr64:
+#line 553 "http_parser.rl"
 	{
     parser->header_field_mark = p;
     parser->header_field_size = 0;
   }
-	goto st38;
-st38:
+	goto st39;
+st39:
 	if ( ++p == pe )
-		goto _test_eof38;
-case 38:
-#line 1392 "http_parser.c"
+		goto _test_eof39;
+case 39:
+#line 2505 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-tr47:
-#line 143 "http_parser.rl"
+		goto st39;
+	goto tr62;
+tr71:
+#line 599 "http_parser.rl"
 	{
-    CALLBACK(header_field);
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
       return 0;
     }
     parser->header_field_mark = NULL;
     parser->header_field_size = 0;
-  }
-	goto st39;
-st39:
-	if ( ++p == pe )
-		goto _test_eof39;
-case 39:
-#line 1433 "http_parser.c"
-	switch( (*p) ) {
-		case 13: goto tr49;
-		case 32: goto st39;
-	}
-	goto tr48;
-tr48:
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
   }
 	goto st40;
 st40:
 	if ( ++p == pe )
 		goto _test_eof40;
 case 40:
-#line 1450 "http_parser.c"
-	if ( (*p) == 13 )
-		goto tr52;
-	goto st40;
-tr43:
-#line 113 "http_parser.rl"
+#line 2567 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr73;
+		case 32: goto st40;
+	}
+	goto tr72;
+tr72:
+#line 558 "http_parser.rl"
 	{
-    parser->header_field_mark = p;
-    parser->header_field_size = 0;
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
   }
 	goto st41;
 st41:
 	if ( ++p == pe )
 		goto _test_eof41;
 case 41:
-#line 1465 "http_parser.c"
-	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 79: goto st42;
-		case 111: goto st42;
-		case 124: goto st38;
-		case 126: goto st38;
-	}
-	if ( (*p) < 45 ) {
-		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
-		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
-			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
-	} else
-		goto st38;
-	goto st0;
+#line 2584 "http_parser.c"
+	if ( (*p) == 13 )
+		goto tr76;
+	goto st41;
+tr73:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr76:
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr107:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr119:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr128:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr163:
+#line 830 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_EXPECT_CONTINUE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr186:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr200:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
+tr219:
+#line 829 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_UPGRADE_HEADER; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st42;
 st42:
 	if ( ++p == pe )
 		goto _test_eof42;
 case 42:
-	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st43;
-		case 110: goto st43;
-		case 124: goto st38;
-		case 126: goto st38;
-	}
-	if ( (*p) < 45 ) {
-		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
-		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
-			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
-	} else
-		goto st38;
-	goto st0;
+#line 2815 "http_parser.c"
+	if ( (*p) == 10 )
+		goto st43;
+	goto tr62;
 st43:
 	if ( ++p == pe )
 		goto _test_eof43;
 case 43:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st44;
-		case 84: goto st67;
-		case 110: goto st44;
-		case 116: goto st67;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto tr78;
+		case 13: goto st38;
+		case 32: goto tr78;
+		case 33: goto tr64;
+		case 67: goto tr65;
+		case 69: goto tr66;
+		case 84: goto tr67;
+		case 85: goto tr68;
+		case 99: goto tr65;
+		case 101: goto tr66;
+		case 116: goto tr67;
+		case 117: goto tr68;
+		case 124: goto tr64;
+		case 126: goto tr64;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto tr64;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto tr64;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto tr64;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto tr64;
 		} else
-			goto st38;
+			goto tr64;
 	} else
-		goto st38;
-	goto st0;
+		goto tr64;
+	goto tr62;
+tr78:
+#line 833 "http_parser.rl"
+	{
+    if (parser->on_header_value && !parser->skip_header) {
+      callback_return_value = parser->on_header_value(parser, " ", 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add_value(parser->headers, parser->arena, " ", 1) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+  }
+	goto st44;
 st44:
 	if ( ++p == pe )
 		goto _test_eof44;
 case 44:
+#line 2878 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 69: goto st45;
-		case 101: goto st45;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st44;
+		case 13: goto tr73;
+		case 32: goto st44;
 	}
-	if ( (*p) < 45 ) {
-		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
-		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
-			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
-	} else
-		goto st38;
-	goto st0;
+	goto tr72;
+tr65:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st45;
 st45:
 	if ( ++p == pe )
 		goto _test_eof45;
 case 45:
+#line 2896 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 67: goto st46;
-		case 99: goto st46;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 79: goto st46;
+		case 111: goto st46;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st46:
 	if ( ++p == pe )
 		goto _test_eof46;
 case 46:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 84: goto st47;
-		case 116: goto st47;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st47;
+		case 110: goto st47;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st47:
 	if ( ++p == pe )
 		goto _test_eof47;
 case 47:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 73: goto st48;
-		case 105: goto st48;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st48;
+		case 84: goto st81;
+		case 110: goto st48;
+		case 116: goto st81;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st48:
 	if ( ++p == pe )
 		goto _test_eof48;
 case 48:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 79: goto st49;
-		case 111: goto st49;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st49;
+		case 101: goto st49;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st49:
 	if ( ++p == pe )
 		goto _test_eof49;
 case 49:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st50;
-		case 110: goto st50;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 67: goto st50;
+		case 99: goto st50;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st50:
 	if ( ++p == pe )
 		goto _test_eof50;
 case 50:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr63;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 84: goto st51;
+		case 116: goto st51;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-tr63:
-#line 143 "http_parser.rl"
-	{
-    CALLBACK(header_field);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_field_mark = NULL;
-    parser->header_field_size = 0;
-  }
-	goto st51;
+		goto st39;
+	goto tr62;
 st51:
 	if ( ++p == pe )
 		goto _test_eof51;
 case 51:
-#line 1778 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr49;
-		case 32: goto st51;
-		case 67: goto tr65;
-		case 75: goto tr66;
-		case 99: goto tr65;
-		case 107: goto tr66;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 73: goto st52;
+		case 105: goto st52;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	goto tr48;
-tr65:
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
-	goto st52;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st52:
 	if ( ++p == pe )
 		goto _test_eof52;
 case 52:
-#line 1799 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 76: goto st53;
-		case 108: goto st53;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 79: goto st53;
+		case 111: goto st53;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	goto st40;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st53:
 	if ( ++p == pe )
 		goto _test_eof53;
 case 53:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 79: goto st54;
-		case 111: goto st54;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st54;
+		case 110: goto st54;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	goto st40;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st54:
 	if ( ++p == pe )
 		goto _test_eof54;
 case 54:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 83: goto st55;
-		case 115: goto st55;
+		case 33: goto st39;
+		case 58: goto tr90;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	goto st40;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
+tr90:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st55;
 st55:
 	if ( ++p == pe )
 		goto _test_eof55;
 case 55:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 69: goto st56;
-		case 101: goto st56;
+#line 3230 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr73;
+		case 32: goto st55;
+		case 33: goto tr92;
+		case 67: goto tr93;
+		case 75: goto tr94;
+		case 85: goto tr95;
+		case 99: goto tr93;
+		case 107: goto tr94;
+		case 117: goto tr95;
+		case 124: goto tr92;
+		case 126: goto tr92;
 	}
-	goto st40;
-st56:
-	if ( ++p == pe )
-		goto _test_eof56;
-case 56:
-	if ( (*p) == 13 )
-		goto tr71;
-	goto st40;
-tr66:
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr92;
+		} else if ( (*p) >= 35 )
+			goto tr92;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr92;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr92;
+		} else
+			goto tr92;
+	} else
+		goto tr92;
+	goto tr72;
+tr92:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st56;
+st56:
+	if ( ++p == pe )
+		goto _test_eof56;
+case 56:
+#line 3273 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 124: goto st56;
+		case 126: goto st56;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
+tr106:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+	goto st57;
+tr118:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+	goto st57;
+tr127:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
 	goto st57;
 st57:
 	if ( ++p == pe )
 		goto _test_eof57;
 case 57:
-#line 1854 "http_parser.c"
+#line 3314 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 69: goto st58;
-		case 101: goto st58;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 44: goto st58;
 	}
-	goto st40;
+	goto st41;
+tr108:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+	goto st58;
+tr120:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+	goto st58;
+tr129:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+	goto st58;
 st58:
 	if ( ++p == pe )
 		goto _test_eof58;
 case 58:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 69: goto st59;
-		case 101: goto st59;
+#line 3338 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st58;
+		case 13: goto tr76;
+		case 32: goto st58;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 67: goto st59;
+		case 75: goto st64;
+		case 85: goto st74;
+		case 99: goto st59;
+		case 107: goto st64;
+		case 117: goto st74;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
+tr93:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st59;
 st59:
 	if ( ++p == pe )
 		goto _test_eof59;
 case 59:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 80: goto st60;
-		case 112: goto st60;
+#line 3380 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 76: goto st60;
+		case 108: goto st60;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st60:
 	if ( ++p == pe )
 		goto _test_eof60;
 case 60:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 45: goto st61;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 79: goto st61;
+		case 111: goto st61;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st61:
 	if ( ++p == pe )
 		goto _test_eof61;
 case 61:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 65: goto st62;
-		case 97: goto st62;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 83: goto st62;
+		case 115: goto st62;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st62:
 	if ( ++p == pe )
 		goto _test_eof62;
 case 62:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 76: goto st63;
-		case 108: goto st63;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 69: goto st63;
+		case 101: goto st63;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st63:
 	if ( ++p == pe )
 		goto _test_eof63;
 case 63:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 73: goto st64;
-		case 105: goto st64;
+		case 9: goto tr106;
+		case 13: goto tr107;
+		case 32: goto tr106;
+		case 33: goto st56;
+		case 44: goto tr108;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
+tr94:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st64;
 st64:
 	if ( ++p == pe )
 		goto _test_eof64;
 case 64:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 86: goto st65;
-		case 118: goto st65;
+#line 3536 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 69: goto st65;
+		case 101: goto st65;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st65:
 	if ( ++p == pe )
 		goto _test_eof65;
 case 65:
 	switch( (*p) ) {
-		case 13: goto tr52;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
 		case 69: goto st66;
 		case 101: goto st66;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	goto st40;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st66:
 	if ( ++p == pe )
 		goto _test_eof66;
 case 66:
-	if ( (*p) == 13 )
-		goto tr81;
-	goto st40;
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 80: goto st67;
+		case 112: goto st67;
+		case 124: goto st56;
+		case 126: goto st56;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st67:
 	if ( ++p == pe )
 		goto _test_eof67;
 case 67:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 69: goto st68;
-		case 101: goto st68;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 45: goto st68;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st68:
 	if ( ++p == pe )
 		goto _test_eof68;
 case 68:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st69;
-		case 110: goto st69;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 65: goto st69;
+		case 97: goto st69;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 66 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st69:
 	if ( ++p == pe )
 		goto _test_eof69;
 case 69:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 84: goto st70;
-		case 116: goto st70;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 76: goto st70;
+		case 108: goto st70;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st70:
 	if ( ++p == pe )
 		goto _test_eof70;
 case 70:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 45: goto st71;
-		case 46: goto st38;
-		case 58: goto tr47;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 73: goto st71;
+		case 105: goto st71;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
 	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st56;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st56;
 		} else if ( (*p) >= 65 )
-			goto st38;
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st71:
 	if ( ++p == pe )
 		goto _test_eof71;
 case 71:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 76: goto st72;
-		case 108: goto st72;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 86: goto st72;
+		case 118: goto st72;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st72:
 	if ( ++p == pe )
 		goto _test_eof72;
 case 72:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
 		case 69: goto st73;
 		case 101: goto st73;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st73:
 	if ( ++p == pe )
 		goto _test_eof73;
 case 73:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st74;
-		case 110: goto st74;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto tr118;
+		case 13: goto tr119;
+		case 32: goto tr118;
+		case 33: goto st56;
+		case 44: goto tr120;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
+tr95:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st74;
 st74:
 	if ( ++p == pe )
 		goto _test_eof74;
 case 74:
-	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 71: goto st75;
-		case 103: goto st75;
-		case 124: goto st38;
-		case 126: goto st38;
+#line 3841 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 80: goto st75;
+		case 112: goto st75;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st75:
 	if ( ++p == pe )
 		goto _test_eof75;
 case 75:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 84: goto st76;
-		case 116: goto st76;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 71: goto st76;
+		case 103: goto st76;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st76:
 	if ( ++p == pe )
 		goto _test_eof76;
 case 76:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 72: goto st77;
-		case 104: goto st77;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 82: goto st77;
+		case 114: goto st77;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st77:
 	if ( ++p == pe )
 		goto _test_eof77;
 case 77:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr92;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 65: goto st78;
+		case 97: goto st78;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 66 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
-tr92:
-#line 143 "http_parser.rl"
-	{
-    CALLBACK(header_field);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_field_mark = NULL;
-    parser->header_field_size = 0;
-  }
-	goto st78;
+		goto st56;
+	goto st41;
 st78:
 	if ( ++p == pe )
 		goto _test_eof78;
 case 78:
-#line 2288 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr49;
-		case 32: goto st78;
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 68: goto st79;
+		case 100: goto st79;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr94;
-	goto tr48;
-tr94:
-#line 223 "http_parser.rl"
-	{
-    if (parser->content_length > INT_MAX) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->content_length *= 10;
-    parser->content_length += *p - '0';
-  }
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
-	goto st79;
-tr95:
-#line 223 "http_parser.rl"
-	{
-    if (parser->content_length > INT_MAX) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->content_length *= 10;
-    parser->content_length += *p - '0';
-  }
-	goto st79;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st79:
 	if ( ++p == pe )
 		goto _test_eof79;
 case 79:
-#line 2327 "http_parser.c"
-	if ( (*p) == 13 )
-		goto tr52;
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr95;
-	goto st40;
-tr44:
-#line 113 "http_parser.rl"
-	{
-    parser->header_field_mark = p;
-    parser->header_field_size = 0;
-  }
-	goto st80;
+	switch( (*p) ) {
+		case 9: goto st57;
+		case 13: goto tr76;
+		case 32: goto st57;
+		case 33: goto st56;
+		case 44: goto st58;
+		case 69: goto st80;
+		case 101: goto st80;
+		case 124: goto st56;
+		case 126: goto st56;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
+		} else if ( (*p) >= 35 )
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
+	} else
+		goto st56;
+	goto st41;
 st80:
 	if ( ++p == pe )
 		goto _test_eof80;
 case 80:
-#line 2344 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 82: goto st81;
-		case 114: goto st81;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 9: goto tr127;
+		case 13: goto tr128;
+		case 32: goto tr127;
+		case 33: goto st56;
+		case 44: goto tr129;
+		case 124: goto st56;
+		case 126: goto st56;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st56;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st56;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st56;
+		} else if ( (*p) >= 65 )
+			goto st56;
 	} else
-		goto st38;
-	goto st0;
+		goto st56;
+	goto st41;
 st81:
 	if ( ++p == pe )
 		goto _test_eof81;
 case 81:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 65: goto st82;
-		case 97: goto st82;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st82;
+		case 101: goto st82;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
-		if ( (*p) < 66 ) {
+		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st82:
 	if ( ++p == pe )
 		goto _test_eof82;
 case 82:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
+		case 33: goto st39;
+		case 58: goto tr71;
 		case 78: goto st83;
 		case 110: goto st83;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st83:
 	if ( ++p == pe )
 		goto _test_eof83;
 case 83:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 83: goto st84;
-		case 115: goto st84;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 84: goto st84;
+		case 116: goto st84;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st84:
 	if ( ++p == pe )
 		goto _test_eof84;
 case 84:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 70: goto st85;
-		case 102: goto st85;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 45: goto st85;
+		case 46: goto st39;
+		case 58: goto tr71;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
-		} else if ( (*p) > 90 ) {
+			goto st39;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else
-			goto st38;
+				goto st39;
+		} else if ( (*p) >= 65 )
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st85:
 	if ( ++p == pe )
 		goto _test_eof85;
 case 85:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 69: goto st86;
-		case 101: goto st86;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 76: goto st86;
+		case 108: goto st86;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st86:
 	if ( ++p == pe )
 		goto _test_eof86;
 case 86:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 82: goto st87;
-		case 114: goto st87;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st87;
+		case 101: goto st87;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st87:
 	if ( ++p == pe )
 		goto _test_eof87;
 case 87:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 45: goto st88;
-		case 46: goto st38;
-		case 58: goto tr47;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st88;
+		case 110: goto st88;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	if ( (*p) < 48 ) {
+	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
-	} else if ( (*p) > 57 ) {
-		if ( (*p) > 90 ) {
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
-		} else if ( (*p) >= 65 )
-			goto st38;
+				goto st39;
+		} else
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st88:
 	if ( ++p == pe )
 		goto _test_eof88;
 case 88:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 69: goto st89;
-		case 101: goto st89;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 71: goto st89;
+		case 103: goto st89;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st89:
 	if ( ++p == pe )
 		goto _test_eof89;
 case 89:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st90;
-		case 110: goto st90;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 84: goto st90;
+		case 116: goto st90;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st90:
 	if ( ++p == pe )
 		goto _test_eof90;
 case 90:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 67: goto st91;
-		case 99: goto st91;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 72: goto st91;
+		case 104: goto st91;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
 st91:
 	if ( ++p == pe )
 		goto _test_eof91;
 case 91:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 79: goto st92;
-		case 111: goto st92;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr140;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
+		goto st39;
+	goto tr62;
+tr140:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st92;
 st92:
 	if ( ++p == pe )
 		goto _test_eof92;
 case 92:
+#line 4408 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr73;
+		case 32: goto st92;
+	}
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr142;
+	goto tr72;
+tr142:
+#line 793 "http_parser.rl"
+	{
+    if (parser->content_length > INT_MAX) {
+      SET_ERROR(HPE_INVALID_CONTENT_LENGTH);
+      return 0;
+    }
+    parser->flags |= HTTP_FLAG_CONTENT_LENGTH;
+    parser->content_length *= 10;
+    parser->content_length += *p - '0';
+  }
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st93;
+tr143:
+#line 793 "http_parser.rl"
+	{
+    if (parser->content_length > INT_MAX) {
+      SET_ERROR(HPE_INVALID_CONTENT_LENGTH);
+      return 0;
+    }
+    parser->flags |= HTTP_FLAG_CONTENT_LENGTH;
+    parser->content_length *= 10;
+    parser->content_length += *p - '0';
+  }
+	goto st93;
+st93:
+	if ( ++p == pe )
+		goto _test_eof93;
+case 93:
+#line 4449 "http_parser.c"
+	if ( (*p) == 13 )
+		goto tr76;
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr143;
+	goto st41;
+tr66:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st94;
+st94:
+	if ( ++p == pe )
+		goto _test_eof94;
+case 94:
+#line 4466 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 68: goto st93;
-		case 100: goto st93;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 88: goto st95;
+		case 120: goto st95;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-st93:
+		goto st39;
+	goto tr62;
+st95:
 	if ( ++p == pe )
-		goto _test_eof93;
-case 93:
+		goto _test_eof95;
+case 95:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 73: goto st94;
-		case 105: goto st94;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 80: goto st96;
+		case 112: goto st96;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-st94:
+		goto st39;
+	goto tr62;
+st96:
 	if ( ++p == pe )
-		goto _test_eof94;
-case 94:
+		goto _test_eof96;
+case 96:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 78: goto st95;
-		case 110: goto st95;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st97;
+		case 101: goto st97;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-st95:
+		goto st39;
+	goto tr62;
+st97:
 	if ( ++p == pe )
-		goto _test_eof95;
-case 95:
+		goto _test_eof97;
+case 97:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr47;
-		case 71: goto st96;
-		case 103: goto st96;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 67: goto st98;
+		case 99: goto st98;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-st96:
+		goto st39;
+	goto tr62;
+st98:
 	if ( ++p == pe )
-		goto _test_eof96;
-case 96:
+		goto _test_eof98;
+case 98:
 	switch( (*p) ) {
-		case 33: goto st38;
-		case 58: goto tr112;
-		case 124: goto st38;
-		case 126: goto st38;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 84: goto st99;
+		case 116: goto st99;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) >= 35 )
-			goto st38;
+			goto st39;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st38;
+				goto st39;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st38;
+				goto st39;
 		} else
-			goto st38;
+			goto st39;
 	} else
-		goto st38;
-	goto st0;
-tr112:
-#line 238 "http_parser.rl"
-	{ parser->transfer_encoding = HTTP_CHUNKED;  }
-#line 143 "http_parser.rl"
+		goto st39;
+	goto tr62;
+st99:
+	if ( ++p == pe )
+		goto _test_eof99;
+case 99:
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr149;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
+tr149:
+#line 599 "http_parser.rl"
 	{
-    CALLBACK(header_field);
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
       return 0;
     }
     parser->header_field_mark = NULL;
     parser->header_field_size = 0;
   }
-	goto st97;
-st97:
+	goto st100;
+st100:
 	if ( ++p == pe )
-		goto _test_eof97;
-case 97:
-#line 2864 "http_parser.c"
+		goto _test_eof100;
+case 100:
+#line 4678 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr49;
-		case 32: goto st97;
-		case 105: goto tr114;
+		case 13: goto tr73;
+		case 32: goto st100;
+		case 49: goto tr151;
 	}
-	goto tr48;
-tr114:
-#line 118 "http_parser.rl"
+	goto tr72;
+tr151:
+#line 558 "http_parser.rl"
 	{
     parser->header_value_mark = p;
     parser->header_value_size = 0;
   }
-	goto st98;
-st98:
+	goto st101;
+st101:
 	if ( ++p == pe )
-		goto _test_eof98;
-case 98:
-#line 2882 "http_parser.c"
+		goto _test_eof101;
+case 101:
+#line 4696 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 100: goto st99;
+		case 13: goto tr76;
+		case 48: goto st102;
 	}
-	goto st40;
-st99:
+	goto st41;
+st102:
 	if ( ++p == pe )
-		goto _test_eof99;
-case 99:
+		goto _test_eof102;
+case 102:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 101: goto st100;
+		case 13: goto tr76;
+		case 48: goto st103;
 	}
-	goto st40;
-st100:
-	if ( ++p == pe )
-		goto _test_eof100;
-case 100:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 110: goto st101;
-	}
-	goto st40;
-st101:
-	if ( ++p == pe )
-		goto _test_eof101;
-case 101:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 116: goto st102;
-	}
-	goto st40;
-st102:
-	if ( ++p == pe )
-		goto _test_eof102;
-case 102:
-	switch( (*p) ) {
-		case 13: goto tr52;
-		case 105: goto st103;
-	}
-	goto st40;
+	goto st41;
 st103:
 	if ( ++p == pe )
 		goto _test_eof103;
 case 103:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 116: goto st104;
+		case 13: goto tr76;
+		case 45: goto st104;
 	}
-	goto st40;
+	goto st41;
 st104:
 	if ( ++p == pe )
 		goto _test_eof104;
 case 104:
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 121: goto st105;
+		case 13: goto tr76;
+		case 67: goto st105;
+		case 99: goto st105;
 	}
-	goto st40;
+	goto st41;
 st105:
 	if ( ++p == pe )
 		goto _test_eof105;
 case 105:
-	if ( (*p) == 13 )
-		goto tr122;
-	goto st40;
-tr30:
-#line 163 "http_parser.rl"
-	{ 
-    CALLBACK(uri);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->uri_mark = NULL;
-    parser->uri_size = 0;
-  }
-	goto st106;
-tr136:
-#line 193 "http_parser.rl"
-	{
-    CALLBACK(path);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->path_mark = NULL;
-    parser->path_size = 0;
-  }
-#line 163 "http_parser.rl"
-	{ 
-    CALLBACK(uri);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->uri_mark = NULL;
-    parser->uri_size = 0;
-  }
-	goto st106;
-tr142:
-#line 128 "http_parser.rl"
-	{
-    parser->query_string_mark = p;
-    parser->query_string_size = 0;
-  }
-#line 183 "http_parser.rl"
-	{ 
-    CALLBACK(query_string);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->query_string_mark = NULL;
-    parser->query_string_size = 0;
-  }
-#line 163 "http_parser.rl"
-	{ 
-    CALLBACK(uri);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->uri_mark = NULL;
-    parser->uri_size = 0;
-  }
-	goto st106;
-tr146:
-#line 183 "http_parser.rl"
-	{ 
-    CALLBACK(query_string);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->query_string_mark = NULL;
-    parser->query_string_size = 0;
-  }
-#line 163 "http_parser.rl"
-	{ 
-    CALLBACK(uri);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->uri_mark = NULL;
-    parser->uri_size = 0;
-  }
-	goto st106;
+	switch( (*p) ) {
+		case 13: goto tr76;
+		case 79: goto st106;
+		case 111: goto st106;
+	}
+	goto st41;
 st106:
 	if ( ++p == pe )
 		goto _test_eof106;
 case 106:
-#line 3036 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr124;
-		case 37: goto tr125;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 127: goto st0;
+		case 13: goto tr76;
+		case 78: goto st107;
+		case 110: goto st107;
 	}
-	if ( (*p) > 31 ) {
-		if ( 34 <= (*p) && (*p) <= 35 )
-			goto st0;
-	} else if ( (*p) >= 0 )
-		goto st0;
-	goto tr123;
-tr123:
-#line 123 "http_parser.rl"
-	{
-    parser->fragment_mark = p;
-    parser->fragment_size = 0;
-  }
-	goto st107;
+	goto st41;
 st107:
 	if ( ++p == pe )
 		goto _test_eof107;
 case 107:
-#line 3061 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr127;
-		case 37: goto st108;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 127: goto st0;
+		case 13: goto tr76;
+		case 84: goto st108;
+		case 116: goto st108;
 	}
-	if ( (*p) > 31 ) {
-		if ( 34 <= (*p) && (*p) <= 35 )
-			goto st0;
-	} else if ( (*p) >= 0 )
-		goto st0;
-	goto st107;
-tr125:
-#line 123 "http_parser.rl"
-	{
-    parser->fragment_mark = p;
-    parser->fragment_size = 0;
-  }
-	goto st108;
+	goto st41;
 st108:
 	if ( ++p == pe )
 		goto _test_eof108;
 case 108:
-#line 3086 "http_parser.c"
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st109;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st109;
-	} else
-		goto st109;
-	goto st0;
+	switch( (*p) ) {
+		case 13: goto tr76;
+		case 73: goto st109;
+		case 105: goto st109;
+	}
+	goto st41;
 st109:
 	if ( ++p == pe )
 		goto _test_eof109;
 case 109:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st107;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st107;
-	} else
-		goto st107;
-	goto st0;
-tr26:
-#line 138 "http_parser.rl"
-	{
-    parser->uri_mark = p;
-    parser->uri_size = 0;
-  }
-	goto st110;
+	switch( (*p) ) {
+		case 13: goto tr76;
+		case 78: goto st110;
+		case 110: goto st110;
+	}
+	goto st41;
 st110:
 	if ( ++p == pe )
 		goto _test_eof110;
 case 110:
-#line 3120 "http_parser.c"
 	switch( (*p) ) {
-		case 43: goto st110;
-		case 58: goto st111;
+		case 13: goto tr76;
+		case 85: goto st111;
+		case 117: goto st111;
 	}
-	if ( (*p) < 48 ) {
-		if ( 45 <= (*p) && (*p) <= 46 )
-			goto st110;
-	} else if ( (*p) > 57 ) {
-		if ( (*p) > 90 ) {
-			if ( 97 <= (*p) && (*p) <= 122 )
-				goto st110;
-		} else if ( (*p) >= 65 )
-			goto st110;
-	} else
-		goto st110;
-	goto st0;
-tr28:
-#line 138 "http_parser.rl"
-	{
-    parser->uri_mark = p;
-    parser->uri_size = 0;
-  }
-	goto st111;
+	goto st41;
 st111:
 	if ( ++p == pe )
 		goto _test_eof111;
 case 111:
-#line 3148 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr29;
-		case 34: goto st0;
-		case 35: goto tr30;
-		case 37: goto st112;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 127: goto st0;
+		case 13: goto tr76;
+		case 69: goto st112;
+		case 101: goto st112;
 	}
-	if ( 0 <= (*p) && (*p) <= 31 )
-		goto st0;
-	goto st111;
+	goto st41;
 st112:
 	if ( ++p == pe )
 		goto _test_eof112;
 case 112:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st113;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st113;
-	} else
-		goto st113;
-	goto st0;
+	if ( (*p) == 13 )
+		goto tr163;
+	goto st41;
+tr67:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st113;
 st113:
 	if ( ++p == pe )
 		goto _test_eof113;
 case 113:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st111;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st111;
+#line 4818 "http_parser.c"
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 82: goto st114;
+		case 114: goto st114;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
 	} else
-		goto st111;
-	goto st0;
-tr27:
-#line 138 "http_parser.rl"
-	{
-    parser->uri_mark = p;
-    parser->uri_size = 0;
-  }
-#line 133 "http_parser.rl"
-	{
-    parser->path_mark = p;
-    parser->path_size = 0;
-  }
-	goto st114;
+		goto st39;
+	goto tr62;
 st114:
 	if ( ++p == pe )
 		goto _test_eof114;
 case 114:
-#line 3203 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr135;
-		case 34: goto st0;
-		case 35: goto tr136;
-		case 37: goto st115;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 63: goto tr138;
-		case 127: goto st0;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 65: goto st115;
+		case 97: goto st115;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	if ( 0 <= (*p) && (*p) <= 31 )
-		goto st0;
-	goto st114;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 66 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st115:
 	if ( ++p == pe )
 		goto _test_eof115;
 case 115:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st116;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st116;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st116;
+		case 110: goto st116;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
 	} else
-		goto st116;
-	goto st0;
+		goto st39;
+	goto tr62;
 st116:
 	if ( ++p == pe )
 		goto _test_eof116;
 case 116:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st114;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st114;
-	} else
-		goto st114;
-	goto st0;
-tr138:
-#line 193 "http_parser.rl"
-	{
-    CALLBACK(path);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->path_mark = NULL;
-    parser->path_size = 0;
-  }
-	goto st117;
-st117:
-	if ( ++p == pe )
-		goto _test_eof117;
-case 117:
-#line 3259 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr141;
-		case 34: goto st0;
-		case 35: goto tr142;
-		case 37: goto tr143;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 127: goto st0;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 83: goto st117;
+		case 115: goto st117;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	if ( 0 <= (*p) && (*p) <= 31 )
-		goto st0;
-	goto tr140;
-tr140:
-#line 128 "http_parser.rl"
-	{
-    parser->query_string_mark = p;
-    parser->query_string_size = 0;
-  }
-	goto st118;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
+st117:
+	if ( ++p == pe )
+		goto _test_eof117;
+case 117:
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 70: goto st118;
+		case 102: goto st118;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st118:
 	if ( ++p == pe )
 		goto _test_eof118;
 case 118:
-#line 3283 "http_parser.c"
 	switch( (*p) ) {
-		case 32: goto tr145;
-		case 34: goto st0;
-		case 35: goto tr146;
-		case 37: goto st119;
-		case 60: goto st0;
-		case 62: goto st0;
-		case 127: goto st0;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st119;
+		case 101: goto st119;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	if ( 0 <= (*p) && (*p) <= 31 )
-		goto st0;
-	goto st118;
-tr143:
-#line 128 "http_parser.rl"
-	{
-    parser->query_string_mark = p;
-    parser->query_string_size = 0;
-  }
-	goto st119;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st119:
 	if ( ++p == pe )
 		goto _test_eof119;
 case 119:
-#line 3307 "http_parser.c"
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st120;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st120;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 82: goto st120;
+		case 114: goto st120;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
 	} else
-		goto st120;
-	goto st0;
+		goto st39;
+	goto tr62;
 st120:
 	if ( ++p == pe )
 		goto _test_eof120;
 case 120:
-	if ( (*p) < 65 ) {
-		if ( 48 <= (*p) && (*p) <= 57 )
-			goto st118;
-	} else if ( (*p) > 70 ) {
-		if ( 97 <= (*p) && (*p) <= 102 )
-			goto st118;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 45: goto st121;
+		case 46: goto st39;
+		case 58: goto tr71;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else if ( (*p) >= 65 )
+			goto st39;
 	} else
-		goto st118;
-	goto st0;
-tr311:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
-  }
-	goto st121;
+		goto st39;
+	goto tr62;
 st121:
 	if ( ++p == pe )
 		goto _test_eof121;
 case 121:
-#line 3346 "http_parser.c"
-	if ( (*p) == 69 )
-		goto st122;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st122;
+		case 101: goto st122;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st122:
 	if ( ++p == pe )
 		goto _test_eof122;
 case 122:
-	if ( (*p) == 76 )
-		goto st123;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st123;
+		case 110: goto st123;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st123:
 	if ( ++p == pe )
 		goto _test_eof123;
 case 123:
-	if ( (*p) == 69 )
-		goto st124;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 67: goto st124;
+		case 99: goto st124;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st124:
 	if ( ++p == pe )
 		goto _test_eof124;
 case 124:
-	if ( (*p) == 84 )
-		goto st125;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 79: goto st125;
+		case 111: goto st125;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st125:
 	if ( ++p == pe )
 		goto _test_eof125;
 case 125:
-	if ( (*p) == 69 )
-		goto st126;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 68: goto st126;
+		case 100: goto st126;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st126:
 	if ( ++p == pe )
 		goto _test_eof126;
 case 126:
-	if ( (*p) == 32 )
-		goto tr154;
-	goto st0;
-tr312:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
-  }
-	goto st127;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 73: goto st127;
+		case 105: goto st127;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st127:
 	if ( ++p == pe )
 		goto _test_eof127;
 case 127:
-#line 3401 "http_parser.c"
-	if ( (*p) == 69 )
-		goto st128;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 78: goto st128;
+		case 110: goto st128;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st128:
 	if ( ++p == pe )
 		goto _test_eof128;
 case 128:
-	if ( (*p) == 84 )
-		goto st129;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 71: goto st129;
+		case 103: goto st129;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st129:
 	if ( ++p == pe )
 		goto _test_eof129;
 case 129:
-	if ( (*p) == 32 )
-		goto tr157;
-	goto st0;
-tr313:
-#line 213 "http_parser.rl"
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr180;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
+tr180:
+#line 599 "http_parser.rl"
 	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
       }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
     }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
   }
 	goto st130;
 st130:
 	if ( ++p == pe )
 		goto _test_eof130;
 case 130:
-#line 3435 "http_parser.c"
-	if ( (*p) == 69 )
-		goto st131;
-	goto st0;
-st131:
-	if ( ++p == pe )
-		goto _test_eof131;
-case 131:
-	if ( (*p) == 65 )
-		goto st132;
-	goto st0;
-st132:
+#line 5357 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr73;
+		case 32: goto st130;
+		case 33: goto tr182;
+		case 67: goto tr183;
+		case 73: goto tr184;
+		case 99: goto tr183;
+		case 105: goto tr184;
+		case 124: goto tr182;
+		case 126: goto tr182;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr182;
+		} else if ( (*p) >= 35 )
+			goto tr182;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr182;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr182;
+		} else
+			goto tr182;
+	} else
+		goto tr182;
+	goto tr72;
+tr182:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st131;
+st131:
+	if ( ++p == pe )
+		goto _test_eof131;
+case 131:
+#line 5398 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
+tr185:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+	goto st132;
+tr199:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+	goto st132;
+st132:
 	if ( ++p == pe )
 		goto _test_eof132;
 case 132:
-	if ( (*p) == 68 )
-		goto st133;
-	goto st0;
+#line 5441 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st132;
+		case 13: goto tr76;
+		case 32: goto st132;
+		case 44: goto st133;
+	}
+	goto st41;
+tr188:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+	goto st133;
+tr201:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+	goto st133;
 st133:
 	if ( ++p == pe )
 		goto _test_eof133;
 case 133:
-	if ( (*p) == 32 )
-		goto tr161;
-	goto st0;
-tr314:
-#line 213 "http_parser.rl"
+#line 5467 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st133;
+		case 13: goto tr76;
+		case 32: goto st133;
+		case 33: goto st131;
+		case 44: goto st133;
+		case 67: goto st134;
+		case 73: goto st141;
+		case 99: goto st134;
+		case 105: goto st141;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
+tr183:
+#line 558 "http_parser.rl"
 	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
   }
 	goto st134;
 st134:
 	if ( ++p == pe )
 		goto _test_eof134;
 case 134:
-#line 3476 "http_parser.c"
-	if ( (*p) == 79 )
-		goto st135;
-	goto st0;
+#line 5507 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 72: goto st135;
+		case 104: goto st135;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st135:
 	if ( ++p == pe )
 		goto _test_eof135;
 case 135:
-	if ( (*p) == 67 )
-		goto st136;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 85: goto st136;
+		case 117: goto st136;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st136:
 	if ( ++p == pe )
 		goto _test_eof136;
 case 136:
-	if ( (*p) == 75 )
-		goto st137;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 78: goto st137;
+		case 110: goto st137;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st137:
 	if ( ++p == pe )
 		goto _test_eof137;
 case 137:
-	if ( (*p) == 32 )
-		goto tr165;
-	goto st0;
-tr315:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
-  }
-	goto st138;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 75: goto st138;
+		case 107: goto st138;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st138:
 	if ( ++p == pe )
 		goto _test_eof138;
 case 138:
-#line 3517 "http_parser.c"
 	switch( (*p) ) {
-		case 75: goto st139;
-		case 79: goto st143;
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 69: goto st139;
+		case 101: goto st139;
+		case 124: goto st131;
+		case 126: goto st131;
 	}
-	goto st0;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st139:
 	if ( ++p == pe )
 		goto _test_eof139;
 case 139:
-	if ( (*p) == 67 )
-		goto st140;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 68: goto st140;
+		case 100: goto st140;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st140:
 	if ( ++p == pe )
 		goto _test_eof140;
 case 140:
-	if ( (*p) == 79 )
-		goto st141;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr199;
+		case 13: goto tr200;
+		case 32: goto tr199;
+		case 33: goto st131;
+		case 44: goto tr201;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
+tr184:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st141;
 st141:
 	if ( ++p == pe )
 		goto _test_eof141;
 case 141:
-	if ( (*p) == 76 )
-		goto st142;
-	goto st0;
+#line 5723 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 68: goto st142;
+		case 100: goto st142;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st142:
 	if ( ++p == pe )
 		goto _test_eof142;
 case 142:
-	if ( (*p) == 32 )
-		goto tr171;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 69: goto st143;
+		case 101: goto st143;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st143:
 	if ( ++p == pe )
 		goto _test_eof143;
 case 143:
-	if ( (*p) == 86 )
-		goto st144;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 78: goto st144;
+		case 110: goto st144;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st144:
 	if ( ++p == pe )
 		goto _test_eof144;
 case 144:
-	if ( (*p) == 69 )
-		goto st145;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 84: goto st145;
+		case 116: goto st145;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st145:
 	if ( ++p == pe )
 		goto _test_eof145;
 case 145:
-	if ( (*p) == 32 )
-		goto tr174;
-	goto st0;
-tr316:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
-  }
-	goto st146;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 73: goto st146;
+		case 105: goto st146;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st146:
 	if ( ++p == pe )
 		goto _test_eof146;
 case 146:
-#line 3588 "http_parser.c"
-	if ( (*p) == 80 )
-		goto st147;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 84: goto st147;
+		case 116: goto st147;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st147:
 	if ( ++p == pe )
 		goto _test_eof147;
 case 147:
-	if ( (*p) == 84 )
-		goto st148;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto tr185;
+		case 13: goto tr186;
+		case 32: goto tr185;
+		case 33: goto st131;
+		case 44: goto tr188;
+		case 89: goto st148;
+		case 121: goto st148;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
 st148:
 	if ( ++p == pe )
 		goto _test_eof148;
 case 148:
-	if ( (*p) == 73 )
-		goto st149;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto st132;
+		case 13: goto tr76;
+		case 32: goto st132;
+		case 33: goto st131;
+		case 44: goto st133;
+		case 124: goto st131;
+		case 126: goto st131;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st131;
+		} else if ( (*p) >= 35 )
+			goto st131;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st131;
+		} else if ( (*p) >= 65 )
+			goto st131;
+	} else
+		goto st131;
+	goto st41;
+tr68:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st149;
 st149:
 	if ( ++p == pe )
 		goto _test_eof149;
 case 149:
-	if ( (*p) == 79 )
-		goto st150;
-	goto st0;
+#line 5969 "http_parser.c"
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 80: goto st150;
+		case 112: goto st150;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st150:
 	if ( ++p == pe )
 		goto _test_eof150;
 case 150:
-	if ( (*p) == 78 )
-		goto st151;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 71: goto st151;
+		case 103: goto st151;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st151:
 	if ( ++p == pe )
 		goto _test_eof151;
 case 151:
-	if ( (*p) == 83 )
-		goto st152;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 82: goto st152;
+		case 114: goto st152;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st152:
 	if ( ++p == pe )
 		goto _test_eof152;
 case 152:
-	if ( (*p) == 32 )
-		goto tr181;
-	goto st0;
-tr317:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
-    }
-  }
-	goto st153;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 65: goto st153;
+		case 97: goto st153;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 66 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st153:
 	if ( ++p == pe )
 		goto _test_eof153;
 case 153:
-#line 3650 "http_parser.c"
 	switch( (*p) ) {
-		case 79: goto st154;
-		case 82: goto st157;
-		case 85: goto st169;
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 68: goto st154;
+		case 100: goto st154;
+		case 124: goto st39;
+		case 126: goto st39;
 	}
-	goto st0;
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st154:
 	if ( ++p == pe )
 		goto _test_eof154;
 case 154:
-	if ( (*p) == 83 )
-		goto st155;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr71;
+		case 69: goto st155;
+		case 101: goto st155;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
 st155:
 	if ( ++p == pe )
 		goto _test_eof155;
 case 155:
-	if ( (*p) == 84 )
-		goto st156;
-	goto st0;
+	switch( (*p) ) {
+		case 33: goto st39;
+		case 58: goto tr215;
+		case 124: goto st39;
+		case 126: goto st39;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st39;
+		} else if ( (*p) >= 35 )
+			goto st39;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st39;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st39;
+		} else
+			goto st39;
+	} else
+		goto st39;
+	goto tr62;
+tr215:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st156;
 st156:
 	if ( ++p == pe )
 		goto _test_eof156;
 case 156:
-	if ( (*p) == 32 )
-		goto tr187;
-	goto st0;
+#line 6211 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr73;
+		case 32: goto st156;
+		case 33: goto tr217;
+		case 124: goto tr217;
+		case 126: goto tr217;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr217;
+		} else if ( (*p) >= 35 )
+			goto tr217;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr217;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr217;
+		} else
+			goto tr217;
+	} else
+		goto tr217;
+	goto tr72;
+tr217:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st157;
 st157:
 	if ( ++p == pe )
 		goto _test_eof157;
 case 157:
-	if ( (*p) == 79 )
-		goto st158;
-	goto st0;
+#line 6248 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st158;
+		case 13: goto tr219;
+		case 32: goto st158;
+		case 33: goto st157;
+		case 44: goto st159;
+		case 47: goto st160;
+		case 124: goto st157;
+		case 126: goto st157;
+	}
+	if ( (*p) < 42 ) {
+		if ( 35 <= (*p) && (*p) <= 39 )
+			goto st157;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st157;
+		} else if ( (*p) >= 65 )
+			goto st157;
+	} else
+		goto st157;
+	goto st41;
 st158:
 	if ( ++p == pe )
 		goto _test_eof158;
 case 158:
-	if ( (*p) == 80 )
-		goto st159;
-	goto st0;
+	switch( (*p) ) {
+		case 9: goto st158;
+		case 13: goto tr76;
+		case 32: goto st158;
+		case 44: goto st159;
+	}
+	goto st41;
 st159:
 	if ( ++p == pe )
 		goto _test_eof159;
 case 159:
 	switch( (*p) ) {
-		case 70: goto st160;
-		case 80: goto st164;
+		case 9: goto st159;
+		case 13: goto tr76;
+		case 32: goto st159;
+		case 33: goto st157;
+		case 44: goto st159;
+		case 124: goto st157;
+		case 126: goto st157;
 	}
-	goto st0;
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st157;
+		} else if ( (*p) >= 35 )
+			goto st157;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st157;
+		} else if ( (*p) >= 65 )
+			goto st157;
+	} else
+		goto st157;
+	goto st41;
 st160:
 	if ( ++p == pe )
 		goto _test_eof160;
 case 160:
-	if ( (*p) == 73 )
+	switch( (*p) ) {
+		case 13: goto tr76;
+		case 33: goto st161;
+		case 124: goto st161;
+		case 126: goto st161;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st161;
+		} else if ( (*p) >= 35 )
+			goto st161;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st161;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st161;
+		} else
+			goto st161;
+	} else
 		goto st161;
-	goto st0;
+	goto st41;
 st161:
 	if ( ++p == pe )
 		goto _test_eof161;
 case 161:
-	if ( (*p) == 78 )
-		goto st162;
-	goto st0;
-st162:
-	if ( ++p == pe )
-		goto _test_eof162;
-case 162:
-	if ( (*p) == 68 )
-		goto st163;
-	goto st0;
-st163:
-	if ( ++p == pe )
-		goto _test_eof163;
-case 163:
-	if ( (*p) == 32 )
-		goto tr195;
-	goto st0;
-st164:
-	if ( ++p == pe )
-		goto _test_eof164;
-case 164:
-	if ( (*p) == 65 )
-		goto st165;
-	goto st0;
-st165:
-	if ( ++p == pe )
-		goto _test_eof165;
-case 165:
-	if ( (*p) == 84 )
-		goto st166;
-	goto st0;
-st166:
-	if ( ++p == pe )
-		goto _test_eof166;
-case 166:
-	if ( (*p) == 67 )
-		goto st167;
-	goto st0;
-st167:
-	if ( ++p == pe )
-		goto _test_eof167;
-case 167:
-	if ( (*p) == 72 )
-		goto st168;
-	goto st0;
-st168:
-	if ( ++p == pe )
-		goto _test_eof168;
-case 168:
-	if ( (*p) == 32 )
-		goto tr200;
-	goto st0;
-st169:
-	if ( ++p == pe )
-		goto _test_eof169;
-case 169:
-	if ( (*p) == 84 )
-		goto st170;
-	goto st0;
-st170:
-	if ( ++p == pe )
-		goto _test_eof170;
-case 170:
-	if ( (*p) == 32 )
-		goto tr202;
-	goto st0;
-tr318:
-#line 213 "http_parser.rl"
-	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
+	switch( (*p) ) {
+		case 9: goto st158;
+		case 13: goto tr219;
+		case 32: goto st158;
+		case 33: goto st161;
+		case 44: goto st159;
+		case 124: goto st161;
+		case 126: goto st161;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st161;
+		} else if ( (*p) >= 35 )
+			goto st161;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st161;
+		} else if ( (*p) >= 65 )
+			goto st161;
+	} else
+		goto st161;
+	goto st41;
+tr50:
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
     }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
   }
-	goto st171;
-st171:
-	if ( ++p == pe )
-		goto _test_eof171;
-case 171:
-#line 3794 "http_parser.c"
-	if ( (*p) == 82 )
-		goto st172;
-	goto st0;
-st172:
-	if ( ++p == pe )
-		goto _test_eof172;
-case 172:
-	if ( (*p) == 65 )
-		goto st173;
-	goto st0;
-st173:
-	if ( ++p == pe )
-		goto _test_eof173;
-case 173:
-	if ( (*p) == 67 )
-		goto st174;
-	goto st0;
-st174:
-	if ( ++p == pe )
-		goto _test_eof174;
-case 174:
-	if ( (*p) == 69 )
-		goto st175;
-	goto st0;
-st175:
-	if ( ++p == pe )
-		goto _test_eof175;
-case 175:
-	if ( (*p) == 32 )
-		goto tr207;
-	goto st0;
-tr319:
-#line 213 "http_parser.rl"
+	goto st162;
+tr251:
+#line 714 "http_parser.rl"
 	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
     }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
   }
-	goto st176;
-st176:
-	if ( ++p == pe )
-		goto _test_eof176;
-case 176:
-#line 3842 "http_parser.c"
-	if ( (*p) == 78 )
-		goto st177;
-	goto st0;
-st177:
-	if ( ++p == pe )
-		goto _test_eof177;
-case 177:
-	if ( (*p) == 76 )
-		goto st178;
-	goto st0;
-st178:
-	if ( ++p == pe )
-		goto _test_eof178;
-case 178:
-	if ( (*p) == 79 )
-		goto st179;
-	goto st0;
-st179:
-	if ( ++p == pe )
-		goto _test_eof179;
-case 179:
-	if ( (*p) == 67 )
-		goto st180;
-	goto st0;
-st180:
-	if ( ++p == pe )
-		goto _test_eof180;
-case 180:
-	if ( (*p) == 75 )
-		goto st181;
-	goto st0;
-st181:
-	if ( ++p == pe )
-		goto _test_eof181;
-case 181:
-	if ( (*p) == 32 )
-		goto tr213;
-	goto st0;
-tr232:
-	cs = 269;
-#line 203 "http_parser.rl"
-	{
-    if(parser->on_headers_complete) {
-      callback_return_value = parser->on_headers_complete(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
     }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
   }
-#line 282 "http_parser.rl"
+	goto st162;
+tr259:
+#line 681 "http_parser.rl"
 	{
-    if (parser->transfer_encoding == HTTP_CHUNKED) {
-      cs = 2;
-    } else {
-      /* this is pretty stupid. i'd prefer to combine this with skip_chunk_data */
-      parser->chunk_size = parser->content_length;
-      p += 1;  
-
-      SKIP_BODY(MIN(REMAINING, parser->content_length));
-
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
+    DECODE(path);
+    ROUTE;
+    TOKEN_CALLBACK(path);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->path_mark = NULL;
+    parser->path_size = 0;
 
-      p--;
-      if(parser->chunk_size > REMAINING) {
-        {p++; goto _out;}
+    if (parser->router) {
+      http_route_finish(parser->route);
+      if (parser->on_route) {
+        callback_return_value = parser->on_route(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
       }
     }
   }
-	goto _again;
-st269:
-	if ( ++p == pe )
-		goto _test_eof269;
-case 269:
-#line 3920 "http_parser.c"
-	if ( (*p) == 72 )
-		goto tr320;
-	goto st0;
-tr320:
-#line 213 "http_parser.rl"
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
+  }
+	goto st162;
+tr265:
+#line 568 "http_parser.rl"
 	{
-    if(parser->on_message_begin) {
-      callback_return_value = parser->on_message_begin(parser);
-      if (callback_return_value != 0) {
-        parser->error = TRUE;
-        return 0;
-      }
+    parser->query_string_mark = p;
+    parser->query_string_size = 0;
+  }
+#line 670 "http_parser.rl"
+	{ 
+    DECODE(query_string);
+    CALLBACK(query_string);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
     }
+    parser->query_string_mark = NULL;
+    parser->query_string_size = 0;
   }
-	goto st182;
-st182:
-	if ( ++p == pe )
-		goto _test_eof182;
-case 182:
-#line 3940 "http_parser.c"
-	if ( (*p) == 84 )
-		goto st183;
-	goto st0;
-st183:
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
+  }
+	goto st162;
+tr269:
+#line 670 "http_parser.rl"
+	{ 
+    DECODE(query_string);
+    CALLBACK(query_string);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->query_string_mark = NULL;
+    parser->query_string_size = 0;
+  }
+#line 650 "http_parser.rl"
+	{ 
+    CALLBACK(uri);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->uri_mark = NULL;
+    parser->uri_size = 0;
+  }
+	goto st162;
+st162:
 	if ( ++p == pe )
-		goto _test_eof183;
-case 183:
-	if ( (*p) == 84 )
-		goto st184;
-	goto st0;
-st184:
+		goto _test_eof162;
+case 162:
+#line 6490 "http_parser.c"
+	switch( (*p) ) {
+		case 32: goto tr225;
+		case 37: goto tr226;
+		case 60: goto st0;
+		case 62: goto st0;
+		case 127: goto st0;
+	}
+	if ( (*p) > 31 ) {
+		if ( 34 <= (*p) && (*p) <= 35 )
+			goto st0;
+	} else if ( (*p) >= 0 )
+		goto st0;
+	goto tr224;
+tr224:
+#line 563 "http_parser.rl"
+	{
+    parser->fragment_mark = p;
+    parser->fragment_size = 0;
+  }
+	goto st163;
+st163:
 	if ( ++p == pe )
-		goto _test_eof184;
-case 184:
-	if ( (*p) == 80 )
-		goto st185;
-	goto st0;
-st185:
+		goto _test_eof163;
+case 163:
+#line 6515 "http_parser.c"
+	switch( (*p) ) {
+		case 32: goto tr228;
+		case 37: goto st164;
+		case 60: goto st0;
+		case 62: goto st0;
+		case 127: goto st0;
+	}
+	if ( (*p) > 31 ) {
+		if ( 34 <= (*p) && (*p) <= 35 )
+			goto st0;
+	} else if ( (*p) >= 0 )
+		goto st0;
+	goto st163;
+tr226:
+#line 563 "http_parser.rl"
+	{
+    parser->fragment_mark = p;
+    parser->fragment_size = 0;
+  }
+	goto st164;
+st164:
 	if ( ++p == pe )
-		goto _test_eof185;
-case 185:
-	if ( (*p) == 47 )
-		goto st186;
+		goto _test_eof164;
+case 164:
+#line 6540 "http_parser.c"
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 )
+			goto st165;
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 )
+			goto st165;
+	} else
+		goto st165;
 	goto st0;
-st186:
+st165:
 	if ( ++p == pe )
-		goto _test_eof186;
-case 186:
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr218;
+		goto _test_eof165;
+case 165:
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 )
+			goto st163;
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 )
+			goto st163;
+	} else
+		goto st163;
 	goto st0;
-tr218:
-#line 243 "http_parser.rl"
+tr41:
+#line 579 "http_parser.rl"
 	{
-    parser->version_major *= 10;
-    parser->version_major += *p - '0';
+    parser->uri_mark = p;
+    parser->uri_size = 0;
   }
-	goto st187;
-st187:
-	if ( ++p == pe )
-		goto _test_eof187;
-case 187:
-#line 3983 "http_parser.c"
-	if ( (*p) == 46 )
-		goto st188;
-	goto st0;
-st188:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st166;
+st166:
 	if ( ++p == pe )
-		goto _test_eof188;
-case 188:
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr220;
-	goto st0;
-tr220:
-#line 248 "http_parser.rl"
+		goto _test_eof166;
+case 166:
+#line 6579 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 44 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( (*p) > 37 ) {
+				if ( 39 <= (*p) && (*p) <= 42 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 36 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 58 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 90 ) {
+			if ( (*p) > 92 ) {
+				if ( 94 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 92 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 294: goto st0;
+		case 299: goto st0;
+		case 303: goto st0;
+		case 347: goto st0;
+		case 349: goto st0;
+		case 383: goto st0;
+		case 545: goto st166;
+		case 548: goto st166;
+		case 549: goto st167;
+		case 555: goto st0;
+		case 559: goto st0;
+		case 570: goto tr233;
+		case 603: goto st0;
+		case 605: goto st0;
+	}
+	if ( _widec < 384 ) {
+		if ( _widec < 290 ) {
+			if ( 256 <= _widec && _widec <= 288 )
+				goto st0;
+		} else if ( _widec > 291 ) {
+			if ( 315 <= _widec && _widec <= 320 )
+				goto st0;
+		} else
+			goto st0;
+	} else if ( _widec > 511 ) {
+		if ( _widec < 551 ) {
+			if ( 512 <= _widec && _widec <= 550 )
+				goto st0;
+		} else if ( _widec > 569 ) {
+			if ( _widec > 576 ) {
+				if ( 577 <= _widec && _widec <= 638 )
+					goto st166;
+			} else if ( _widec >= 571 )
+				goto st0;
+		} else
+			goto st166;
+	} else
+		goto st166;
+	goto tr38;
+tr42:
+#line 579 "http_parser.rl"
 	{
-    parser->version_minor *= 10;
-    parser->version_minor += *p - '0';
+    parser->uri_mark = p;
+    parser->uri_size = 0;
   }
-	goto st189;
-st189:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st167;
+st167:
 	if ( ++p == pe )
-		goto _test_eof189;
-case 189:
-#line 4005 "http_parser.c"
-	if ( (*p) == 32 )
-		goto st190;
+		goto _test_eof167;
+case 167:
+#line 6699 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 353 ) {
+		if ( _widec < 304 ) {
+				goto tr38;
+		} else if ( _widec > 313 ) {
+			if ( 321 <= _widec && _widec <= 326 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 358 ) {
+		if ( _widec < 577 ) {
+			if ( 560 <= _widec && _widec <= 569 )
+				goto st168;
+		} else if ( _widec > 582 ) {
+			if ( 609 <= _widec && _widec <= 614 )
+				goto st168;
+		} else
+			goto st168;
+	} else
+		goto tr38;
 	goto st0;
-st190:
+st168:
 	if ( ++p == pe )
-		goto _test_eof190;
-case 190:
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr222;
+		goto _test_eof168;
+case 168:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 353 ) {
+		if ( _widec < 304 ) {
+				goto tr38;
+		} else if ( _widec > 313 ) {
+			if ( 321 <= _widec && _widec <= 326 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 358 ) {
+		if ( _widec < 577 ) {
+			if ( 560 <= _widec && _widec <= 569 )
+				goto st166;
+		} else if ( _widec > 582 ) {
+			if ( 609 <= _widec && _widec <= 614 )
+				goto st166;
+		} else
+			goto st166;
+	} else
+		goto tr38;
 	goto st0;
-tr222:
-#line 232 "http_parser.rl"
+tr233:
+#line 714 "http_parser.rl"
 	{
-    parser->status_code *= 10;
-    parser->status_code += *p - '0';
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
   }
-	goto st191;
-st191:
+	goto st169;
+st169:
 	if ( ++p == pe )
-		goto _test_eof191;
-case 191:
-#line 4027 "http_parser.c"
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr223;
+		goto _test_eof169;
+case 169:
+#line 6802 "http_parser.c"
+	_widec = (*p);
+	if ( 48 <= (*p) && (*p) <= 57 ) {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 304 ) {
+			goto tr38;
+	} else if ( _widec > 313 ) {
+		if ( 560 <= _widec && _widec <= 569 )
+			goto tr235;
+	} else
+		goto tr38;
 	goto st0;
-tr223:
-#line 232 "http_parser.rl"
+tr235:
+#line 724 "http_parser.rl"
 	{
-    parser->status_code *= 10;
-    parser->status_code += *p - '0';
+    tmp = parser->port * 10 + (*p - '0');
+    if (tmp > USHRT_MAX) {
+      SET_ERROR(HPE_INVALID_URI);
+      return 0;
+    }
+    parser->port = tmp;
   }
-	goto st192;
-st192:
+	goto st170;
+st170:
 	if ( ++p == pe )
-		goto _test_eof192;
-case 192:
-#line 4042 "http_parser.c"
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr224;
+		goto _test_eof170;
+case 170:
+#line 6833 "http_parser.c"
+	_widec = (*p);
+	if ( 48 <= (*p) && (*p) <= 57 ) {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+	}
+	if ( _widec < 304 ) {
+			goto tr38;
+	} else if ( _widec > 313 ) {
+		if ( 560 <= _widec && _widec <= 569 )
+			goto tr235;
+	} else
+		goto tr38;
 	goto st0;
-tr224:
-#line 232 "http_parser.rl"
+tr43:
+#line 579 "http_parser.rl"
 	{
-    parser->status_code *= 10;
-    parser->status_code += *p - '0';
+    parser->uri_mark = p;
+    parser->uri_size = 0;
   }
-	goto st193;
-st193:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st171;
+st171:
 	if ( ++p == pe )
-		goto _test_eof193;
-case 193:
-#line 4057 "http_parser.c"
-	switch( (*p) ) {
-		case 13: goto st194;
-		case 32: goto st265;
-	}
+		goto _test_eof171;
+case 171:
+#line 6869 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 44 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( (*p) > 37 ) {
+				if ( 39 <= (*p) && (*p) <= 42 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 36 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 58 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 90 ) {
+			if ( (*p) > 92 ) {
+				if ( 94 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 92 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 294: goto st0;
+		case 299: goto st0;
+		case 303: goto st0;
+		case 347: goto st0;
+		case 349: goto st0;
+		case 383: goto st0;
+		case 545: goto st166;
+		case 548: goto st166;
+		case 549: goto st167;
+		case 555: goto st0;
+		case 559: goto st0;
+		case 570: goto tr233;
+		case 603: goto st0;
+		case 605: goto st0;
+	}
+	if ( _widec < 384 ) {
+		if ( _widec < 290 ) {
+			if ( 256 <= _widec && _widec <= 288 )
+				goto st0;
+		} else if ( _widec > 291 ) {
+			if ( 315 <= _widec && _widec <= 320 )
+				goto st0;
+		} else
+			goto st0;
+	} else if ( _widec > 511 ) {
+		if ( _widec < 551 ) {
+			if ( 512 <= _widec && _widec <= 550 )
+				goto st0;
+		} else if ( _widec > 569 ) {
+			if ( _widec > 576 ) {
+				if ( 577 <= _widec && _widec <= 638 )
+					goto st166;
+			} else if ( _widec >= 571 )
+				goto st0;
+		} else
+			goto st166;
+	} else
+		goto st166;
+	goto tr38;
+tr44:
+#line 579 "http_parser.rl"
+	{
+    parser->uri_mark = p;
+    parser->uri_size = 0;
+  }
+	goto st172;
+st172:
+	if ( ++p == pe )
+		goto _test_eof172;
+case 172:
+#line 6986 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 48 ) {
+		if ( 46 <= (*p) && (*p) <= 46 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 58 ) {
+		if ( (*p) > 70 ) {
+			if ( 97 <= (*p) && (*p) <= 102 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 65 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 302: goto tr38;
+		case 558: goto tr236;
+	}
+	if ( _widec < 353 ) {
+		if ( _widec < 304 ) {
+				goto tr38;
+		} else if ( _widec > 314 ) {
+			if ( 321 <= _widec && _widec <= 326 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 358 ) {
+		if ( _widec < 577 ) {
+			if ( 560 <= _widec && _widec <= 570 )
+				goto tr236;
+		} else if ( _widec > 582 ) {
+			if ( 609 <= _widec && _widec <= 614 )
+				goto tr236;
+		} else
+			goto tr236;
+	} else
+		goto tr38;
 	goto st0;
 tr236:
-#line 118 "http_parser.rl"
+#line 594 "http_parser.rl"
 	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
+    parser->host_mark = p;
+    parser->host_size = 0;
   }
-#line 153 "http_parser.rl"
+	goto st173;
+st173:
+	if ( ++p == pe )
+		goto _test_eof173;
+case 173:
+#line 7050 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( (*p) > 46 ) {
+			if ( 48 <= (*p) && (*p) <= 58 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 46 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( (*p) > 93 ) {
+			if ( 97 <= (*p) && (*p) <= 102 ) {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 93 ) {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 302: goto tr38;
+		case 349: goto tr38;
+		case 558: goto st173;
+		case 605: goto tr238;
+	}
+	if ( _widec < 353 ) {
+		if ( _widec < 304 ) {
+				goto tr38;
+		} else if ( _widec > 314 ) {
+			if ( 321 <= _widec && _widec <= 326 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 358 ) {
+		if ( _widec < 577 ) {
+			if ( 560 <= _widec && _widec <= 570 )
+				goto st173;
+		} else if ( _widec > 582 ) {
+			if ( 609 <= _widec && _widec <= 614 )
+				goto st173;
+		} else
+			goto st173;
+	} else
+		goto tr38;
+	goto st0;
+tr238:
+#line 714 "http_parser.rl"
 	{
-    CALLBACK(header_value);
+    CALLBACK(host);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->host_mark = NULL;
+    parser->host_size = 0;
   }
-	goto st194;
-tr239:
-#line 153 "http_parser.rl"
+	goto st174;
+st174:
+	if ( ++p == pe )
+		goto _test_eof174;
+case 174:
+#line 7128 "http_parser.c"
+	_widec = (*p);
+	if ( 58 <= (*p) && (*p) <= 58 ) {
+		_widec = (short)(128 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 314: goto tr38;
+		case 570: goto st169;
+	}
+		goto tr38;
+	goto st0;
+tr45:
+#line 579 "http_parser.rl"
 	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->uri_mark = p;
+    parser->uri_size = 0;
   }
-	goto st194;
-tr258:
-#line 241 "http_parser.rl"
-	{ parser->keep_alive = FALSE; }
-#line 153 "http_parser.rl"
+#line 589 "http_parser.rl"
 	{
-    CALLBACK(header_value);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->scheme_mark = p;
+    parser->scheme_size = 0;
   }
-	goto st194;
-tr268:
-#line 240 "http_parser.rl"
-	{ parser->keep_alive = TRUE; }
-#line 153 "http_parser.rl"
+	goto st175;
+st175:
+	if ( ++p == pe )
+		goto _test_eof175;
+case 175:
+#line 7158 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 48 ) {
+		if ( (*p) > 43 ) {
+			if ( 45 <= (*p) && (*p) <= 46 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 43 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 58 ) {
+		if ( (*p) > 90 ) {
+			if ( 97 <= (*p) && (*p) <= 122 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 65 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 811: goto tr38;
+		case 1067: goto st175;
+		case 1082: goto tr241;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 813 ) {
+				goto tr38;
+		} else if ( _widec > 814 ) {
+			if ( _widec > 826 ) {
+				if ( 833 <= _widec && _widec <= 858 )
+					goto tr38;
+			} else if ( _widec >= 816 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 890 ) {
+		if ( _widec < 1072 ) {
+			if ( 1069 <= _widec && _widec <= 1070 )
+				goto st175;
+		} else if ( _widec > 1081 ) {
+			if ( _widec > 1114 ) {
+				if ( 1121 <= _widec && _widec <= 1146 )
+					goto st175;
+			} else if ( _widec >= 1089 )
+				goto st175;
+		} else
+			goto st175;
+	} else
+		goto tr38;
+	goto st0;
+tr47:
+#line 579 "http_parser.rl"
+	{
+    parser->uri_mark = p;
+    parser->uri_size = 0;
+  }
+#line 589 "http_parser.rl"
+	{
+    parser->scheme_mark = p;
+    parser->scheme_size = 0;
+  }
+#line 704 "http_parser.rl"
 	{
-    CALLBACK(header_value);
+    CALLBACK(scheme);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->scheme_mark = NULL;
+    parser->scheme_size = 0;
   }
-	goto st194;
-tr309:
-#line 237 "http_parser.rl"
-	{ parser->transfer_encoding = HTTP_IDENTITY; }
-#line 153 "http_parser.rl"
+	goto st176;
+tr241:
+#line 704 "http_parser.rl"
 	{
-    CALLBACK(header_value);
+    CALLBACK(scheme);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
-    parser->header_value_mark = NULL;
-    parser->header_value_size = 0;
+    parser->scheme_mark = NULL;
+    parser->scheme_size = 0;
   }
-	goto st194;
-st194:
+	goto st176;
+st176:
 	if ( ++p == pe )
-		goto _test_eof194;
-case 194:
-#line 4138 "http_parser.c"
-	if ( (*p) == 10 )
-		goto st195;
+		goto _test_eof176;
+case 176:
+#line 7263 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st177;
+		case 1061: goto st178;
+		case 1071: goto st180;
+		case 1085: goto st177;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto st177;
+		} else if ( _widec > 1083 ) {
+			if ( 1087 <= _widec && _widec <= 1150 )
+				goto st177;
+		} else
+			goto st177;
+	} else
+		goto tr38;
 	goto st0;
-st195:
+st177:
+	if ( ++p == pe )
+		goto _test_eof177;
+case 177:
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st177;
+		case 1061: goto st178;
+		case 1085: goto st177;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto st177;
+		} else if ( _widec > 1083 ) {
+			if ( 1087 <= _widec && _widec <= 1150 )
+				goto st177;
+		} else
+			goto st177;
+	} else
+		goto tr38;
+	goto st0;
+st178:
+	if ( ++p == pe )
+		goto _test_eof178;
+case 178:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st179;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st179;
+		} else
+			goto st179;
+	} else
+		goto tr38;
+	goto st0;
+st179:
+	if ( ++p == pe )
+		goto _test_eof179;
+case 179:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st177;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st177;
+		} else
+			goto st177;
+	} else
+		goto tr38;
+	goto st0;
+st180:
+	if ( ++p == pe )
+		goto _test_eof180;
+case 180:
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st177;
+		case 1061: goto st178;
+		case 1071: goto st181;
+		case 1085: goto st177;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto st177;
+		} else if ( _widec > 1083 ) {
+			if ( 1087 <= _widec && _widec <= 1150 )
+				goto st177;
+		} else
+			goto st177;
+	} else
+		goto tr38;
+	goto st0;
+st181:
+	if ( ++p == pe )
+		goto _test_eof181;
+case 181:
+	_widec = (*p);
+	if ( (*p) < 39 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( 36 <= (*p) && (*p) <= 37 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 42 ) {
+		if ( (*p) < 48 ) {
+			if ( 44 <= (*p) && (*p) <= 46 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 57 ) {
+			if ( (*p) > 92 ) {
+				if ( 94 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(640 + ((*p) - -128));
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 65 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 801: goto tr38;
+		case 1057: goto tr247;
+		case 1060: goto tr247;
+		case 1061: goto tr248;
+		case 1115: goto st193;
+	}
+	if ( _widec < 833 ) {
+		if ( _widec < 804 ) {
+			if ( _widec > 127 ) {
+				if ( 640 <= _widec && _widec <= 767 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 805 ) {
+			if ( _widec < 812 ) {
+				if ( 807 <= _widec && _widec <= 810 )
+					goto tr38;
+			} else if ( _widec > 814 ) {
+				if ( 816 <= _widec && _widec <= 825 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 860 ) {
+		if ( _widec < 1068 ) {
+			if ( _widec < 896 ) {
+				if ( 862 <= _widec && _widec <= 894 )
+					goto tr38;
+			} else if ( _widec > 1023 ) {
+				if ( 1063 <= _widec && _widec <= 1066 )
+					goto tr247;
+			} else
+				goto tr247;
+		} else if ( _widec > 1070 ) {
+			if ( _widec < 1089 ) {
+				if ( 1072 <= _widec && _widec <= 1081 )
+					goto tr247;
+			} else if ( _widec > 1116 ) {
+				if ( 1118 <= _widec && _widec <= 1150 )
+					goto tr247;
+			} else
+				goto tr247;
+		} else
+			goto tr247;
+	} else
+		goto tr38;
+	goto st0;
+tr247:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st182;
+st182:
+	if ( ++p == pe )
+		goto _test_eof182;
+case 182:
+#line 7676 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 44 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( (*p) > 37 ) {
+				if ( 39 <= (*p) && (*p) <= 42 ) {
+					_widec = (short)(640 + ((*p) - -128));
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 36 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 58 ) {
+		if ( (*p) < 65 ) {
+			if ( 63 <= (*p) && (*p) <= 63 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 90 ) {
+			if ( (*p) > 92 ) {
+				if ( 94 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(640 + ((*p) - -128));
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) >= 92 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr250;
+		case 35: goto tr251;
+		case 801: goto tr38;
+		case 831: goto tr38;
+		case 860: goto tr38;
+		case 1057: goto st182;
+		case 1060: goto st182;
+		case 1061: goto st183;
+		case 1071: goto tr254;
+		case 1082: goto tr255;
+		case 1087: goto tr256;
+		case 1116: goto st182;
+	}
+	if ( _widec < 833 ) {
+		if ( _widec < 804 ) {
+			if ( _widec > 127 ) {
+				if ( 640 <= _widec && _widec <= 767 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 805 ) {
+			if ( _widec > 810 ) {
+				if ( 812 <= _widec && _widec <= 826 )
+					goto tr38;
+			} else if ( _widec >= 807 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 858 ) {
+		if ( _widec < 1063 ) {
+			if ( _widec > 894 ) {
+				if ( 896 <= _widec && _widec <= 1023 )
+					goto st182;
+			} else if ( _widec >= 862 )
+				goto tr38;
+		} else if ( _widec > 1066 ) {
+			if ( _widec < 1089 ) {
+				if ( 1068 <= _widec && _widec <= 1081 )
+					goto st182;
+			} else if ( _widec > 1114 ) {
+				if ( 1118 <= _widec && _widec <= 1150 )
+					goto st182;
+			} else
+				goto st182;
+		} else
+			goto st182;
+	} else
+		goto tr38;
+	goto st0;
+tr248:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st183;
+st183:
+	if ( ++p == pe )
+		goto _test_eof183;
+case 183:
+#line 7801 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st184;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st184;
+		} else
+			goto st184;
+	} else
+		goto tr38;
+	goto st0;
+st184:
+	if ( ++p == pe )
+		goto _test_eof184;
+case 184:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st182;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st182;
+		} else
+			goto st182;
+	} else
+		goto tr38;
+	goto st0;
+tr46:
+#line 579 "http_parser.rl"
+	{
+    parser->uri_mark = p;
+    parser->uri_size = 0;
+  }
+#line 573 "http_parser.rl"
+	{
+    parser->path_mark = p;
+    parser->path_size = 0;
+    if (parser->router) http_route_start(parser->route, parser->router);
+  }
+	goto st185;
+tr254:
+#line 714 "http_parser.rl"
+	{
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+#line 573 "http_parser.rl"
+	{
+    parser->path_mark = p;
+    parser->path_size = 0;
+    if (parser->router) http_route_start(parser->route, parser->router);
+  }
+	goto st185;
+tr273:
+#line 573 "http_parser.rl"
+	{
+    parser->path_mark = p;
+    parser->path_size = 0;
+    if (parser->router) http_route_start(parser->route, parser->router);
+  }
+	goto st185;
+st185:
+	if ( ++p == pe )
+		goto _test_eof185;
+case 185:
+#line 7931 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr258;
+		case 35: goto tr259;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st185;
+		case 1061: goto st186;
+		case 1085: goto st185;
+		case 1087: goto tr262;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto st185;
+		} else if ( _widec > 1083 ) {
+			if ( 1088 <= _widec && _widec <= 1150 )
+				goto st185;
+		} else
+			goto st185;
+	} else
+		goto tr38;
+	goto st0;
+st186:
+	if ( ++p == pe )
+		goto _test_eof186;
+case 186:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st187;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st187;
+		} else
+			goto st187;
+	} else
+		goto tr38;
+	goto st0;
+st187:
+	if ( ++p == pe )
+		goto _test_eof187;
+case 187:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st185;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st185;
+		} else
+			goto st185;
+	} else
+		goto tr38;
+	goto st0;
+tr256:
+#line 714 "http_parser.rl"
+	{
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+	goto st188;
+tr262:
+#line 681 "http_parser.rl"
+	{
+    DECODE(path);
+    ROUTE;
+    TOKEN_CALLBACK(path);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->path_mark = NULL;
+    parser->path_size = 0;
+
+    if (parser->router) {
+      http_route_finish(parser->route);
+      if (parser->on_route) {
+        callback_return_value = parser->on_route(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+    }
+  }
+	goto st188;
+st188:
+	if ( ++p == pe )
+		goto _test_eof188;
+case 188:
+#line 8128 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr264;
+		case 35: goto tr265;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto tr266;
+		case 1061: goto tr267;
+		case 1085: goto tr266;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto tr266;
+		} else if ( _widec > 1083 ) {
+			if ( 1087 <= _widec && _widec <= 1150 )
+				goto tr266;
+		} else
+			goto tr266;
+	} else
+		goto tr38;
+	goto st0;
+tr266:
+#line 568 "http_parser.rl"
+	{
+    parser->query_string_mark = p;
+    parser->query_string_size = 0;
+  }
+	goto st189;
+st189:
+	if ( ++p == pe )
+		goto _test_eof189;
+case 189:
+#line 8204 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 36 ) {
+		if ( (*p) > -1 ) {
+			if ( 33 <= (*p) && (*p) <= 33 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 59 ) {
+		if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 61 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr268;
+		case 35: goto tr269;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st189;
+		case 1061: goto st190;
+		case 1085: goto st189;
+	}
+	if ( _widec < 831 ) {
+		if ( _widec < 640 ) {
+				goto tr38;
+		} else if ( _widec > 767 ) {
+			if ( 804 <= _widec && _widec <= 827 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 894 ) {
+		if ( _widec < 1060 ) {
+			if ( 896 <= _widec && _widec <= 1023 )
+				goto st189;
+		} else if ( _widec > 1083 ) {
+			if ( 1087 <= _widec && _widec <= 1150 )
+				goto st189;
+		} else
+			goto st189;
+	} else
+		goto tr38;
+	goto st0;
+tr267:
+#line 568 "http_parser.rl"
+	{
+    parser->query_string_mark = p;
+    parser->query_string_size = 0;
+  }
+	goto st190;
+st190:
+	if ( ++p == pe )
+		goto _test_eof190;
+case 190:
+#line 8280 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st191;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st191;
+		} else
+			goto st191;
+	} else
+		goto tr38;
+	goto st0;
+st191:
+	if ( ++p == pe )
+		goto _test_eof191;
+case 191:
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( 48 <= (*p) && (*p) <= 57 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( 97 <= (*p) && (*p) <= 102 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 825 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1081 )
+				goto st189;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st189;
+		} else
+			goto st189;
+	} else
+		goto tr38;
+	goto st0;
+tr255:
+#line 714 "http_parser.rl"
+	{
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+	goto st192;
+tr274:
+#line 724 "http_parser.rl"
+	{
+    tmp = parser->port * 10 + (*p - '0');
+    if (tmp > USHRT_MAX) {
+      SET_ERROR(HPE_INVALID_URI);
+      return 0;
+    }
+    parser->port = tmp;
+  }
+	goto st192;
+st192:
+	if ( ++p == pe )
+		goto _test_eof192;
+case 192:
+#line 8394 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) > 57 ) {
+		if ( 63 <= (*p) && (*p) <= 63 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) >= 47 ) {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 831: goto tr38;
+		case 1071: goto tr273;
+		case 1087: goto st188;
+	}
+	if ( _widec < 815 ) {
+			goto tr38;
+	} else if ( _widec > 825 ) {
+		if ( 1072 <= _widec && _widec <= 1081 )
+			goto tr274;
+	} else
+		goto tr38;
+	goto st0;
+st193:
+	if ( ++p == pe )
+		goto _test_eof193;
+case 193:
+	_widec = (*p);
+	if ( (*p) < 48 ) {
+		if ( 46 <= (*p) && (*p) <= 46 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 58 ) {
+		if ( (*p) > 70 ) {
+			if ( 97 <= (*p) && (*p) <= 102 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 65 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 814: goto tr38;
+		case 1070: goto tr276;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 826 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1082 )
+				goto tr276;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto tr276;
+		} else
+			goto tr276;
+	} else
+		goto tr38;
+	goto st0;
+tr276:
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st194;
+st194:
+	if ( ++p == pe )
+		goto _test_eof194;
+case 194:
+#line 8491 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 65 ) {
+		if ( (*p) > 46 ) {
+			if ( 48 <= (*p) && (*p) <= 58 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 46 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 70 ) {
+		if ( (*p) > 93 ) {
+			if ( 97 <= (*p) && (*p) <= 102 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) >= 93 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 814: goto tr38;
+		case 861: goto tr38;
+		case 1070: goto st194;
+		case 1117: goto tr278;
+	}
+	if ( _widec < 865 ) {
+		if ( _widec < 816 ) {
+				goto tr38;
+		} else if ( _widec > 826 ) {
+			if ( 833 <= _widec && _widec <= 838 )
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 870 ) {
+		if ( _widec < 1089 ) {
+			if ( 1072 <= _widec && _widec <= 1082 )
+				goto st194;
+		} else if ( _widec > 1094 ) {
+			if ( 1121 <= _widec && _widec <= 1126 )
+				goto st194;
+		} else
+			goto st194;
+	} else
+		goto tr38;
+	goto st0;
+tr278:
+#line 714 "http_parser.rl"
+	{
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+	goto st195;
+st195:
+	if ( ++p == pe )
+		goto _test_eof195;
+case 195:
+#line 8569 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 58 ) {
+		if ( 47 <= (*p) && (*p) <= 47 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 58 ) {
+		if ( 63 <= (*p) && (*p) <= 63 ) {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(640 + ((*p) - -128));
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 815: goto tr38;
+		case 826: goto tr38;
+		case 831: goto tr38;
+		case 1071: goto tr273;
+		case 1082: goto st192;
+		case 1087: goto st188;
+	}
+		goto tr38;
+	goto st0;
+tr48:
+#line 579 "http_parser.rl"
+	{
+    parser->uri_mark = p;
+    parser->uri_size = 0;
+  }
+#line 589 "http_parser.rl"
+	{
+    parser->scheme_mark = p;
+    parser->scheme_size = 0;
+  }
+#line 594 "http_parser.rl"
+	{
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+	goto st196;
+st196:
+	if ( ++p == pe )
+		goto _test_eof196;
+case 196:
+#line 8624 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 45 ) {
+		if ( (*p) < 36 ) {
+			if ( (*p) > -1 ) {
+				if ( 33 <= (*p) && (*p) <= 33 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else {
+				_widec = (short)(128 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 37 ) {
+			if ( (*p) < 43 ) {
+				if ( 39 <= (*p) && (*p) <= 42 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) > 43 ) {
+				if ( 44 <= (*p) && (*p) <= 44 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 92 ) {
+			if ( (*p) > 58 ) {
+				if ( 65 <= (*p) && (*p) <= 90 ) {
+					_widec = (short)(1152 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+					if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+				}
+			} else if ( (*p) >= 48 ) {
+				_widec = (short)(1152 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+			}
+		} else if ( (*p) > 92 ) {
+			if ( (*p) < 97 ) {
+				if ( 94 <= (*p) && (*p) <= 96 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else if ( (*p) > 122 ) {
+				if ( 123 <= (*p) && (*p) <= 126 ) {
+					_widec = (short)(128 + ((*p) - -128));
+					if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				}
+			} else {
+				_widec = (short)(1152 + ((*p) - -128));
+				if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+			}
+		} else {
+			_widec = (short)(128 + ((*p) - -128));
+			if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(1152 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+	}
+	switch( _widec ) {
+		case 289: goto tr38;
+		case 300: goto tr38;
+		case 348: goto tr38;
+		case 545: goto st166;
+		case 548: goto st166;
+		case 549: goto st167;
+		case 556: goto st166;
+		case 604: goto st166;
+		case 811: goto tr38;
+		case 1067: goto st175;
+		case 1594: goto tr233;
+		case 1850: goto tr241;
+		case 2106: goto tr281;
+	}
+	if ( _widec < 1377 ) {
+		if ( _widec < 384 ) {
+			if ( _widec < 295 ) {
+				if ( _widec > 255 ) {
+					if ( 292 <= _widec && _widec <= 293 )
+						goto tr38;
+				} else
+					goto tr38;
+			} else if ( _widec > 298 ) {
+				if ( _widec > 352 ) {
+					if ( 379 <= _widec && _widec <= 382 )
+						goto tr38;
+				} else if ( _widec >= 350 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 511 ) {
+			if ( _widec < 635 ) {
+				if ( _widec > 554 ) {
+					if ( 606 <= _widec && _widec <= 608 )
+						goto st166;
+				} else if ( _widec >= 551 )
+					goto st166;
+			} else if ( _widec > 638 ) {
+				if ( _widec < 1328 ) {
+					if ( 1325 <= _widec && _widec <= 1326 )
+						goto tr38;
+				} else if ( _widec > 1338 ) {
+					if ( 1345 <= _widec && _widec <= 1370 )
+						goto tr38;
+				} else
+					goto tr38;
+			} else
+				goto st166;
+		} else
+			goto st166;
+	} else if ( _widec > 1402 ) {
+		if ( _widec < 1840 ) {
+			if ( _widec < 1601 ) {
+				if ( _widec > 1582 ) {
+					if ( 1584 <= _widec && _widec <= 1593 )
+						goto st166;
+				} else if ( _widec >= 1581 )
+					goto st166;
+			} else if ( _widec > 1626 ) {
+				if ( _widec > 1658 ) {
+					if ( 1837 <= _widec && _widec <= 1838 )
+						goto st175;
+				} else if ( _widec >= 1633 )
+					goto st166;
+			} else
+				goto st166;
+		} else if ( _widec > 1849 ) {
+			if ( _widec < 2093 ) {
+				if ( _widec > 1882 ) {
+					if ( 1889 <= _widec && _widec <= 1914 )
+						goto st175;
+				} else if ( _widec >= 1857 )
+					goto st175;
+			} else if ( _widec > 2094 ) {
+				if ( _widec < 2113 ) {
+					if ( 2096 <= _widec && _widec <= 2105 )
+						goto st196;
+				} else if ( _widec > 2138 ) {
+					if ( 2145 <= _widec && _widec <= 2170 )
+						goto st196;
+				} else
+					goto st196;
+			} else
+				goto st196;
+		} else
+			goto st175;
+	} else
+		goto tr38;
+	goto st0;
+tr281:
+#line 704 "http_parser.rl"
+	{
+    CALLBACK(scheme);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->scheme_mark = NULL;
+    parser->scheme_size = 0;
+  }
+#line 714 "http_parser.rl"
+	{
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+	goto st197;
+st197:
+	if ( ++p == pe )
+		goto _test_eof197;
+case 197:
+#line 8844 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 48 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( 36 <= (*p) && (*p) <= 47 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 57 ) {
+		if ( (*p) < 61 ) {
+			if ( 58 <= (*p) && (*p) <= 59 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(1152 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st177;
+		case 1061: goto st178;
+		case 1071: goto st180;
+		case 1085: goto st177;
+	}
+	if ( _widec < 1060 ) {
+		if ( _widec < 804 ) {
+			if ( _widec > 127 ) {
+				if ( 640 <= _widec && _widec <= 767 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 815 ) {
+			if ( _widec < 831 ) {
+				if ( 826 <= _widec && _widec <= 827 )
+					goto tr38;
+			} else if ( _widec > 894 ) {
+				if ( 896 <= _widec && _widec <= 1023 )
+					goto st177;
+			} else
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 1070 ) {
+		if ( _widec < 1328 ) {
+			if ( _widec > 1083 ) {
+				if ( 1087 <= _widec && _widec <= 1150 )
+					goto st177;
+			} else if ( _widec >= 1082 )
+				goto st177;
+		} else if ( _widec > 1337 ) {
+			if ( _widec < 1840 ) {
+				if ( 1584 <= _widec && _widec <= 1593 )
+					goto tr235;
+			} else if ( _widec > 1849 ) {
+				if ( 2096 <= _widec && _widec <= 2105 )
+					goto tr282;
+			} else
+				goto st177;
+		} else
+			goto tr38;
+	} else
+		goto st177;
+	goto st0;
+tr282:
+#line 724 "http_parser.rl"
+	{
+    tmp = parser->port * 10 + (*p - '0');
+    if (tmp > USHRT_MAX) {
+      SET_ERROR(HPE_INVALID_URI);
+      return 0;
+    }
+    parser->port = tmp;
+  }
+	goto st198;
+st198:
+	if ( ++p == pe )
+		goto _test_eof198;
+case 198:
+#line 8961 "http_parser.c"
+	_widec = (*p);
+	if ( (*p) < 48 ) {
+		if ( (*p) < 33 ) {
+			if ( (*p) <= -1 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 33 ) {
+			if ( 36 <= (*p) && (*p) <= 47 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else if ( (*p) > 57 ) {
+		if ( (*p) < 61 ) {
+			if ( 58 <= (*p) && (*p) <= 59 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else if ( (*p) > 61 ) {
+			if ( 63 <= (*p) && (*p) <= 126 ) {
+				_widec = (short)(640 + ((*p) - -128));
+				if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+			}
+		} else {
+			_widec = (short)(640 + ((*p) - -128));
+			if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 256;
+		}
+	} else {
+		_widec = (short)(1152 + ((*p) - -128));
+		if ( 
+#line 734 "http_parser.rl"
+ parser->method == HTTP_CONNECT  ) _widec += 256;
+		if ( 
+#line 735 "http_parser.rl"
+ parser->method != HTTP_CONNECT  ) _widec += 512;
+	}
+	switch( _widec ) {
+		case 32: goto tr49;
+		case 35: goto tr50;
+		case 801: goto tr38;
+		case 829: goto tr38;
+		case 1057: goto st177;
+		case 1061: goto st178;
+		case 1085: goto st177;
+	}
+	if ( _widec < 1060 ) {
+		if ( _widec < 804 ) {
+			if ( _widec > 127 ) {
+				if ( 640 <= _widec && _widec <= 767 )
+					goto tr38;
+			} else
+				goto tr38;
+		} else if ( _widec > 815 ) {
+			if ( _widec < 831 ) {
+				if ( 826 <= _widec && _widec <= 827 )
+					goto tr38;
+			} else if ( _widec > 894 ) {
+				if ( 896 <= _widec && _widec <= 1023 )
+					goto st177;
+			} else
+				goto tr38;
+		} else
+			goto tr38;
+	} else if ( _widec > 1071 ) {
+		if ( _widec < 1328 ) {
+			if ( _widec > 1083 ) {
+				if ( 1087 <= _widec && _widec <= 1150 )
+					goto st177;
+			} else if ( _widec >= 1082 )
+				goto st177;
+		} else if ( _widec > 1337 ) {
+			if ( _widec < 1840 ) {
+				if ( 1584 <= _widec && _widec <= 1593 )
+					goto tr235;
+			} else if ( _widec > 1849 ) {
+				if ( 2096 <= _widec && _widec <= 2105 )
+					goto tr282;
+			} else
+				goto st177;
+		} else
+			goto tr38;
+	} else
+		goto st177;
+	goto st0;
+tr304:
+	cs = 341;
+#line 767 "http_parser.rl"
+	{
+    if (parser->type == HTTP_REQUEST && parser->flags & HTTP_FLAG_UNCHUNKED) {
+      /* there is no telling where the body ends, RFC 7230 3.3.3 */
+      SET_ERROR(HPE_INVALID_TRANSFER_ENCODING);
+      return 0;
+    }
+    if(parser->on_headers_complete) {
+      callback_return_value = parser->on_headers_complete(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+#line 910 "http_parser.rl"
+	{
+    if ((parser->type == HTTP_REQUEST && 
+         (parser->method == HTTP_CONNECT || 
+          (parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+           parser->flags & HTTP_FLAG_UPGRADE_HEADER))) ||
+        (parser->type == HTTP_RESPONSE &&
+         parser->status_code == 101 && 
+         parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+         parser->flags & HTTP_FLAG_UPGRADE_HEADER)) {
+      /* the rest of the stream is another protocol, stop right after the
+       * headers and leave it to the caller */
+      parser->flags |= HTTP_FLAG_UPGRADE;
+      if (parser->on_message_complete) {
+        callback_return_value = parser->on_message_complete(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      {p++; goto _out;}
+    } else if (parser->flags & HTTP_FLAG_SKIP_BODY || 
+        (parser->type == HTTP_RESPONSE &&
+         (parser->status_code / 100 == 1 || 
+          parser->status_code == 204 || 
+          parser->status_code == 304))) {
+      /* no body whatever the headers say, go straight to the next message */
+      END_REQUEST;
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    } else if (parser->headers_only &&
+               (parser->transfer_encoding == HTTP_CHUNKED ||
+                parser->content_length > 0 ||
+                (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE))) {
+      /* stop at the start of the body, the caller takes it from here */
+      parser->flags |= HTTP_FLAG_BODY_PENDING;
+      if (parser->transfer_encoding == HTTP_CHUNKED) {
+        parser->framing = TRUE;
+        parser->framing_offset = STREAM_OFFSET(p + 1);
+        cs = 2;
+      } else if (UNFRAMED_RESPONSE) {
+        parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      } else {
+        parser->chunk_size = parser->content_length;
+        parser->eating = TRUE;
+      }
+      {p++; goto _out;}
+    } else if (parser->transfer_encoding == HTTP_CHUNKED) {
+      parser->framing = TRUE;
+      parser->framing_offset = STREAM_OFFSET(p + 1);
+      cs = 2;
+    } else if (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE) {
+      /* no framing, everything up to the connection closing is body */
+      parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      p += 1;
+      if (REMAINING > 0) {
+        BODY(p, REMAINING);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      parser->body_read += REMAINING;
+      p = pe;
+      p--;
+      {p++; goto _out;}
+    } else {
+      /* this is pretty stupid. i'd prefer to combine this with skip_chunk_data */
+      parser->chunk_size = parser->content_length;
+      p += 1;  
+
+      SKIP_BODY(MIN(REMAINING, parser->content_length));
+
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+
+      p--;
+      if(parser->chunk_size > REMAINING) {
+        {p++; goto _out;}
+      }
+    }
+  }
+	goto _again;
+st341:
+	if ( ++p == pe )
+		goto _test_eof341;
+case 341:
+#line 9170 "http_parser.c"
+	if ( (*p) == 72 )
+		goto tr460;
+	goto tr51;
+tr460:
+#line 782 "http_parser.rl"
+	{
+    parser->flags |= HTTP_FLAG_IN_MESSAGE;
+    if(parser->on_message_begin) {
+      callback_return_value = parser->on_message_begin(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+	goto st199;
+st199:
+	if ( ++p == pe )
+		goto _test_eof199;
+case 199:
+#line 9191 "http_parser.c"
+	if ( (*p) == 84 )
+		goto st200;
+	goto tr51;
+st200:
+	if ( ++p == pe )
+		goto _test_eof200;
+case 200:
+	if ( (*p) == 84 )
+		goto st201;
+	goto tr51;
+st201:
+	if ( ++p == pe )
+		goto _test_eof201;
+case 201:
+	if ( (*p) == 80 )
+		goto st202;
+	goto tr51;
+st202:
+	if ( ++p == pe )
+		goto _test_eof202;
+case 202:
+	if ( (*p) == 47 )
+		goto st203;
+	goto tr51;
+st203:
+	if ( ++p == pe )
+		goto _test_eof203;
+case 203:
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr287;
+	goto tr51;
+tr287:
+#line 848 "http_parser.rl"
+	{
+    if (parser->version_major > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
+      return 0;
+    }
+    parser->version_major *= 10;
+    parser->version_major += *p - '0';
+  }
+	goto st204;
+st204:
+	if ( ++p == pe )
+		goto _test_eof204;
+case 204:
+#line 9238 "http_parser.c"
+	if ( (*p) == 46 )
+		goto st205;
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr287;
+	goto tr51;
+st205:
+	if ( ++p == pe )
+		goto _test_eof205;
+case 205:
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr289;
+	goto tr51;
+tr289:
+#line 857 "http_parser.rl"
+	{
+    if (parser->version_minor > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
+      return 0;
+    }
+    parser->version_minor *= 10;
+    parser->version_minor += *p - '0';
+  }
+	goto st206;
+st206:
+	if ( ++p == pe )
+		goto _test_eof206;
+case 206:
+#line 9266 "http_parser.c"
+	if ( (*p) == 32 )
+		goto st207;
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr289;
+	goto tr51;
+st207:
+	if ( ++p == pe )
+		goto _test_eof207;
+case 207:
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr292;
+	goto tr291;
+tr292:
+#line 803 "http_parser.rl"
+	{
+    parser->status_code *= 10;
+    parser->status_code += *p - '0';
+  }
+	goto st208;
+st208:
+	if ( ++p == pe )
+		goto _test_eof208;
+case 208:
+#line 9290 "http_parser.c"
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr293;
+	goto tr291;
+tr293:
+#line 803 "http_parser.rl"
+	{
+    parser->status_code *= 10;
+    parser->status_code += *p - '0';
+  }
+	goto st209;
+st209:
+	if ( ++p == pe )
+		goto _test_eof209;
+case 209:
+#line 9305 "http_parser.c"
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr294;
+	goto tr291;
+tr294:
+#line 803 "http_parser.rl"
+	{
+    parser->status_code *= 10;
+    parser->status_code += *p - '0';
+  }
+	goto st210;
+st210:
+	if ( ++p == pe )
+		goto _test_eof210;
+case 210:
+#line 9320 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto st211;
+		case 32: goto st337;
+	}
+	goto tr291;
+st211:
+	if ( ++p == pe )
+		goto _test_eof211;
+case 211:
+	if ( (*p) == 10 )
+		goto st212;
+	goto st0;
+st212:
+	if ( ++p == pe )
+		goto _test_eof212;
+case 212:
+	switch( (*p) ) {
+		case 13: goto st213;
+		case 33: goto tr299;
+		case 67: goto tr300;
+		case 69: goto tr301;
+		case 84: goto tr302;
+		case 85: goto tr303;
+		case 99: goto tr300;
+		case 101: goto tr301;
+		case 116: goto tr302;
+		case 117: goto tr303;
+		case 124: goto tr299;
+		case 126: goto tr299;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr299;
+		} else if ( (*p) >= 35 )
+			goto tr299;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr299;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr299;
+		} else
+			goto tr299;
+	} else
+		goto tr299;
+	goto tr62;
+st213:
+	if ( ++p == pe )
+		goto _test_eof213;
+case 213:
+	if ( (*p) == 10 )
+		goto tr304;
+	goto tr62;
+tr299:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st214;
+st214:
+	if ( ++p == pe )
+		goto _test_eof214;
+case 214:
+#line 9387 "http_parser.c"
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+tr306:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st215;
+st215:
+	if ( ++p == pe )
+		goto _test_eof215;
+case 215:
+#line 9449 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr308;
+		case 32: goto st215;
+	}
+	goto tr307;
+tr307:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st216;
+st216:
+	if ( ++p == pe )
+		goto _test_eof216;
+case 216:
+#line 9466 "http_parser.c"
+	if ( (*p) == 13 )
+		goto tr311;
+	goto st216;
+tr308:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr311:
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr342:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr354:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr363:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr398:
+#line 830 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_EXPECT_CONTINUE; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr421:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr435:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+tr454:
+#line 829 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_UPGRADE_HEADER; }
+#line 630 "http_parser.rl"
+	{
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->header_value_mark = NULL;
+    parser->header_value_size = 0;
+  }
+	goto st217;
+st217:
+	if ( ++p == pe )
+		goto _test_eof217;
+case 217:
+#line 9697 "http_parser.c"
+	if ( (*p) == 10 )
+		goto st218;
+	goto tr62;
+st218:
+	if ( ++p == pe )
+		goto _test_eof218;
+case 218:
+	switch( (*p) ) {
+		case 9: goto tr313;
+		case 13: goto st213;
+		case 32: goto tr313;
+		case 33: goto tr299;
+		case 67: goto tr300;
+		case 69: goto tr301;
+		case 84: goto tr302;
+		case 85: goto tr303;
+		case 99: goto tr300;
+		case 101: goto tr301;
+		case 116: goto tr302;
+		case 117: goto tr303;
+		case 124: goto tr299;
+		case 126: goto tr299;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr299;
+		} else if ( (*p) >= 35 )
+			goto tr299;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr299;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr299;
+		} else
+			goto tr299;
+	} else
+		goto tr299;
+	goto tr62;
+tr313:
+#line 833 "http_parser.rl"
+	{
+    if (parser->on_header_value && !parser->skip_header) {
+      callback_return_value = parser->on_header_value(parser, " ", 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add_value(parser->headers, parser->arena, " ", 1) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+  }
+	goto st219;
+st219:
+	if ( ++p == pe )
+		goto _test_eof219;
+case 219:
+#line 9760 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st219;
+		case 13: goto tr308;
+		case 32: goto st219;
+	}
+	goto tr307;
+tr300:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st220;
+st220:
+	if ( ++p == pe )
+		goto _test_eof220;
+case 220:
+#line 9778 "http_parser.c"
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 79: goto st221;
+		case 111: goto st221;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st221:
+	if ( ++p == pe )
+		goto _test_eof221;
+case 221:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st222;
+		case 110: goto st222;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st222:
+	if ( ++p == pe )
+		goto _test_eof222;
+case 222:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st223;
+		case 84: goto st256;
+		case 110: goto st223;
+		case 116: goto st256;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st223:
+	if ( ++p == pe )
+		goto _test_eof223;
+case 223:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st224;
+		case 101: goto st224;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st224:
+	if ( ++p == pe )
+		goto _test_eof224;
+case 224:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 67: goto st225;
+		case 99: goto st225;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st225:
+	if ( ++p == pe )
+		goto _test_eof225;
+case 225:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 84: goto st226;
+		case 116: goto st226;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st226:
+	if ( ++p == pe )
+		goto _test_eof226;
+case 226:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 73: goto st227;
+		case 105: goto st227;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st227:
+	if ( ++p == pe )
+		goto _test_eof227;
+case 227:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 79: goto st228;
+		case 111: goto st228;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st228:
+	if ( ++p == pe )
+		goto _test_eof228;
+case 228:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st229;
+		case 110: goto st229;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st229:
+	if ( ++p == pe )
+		goto _test_eof229;
+case 229:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr325;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+tr325:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st230;
+st230:
+	if ( ++p == pe )
+		goto _test_eof230;
+case 230:
+#line 10112 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr308;
+		case 32: goto st230;
+		case 33: goto tr327;
+		case 67: goto tr328;
+		case 75: goto tr329;
+		case 85: goto tr330;
+		case 99: goto tr328;
+		case 107: goto tr329;
+		case 117: goto tr330;
+		case 124: goto tr327;
+		case 126: goto tr327;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr327;
+		} else if ( (*p) >= 35 )
+			goto tr327;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr327;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr327;
+		} else
+			goto tr327;
+	} else
+		goto tr327;
+	goto tr307;
+tr327:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st231;
+st231:
+	if ( ++p == pe )
+		goto _test_eof231;
+case 231:
+#line 10155 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+tr341:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+	goto st232;
+tr353:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+	goto st232;
+tr362:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+	goto st232;
+st232:
+	if ( ++p == pe )
+		goto _test_eof232;
+case 232:
+#line 10196 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 44: goto st233;
+	}
+	goto st216;
+tr343:
+#line 827 "http_parser.rl"
+	{ parser->keep_alive = FALSE; }
+	goto st233;
+tr355:
+#line 826 "http_parser.rl"
+	{ if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
+	goto st233;
+tr364:
+#line 828 "http_parser.rl"
+	{ parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+	goto st233;
+st233:
+	if ( ++p == pe )
+		goto _test_eof233;
+case 233:
+#line 10220 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st233;
+		case 13: goto tr311;
+		case 32: goto st233;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 67: goto st234;
+		case 75: goto st239;
+		case 85: goto st249;
+		case 99: goto st234;
+		case 107: goto st239;
+		case 117: goto st249;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+tr328:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st234;
+st234:
+	if ( ++p == pe )
+		goto _test_eof234;
+case 234:
+#line 10262 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 76: goto st235;
+		case 108: goto st235;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st235:
+	if ( ++p == pe )
+		goto _test_eof235;
+case 235:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 79: goto st236;
+		case 111: goto st236;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st236:
+	if ( ++p == pe )
+		goto _test_eof236;
+case 236:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 83: goto st237;
+		case 115: goto st237;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st237:
+	if ( ++p == pe )
+		goto _test_eof237;
+case 237:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 69: goto st238;
+		case 101: goto st238;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st238:
+	if ( ++p == pe )
+		goto _test_eof238;
+case 238:
+	switch( (*p) ) {
+		case 9: goto tr341;
+		case 13: goto tr342;
+		case 32: goto tr341;
+		case 33: goto st231;
+		case 44: goto tr343;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+tr329:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st239;
+st239:
+	if ( ++p == pe )
+		goto _test_eof239;
+case 239:
+#line 10418 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 69: goto st240;
+		case 101: goto st240;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st240:
+	if ( ++p == pe )
+		goto _test_eof240;
+case 240:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 69: goto st241;
+		case 101: goto st241;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st241:
+	if ( ++p == pe )
+		goto _test_eof241;
+case 241:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 80: goto st242;
+		case 112: goto st242;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st242:
+	if ( ++p == pe )
+		goto _test_eof242;
+case 242:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 45: goto st243;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st243:
+	if ( ++p == pe )
+		goto _test_eof243;
+case 243:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 65: goto st244;
+		case 97: goto st244;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 66 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st244:
+	if ( ++p == pe )
+		goto _test_eof244;
+case 244:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 76: goto st245;
+		case 108: goto st245;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st245:
+	if ( ++p == pe )
+		goto _test_eof245;
+case 245:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 73: goto st246;
+		case 105: goto st246;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st246:
+	if ( ++p == pe )
+		goto _test_eof246;
+case 246:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 86: goto st247;
+		case 118: goto st247;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st247:
+	if ( ++p == pe )
+		goto _test_eof247;
+case 247:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 69: goto st248;
+		case 101: goto st248;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st248:
+	if ( ++p == pe )
+		goto _test_eof248;
+case 248:
+	switch( (*p) ) {
+		case 9: goto tr353;
+		case 13: goto tr354;
+		case 32: goto tr353;
+		case 33: goto st231;
+		case 44: goto tr355;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+tr330:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st249;
+st249:
+	if ( ++p == pe )
+		goto _test_eof249;
+case 249:
+#line 10723 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 80: goto st250;
+		case 112: goto st250;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st250:
+	if ( ++p == pe )
+		goto _test_eof250;
+case 250:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 71: goto st251;
+		case 103: goto st251;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st251:
+	if ( ++p == pe )
+		goto _test_eof251;
+case 251:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 82: goto st252;
+		case 114: goto st252;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st252:
+	if ( ++p == pe )
+		goto _test_eof252;
+case 252:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 65: goto st253;
+		case 97: goto st253;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 66 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st253:
+	if ( ++p == pe )
+		goto _test_eof253;
+case 253:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 68: goto st254;
+		case 100: goto st254;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st254:
+	if ( ++p == pe )
+		goto _test_eof254;
+case 254:
+	switch( (*p) ) {
+		case 9: goto st232;
+		case 13: goto tr311;
+		case 32: goto st232;
+		case 33: goto st231;
+		case 44: goto st233;
+		case 69: goto st255;
+		case 101: goto st255;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st255:
+	if ( ++p == pe )
+		goto _test_eof255;
+case 255:
+	switch( (*p) ) {
+		case 9: goto tr362;
+		case 13: goto tr363;
+		case 32: goto tr362;
+		case 33: goto st231;
+		case 44: goto tr364;
+		case 124: goto st231;
+		case 126: goto st231;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st231;
+		} else if ( (*p) >= 35 )
+			goto st231;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st231;
+		} else if ( (*p) >= 65 )
+			goto st231;
+	} else
+		goto st231;
+	goto st216;
+st256:
+	if ( ++p == pe )
+		goto _test_eof256;
+case 256:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st257;
+		case 101: goto st257;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st257:
+	if ( ++p == pe )
+		goto _test_eof257;
+case 257:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st258;
+		case 110: goto st258;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st258:
+	if ( ++p == pe )
+		goto _test_eof258;
+case 258:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 84: goto st259;
+		case 116: goto st259;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st259:
+	if ( ++p == pe )
+		goto _test_eof259;
+case 259:
+	switch( (*p) ) {
+		case 33: goto st214;
+		case 45: goto st260;
+		case 46: goto st214;
+		case 58: goto tr306;
+		case 124: goto st214;
+		case 126: goto st214;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else if ( (*p) >= 65 )
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st260:
 	if ( ++p == pe )
-		goto _test_eof195;
-case 195:
+		goto _test_eof260;
+case 260:
 	switch( (*p) ) {
-		case 13: goto st196;
-		case 33: goto tr229;
-		case 67: goto tr230;
-		case 84: goto tr231;
-		case 99: goto tr230;
-		case 116: goto tr231;
-		case 124: goto tr229;
-		case 126: goto tr229;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 76: goto st261;
+		case 108: goto st261;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto tr229;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto tr229;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto tr229;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto tr229;
+				goto st214;
 		} else
-			goto tr229;
+			goto st214;
 	} else
-		goto tr229;
-	goto st0;
-st196:
-	if ( ++p == pe )
-		goto _test_eof196;
-case 196:
-	if ( (*p) == 10 )
-		goto tr232;
-	goto st0;
-tr229:
-#line 113 "http_parser.rl"
-	{
-    parser->header_field_mark = p;
-    parser->header_field_size = 0;
-  }
-	goto st197;
-st197:
+		goto st214;
+	goto tr62;
+st261:
 	if ( ++p == pe )
-		goto _test_eof197;
-case 197:
-#line 4192 "http_parser.c"
+		goto _test_eof261;
+case 261:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st262;
+		case 101: goto st262;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-tr234:
-#line 143 "http_parser.rl"
-	{
-    CALLBACK(header_field);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_field_mark = NULL;
-    parser->header_field_size = 0;
-  }
-	goto st198;
-st198:
+		goto st214;
+	goto tr62;
+st262:
 	if ( ++p == pe )
-		goto _test_eof198;
-case 198:
-#line 4233 "http_parser.c"
+		goto _test_eof262;
+case 262:
 	switch( (*p) ) {
-		case 13: goto tr236;
-		case 32: goto st198;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st263;
+		case 110: goto st263;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto tr235;
-tr235:
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
-	goto st199;
-st199:
-	if ( ++p == pe )
-		goto _test_eof199;
-case 199:
-#line 4250 "http_parser.c"
-	if ( (*p) == 13 )
-		goto tr239;
-	goto st199;
-tr230:
-#line 113 "http_parser.rl"
-	{
-    parser->header_field_mark = p;
-    parser->header_field_size = 0;
-  }
-	goto st200;
-st200:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st263:
 	if ( ++p == pe )
-		goto _test_eof200;
-case 200:
-#line 4265 "http_parser.c"
+		goto _test_eof263;
+case 263:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 79: goto st201;
-		case 111: goto st201;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 71: goto st264;
+		case 103: goto st264;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st201:
+		goto st214;
+	goto tr62;
+st264:
 	if ( ++p == pe )
-		goto _test_eof201;
-case 201:
+		goto _test_eof264;
+case 264:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st202;
-		case 110: goto st202;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 84: goto st265;
+		case 116: goto st265;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st202:
+		goto st214;
+	goto tr62;
+st265:
 	if ( ++p == pe )
-		goto _test_eof202;
-case 202:
+		goto _test_eof265;
+case 265:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st203;
-		case 84: goto st226;
-		case 110: goto st203;
-		case 116: goto st226;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 72: goto st266;
+		case 104: goto st266;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st203:
+		goto st214;
+	goto tr62;
+st266:
 	if ( ++p == pe )
-		goto _test_eof203;
-case 203:
+		goto _test_eof266;
+case 266:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 69: goto st204;
-		case 101: goto st204;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr375;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st204:
+		goto st214;
+	goto tr62;
+tr375:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st267;
+st267:
 	if ( ++p == pe )
-		goto _test_eof204;
-case 204:
+		goto _test_eof267;
+case 267:
+#line 11290 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr308;
+		case 32: goto st267;
+	}
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr377;
+	goto tr307;
+tr377:
+#line 793 "http_parser.rl"
+	{
+    if (parser->content_length > INT_MAX) {
+      SET_ERROR(HPE_INVALID_CONTENT_LENGTH);
+      return 0;
+    }
+    parser->flags |= HTTP_FLAG_CONTENT_LENGTH;
+    parser->content_length *= 10;
+    parser->content_length += *p - '0';
+  }
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st268;
+tr378:
+#line 793 "http_parser.rl"
+	{
+    if (parser->content_length > INT_MAX) {
+      SET_ERROR(HPE_INVALID_CONTENT_LENGTH);
+      return 0;
+    }
+    parser->flags |= HTTP_FLAG_CONTENT_LENGTH;
+    parser->content_length *= 10;
+    parser->content_length += *p - '0';
+  }
+	goto st268;
+st268:
+	if ( ++p == pe )
+		goto _test_eof268;
+case 268:
+#line 11331 "http_parser.c"
+	if ( (*p) == 13 )
+		goto tr311;
+	if ( 48 <= (*p) && (*p) <= 57 )
+		goto tr378;
+	goto st216;
+tr301:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st269;
+st269:
+	if ( ++p == pe )
+		goto _test_eof269;
+case 269:
+#line 11348 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 67: goto st205;
-		case 99: goto st205;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 88: goto st270;
+		case 120: goto st270;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st205:
+		goto st214;
+	goto tr62;
+st270:
 	if ( ++p == pe )
-		goto _test_eof205;
-case 205:
+		goto _test_eof270;
+case 270:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 84: goto st206;
-		case 116: goto st206;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 80: goto st271;
+		case 112: goto st271;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st206:
+		goto st214;
+	goto tr62;
+st271:
 	if ( ++p == pe )
-		goto _test_eof206;
-case 206:
+		goto _test_eof271;
+case 271:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 73: goto st207;
-		case 105: goto st207;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st272;
+		case 101: goto st272;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st207:
+		goto st214;
+	goto tr62;
+st272:
 	if ( ++p == pe )
-		goto _test_eof207;
-case 207:
+		goto _test_eof272;
+case 272:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 79: goto st208;
-		case 111: goto st208;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 67: goto st273;
+		case 99: goto st273;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st208:
+		goto st214;
+	goto tr62;
+st273:
 	if ( ++p == pe )
-		goto _test_eof208;
-case 208:
+		goto _test_eof273;
+case 273:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st209;
-		case 110: goto st209;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 84: goto st274;
+		case 116: goto st274;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st209:
+		goto st214;
+	goto tr62;
+st274:
 	if ( ++p == pe )
-		goto _test_eof209;
-case 209:
+		goto _test_eof274;
+case 274:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr250;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr384;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-tr250:
-#line 143 "http_parser.rl"
+		goto st214;
+	goto tr62;
+tr384:
+#line 599 "http_parser.rl"
 	{
-    CALLBACK(header_field);
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
       return 0;
     }
     parser->header_field_mark = NULL;
     parser->header_field_size = 0;
   }
-	goto st210;
-st210:
+	goto st275;
+st275:
 	if ( ++p == pe )
-		goto _test_eof210;
-case 210:
-#line 4578 "http_parser.c"
+		goto _test_eof275;
+case 275:
+#line 11560 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr236;
-		case 32: goto st210;
-		case 67: goto tr252;
-		case 75: goto tr253;
-		case 99: goto tr252;
-		case 107: goto tr253;
+		case 13: goto tr308;
+		case 32: goto st275;
+		case 49: goto tr386;
 	}
-	goto tr235;
-tr252:
-#line 118 "http_parser.rl"
+	goto tr307;
+tr386:
+#line 558 "http_parser.rl"
 	{
     parser->header_value_mark = p;
     parser->header_value_size = 0;
   }
-	goto st211;
-st211:
+	goto st276;
+st276:
 	if ( ++p == pe )
-		goto _test_eof211;
-case 211:
-#line 4599 "http_parser.c"
+		goto _test_eof276;
+case 276:
+#line 11578 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 76: goto st212;
-		case 108: goto st212;
+		case 13: goto tr311;
+		case 48: goto st277;
 	}
-	goto st199;
-st212:
+	goto st216;
+st277:
 	if ( ++p == pe )
-		goto _test_eof212;
-case 212:
+		goto _test_eof277;
+case 277:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 79: goto st213;
-		case 111: goto st213;
+		case 13: goto tr311;
+		case 48: goto st278;
 	}
-	goto st199;
-st213:
+	goto st216;
+st278:
 	if ( ++p == pe )
-		goto _test_eof213;
-case 213:
+		goto _test_eof278;
+case 278:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 83: goto st214;
-		case 115: goto st214;
+		case 13: goto tr311;
+		case 45: goto st279;
 	}
-	goto st199;
-st214:
+	goto st216;
+st279:
 	if ( ++p == pe )
-		goto _test_eof214;
-case 214:
+		goto _test_eof279;
+case 279:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 69: goto st215;
-		case 101: goto st215;
+		case 13: goto tr311;
+		case 67: goto st280;
+		case 99: goto st280;
 	}
-	goto st199;
-st215:
+	goto st216;
+st280:
 	if ( ++p == pe )
-		goto _test_eof215;
-case 215:
+		goto _test_eof280;
+case 280:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 79: goto st281;
+		case 111: goto st281;
+	}
+	goto st216;
+st281:
+	if ( ++p == pe )
+		goto _test_eof281;
+case 281:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 78: goto st282;
+		case 110: goto st282;
+	}
+	goto st216;
+st282:
+	if ( ++p == pe )
+		goto _test_eof282;
+case 282:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 84: goto st283;
+		case 116: goto st283;
+	}
+	goto st216;
+st283:
+	if ( ++p == pe )
+		goto _test_eof283;
+case 283:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 73: goto st284;
+		case 105: goto st284;
+	}
+	goto st216;
+st284:
+	if ( ++p == pe )
+		goto _test_eof284;
+case 284:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 78: goto st285;
+		case 110: goto st285;
+	}
+	goto st216;
+st285:
+	if ( ++p == pe )
+		goto _test_eof285;
+case 285:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 85: goto st286;
+		case 117: goto st286;
+	}
+	goto st216;
+st286:
+	if ( ++p == pe )
+		goto _test_eof286;
+case 286:
+	switch( (*p) ) {
+		case 13: goto tr311;
+		case 69: goto st287;
+		case 101: goto st287;
+	}
+	goto st216;
+st287:
+	if ( ++p == pe )
+		goto _test_eof287;
+case 287:
 	if ( (*p) == 13 )
-		goto tr258;
-	goto st199;
-tr253:
-#line 118 "http_parser.rl"
+		goto tr398;
+	goto st216;
+tr302:
+#line 553 "http_parser.rl"
 	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
   }
-	goto st216;
-st216:
+	goto st288;
+st288:
 	if ( ++p == pe )
-		goto _test_eof216;
-case 216:
-#line 4654 "http_parser.c"
+		goto _test_eof288;
+case 288:
+#line 11700 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 69: goto st217;
-		case 101: goto st217;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 82: goto st289;
+		case 114: goto st289;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st217:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st289:
 	if ( ++p == pe )
-		goto _test_eof217;
-case 217:
+		goto _test_eof289;
+case 289:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 69: goto st218;
-		case 101: goto st218;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 65: goto st290;
+		case 97: goto st290;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st218:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 66 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st290:
 	if ( ++p == pe )
-		goto _test_eof218;
-case 218:
+		goto _test_eof290;
+case 290:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 80: goto st219;
-		case 112: goto st219;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st291;
+		case 110: goto st291;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st219:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st291:
 	if ( ++p == pe )
-		goto _test_eof219;
-case 219:
+		goto _test_eof291;
+case 291:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 45: goto st220;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 83: goto st292;
+		case 115: goto st292;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st220:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st292:
 	if ( ++p == pe )
-		goto _test_eof220;
-case 220:
+		goto _test_eof292;
+case 292:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 65: goto st221;
-		case 97: goto st221;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 70: goto st293;
+		case 102: goto st293;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st221:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st293:
 	if ( ++p == pe )
-		goto _test_eof221;
-case 221:
+		goto _test_eof293;
+case 293:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 76: goto st222;
-		case 108: goto st222;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st294;
+		case 101: goto st294;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st222:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st294:
 	if ( ++p == pe )
-		goto _test_eof222;
-case 222:
+		goto _test_eof294;
+case 294:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 73: goto st223;
-		case 105: goto st223;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 82: goto st295;
+		case 114: goto st295;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st223:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st295:
 	if ( ++p == pe )
-		goto _test_eof223;
-case 223:
+		goto _test_eof295;
+case 295:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 86: goto st224;
-		case 118: goto st224;
+		case 33: goto st214;
+		case 45: goto st296;
+		case 46: goto st214;
+		case 58: goto tr306;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st224:
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else if ( (*p) >= 65 )
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st296:
 	if ( ++p == pe )
-		goto _test_eof224;
-case 224:
+		goto _test_eof296;
+case 296:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 69: goto st225;
-		case 101: goto st225;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st297;
+		case 101: goto st297;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	goto st199;
-st225:
-	if ( ++p == pe )
-		goto _test_eof225;
-case 225:
-	if ( (*p) == 13 )
-		goto tr268;
-	goto st199;
-st226:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st214;
+		} else if ( (*p) >= 35 )
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st214;
+		} else
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st297:
 	if ( ++p == pe )
-		goto _test_eof226;
-case 226:
+		goto _test_eof297;
+case 297:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 69: goto st227;
-		case 101: goto st227;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st298;
+		case 110: goto st298;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st227:
+		goto st214;
+	goto tr62;
+st298:
 	if ( ++p == pe )
-		goto _test_eof227;
-case 227:
+		goto _test_eof298;
+case 298:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st228;
-		case 110: goto st228;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 67: goto st299;
+		case 99: goto st299;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st228:
+		goto st214;
+	goto tr62;
+st299:
 	if ( ++p == pe )
-		goto _test_eof228;
-case 228:
+		goto _test_eof299;
+case 299:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 84: goto st229;
-		case 116: goto st229;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 79: goto st300;
+		case 111: goto st300;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st229:
+		goto st214;
+	goto tr62;
+st300:
 	if ( ++p == pe )
-		goto _test_eof229;
-case 229:
+		goto _test_eof300;
+case 300:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 45: goto st230;
-		case 46: goto st197;
-		case 58: goto tr234;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 68: goto st301;
+		case 100: goto st301;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
-	if ( (*p) < 48 ) {
+	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 57 ) {
-		if ( (*p) > 90 ) {
+			goto st214;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st214;
+		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else if ( (*p) >= 65 )
-			goto st197;
+				goto st214;
+		} else
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st230:
+		goto st214;
+	goto tr62;
+st301:
 	if ( ++p == pe )
-		goto _test_eof230;
-case 230:
+		goto _test_eof301;
+case 301:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 76: goto st231;
-		case 108: goto st231;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 73: goto st302;
+		case 105: goto st302;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st231:
+		goto st214;
+	goto tr62;
+st302:
 	if ( ++p == pe )
-		goto _test_eof231;
-case 231:
+		goto _test_eof302;
+case 302:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 69: goto st232;
-		case 101: goto st232;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 78: goto st303;
+		case 110: goto st303;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st232:
+		goto st214;
+	goto tr62;
+st303:
 	if ( ++p == pe )
-		goto _test_eof232;
-case 232:
+		goto _test_eof303;
+case 303:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st233;
-		case 110: goto st233;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 71: goto st304;
+		case 103: goto st304;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st233:
+		goto st214;
+	goto tr62;
+st304:
 	if ( ++p == pe )
-		goto _test_eof233;
-case 233:
+		goto _test_eof304;
+case 304:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 71: goto st234;
-		case 103: goto st234;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr415;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st234:
-	if ( ++p == pe )
-		goto _test_eof234;
-case 234:
-	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 84: goto st235;
-		case 116: goto st235;
-		case 124: goto st197;
-		case 126: goto st197;
+		goto st214;
+	goto tr62;
+tr415:
+#line 599 "http_parser.rl"
+	{
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+    parser->header_field_mark = NULL;
+    parser->header_field_size = 0;
+  }
+	goto st305;
+st305:
+	if ( ++p == pe )
+		goto _test_eof305;
+case 305:
+#line 12239 "http_parser.c"
+	switch( (*p) ) {
+		case 13: goto tr308;
+		case 32: goto st305;
+		case 33: goto tr417;
+		case 67: goto tr418;
+		case 73: goto tr419;
+		case 99: goto tr418;
+		case 105: goto tr419;
+		case 124: goto tr417;
+		case 126: goto tr417;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto tr417;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto tr417;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto tr417;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto tr417;
 		} else
-			goto st197;
+			goto tr417;
 	} else
-		goto st197;
-	goto st0;
-st235:
+		goto tr417;
+	goto tr307;
+tr417:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st306;
+st306:
 	if ( ++p == pe )
-		goto _test_eof235;
-case 235:
+		goto _test_eof306;
+case 306:
+#line 12280 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 124: goto st306;
+		case 126: goto st306;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
+		} else if ( (*p) >= 35 )
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
+	} else
+		goto st306;
+	goto st216;
+tr420:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+	goto st307;
+tr434:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+	goto st307;
+st307:
+	if ( ++p == pe )
+		goto _test_eof307;
+case 307:
+#line 12323 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st307;
+		case 13: goto tr311;
+		case 32: goto st307;
+		case 44: goto st308;
+	}
+	goto st216;
+tr423:
+#line 816 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+	goto st308;
+tr436:
+#line 820 "http_parser.rl"
+	{
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
+	goto st308;
+st308:
+	if ( ++p == pe )
+		goto _test_eof308;
+case 308:
+#line 12349 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st308;
+		case 13: goto tr311;
+		case 32: goto st308;
+		case 33: goto st306;
+		case 44: goto st308;
+		case 67: goto st309;
+		case 73: goto st316;
+		case 99: goto st309;
+		case 105: goto st316;
+		case 124: goto st306;
+		case 126: goto st306;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
+		} else if ( (*p) >= 35 )
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
+	} else
+		goto st306;
+	goto st216;
+tr418:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st309;
+st309:
+	if ( ++p == pe )
+		goto _test_eof309;
+case 309:
+#line 12389 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 72: goto st310;
+		case 104: goto st310;
+		case 124: goto st306;
+		case 126: goto st306;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
+		} else if ( (*p) >= 35 )
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
+	} else
+		goto st306;
+	goto st216;
+st310:
+	if ( ++p == pe )
+		goto _test_eof310;
+case 310:
+	switch( (*p) ) {
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 85: goto st311;
+		case 117: goto st311;
+		case 124: goto st306;
+		case 126: goto st306;
+	}
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
+		} else if ( (*p) >= 35 )
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
+	} else
+		goto st306;
+	goto st216;
+st311:
+	if ( ++p == pe )
+		goto _test_eof311;
+case 311:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 72: goto st236;
-		case 104: goto st236;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 78: goto st312;
+		case 110: goto st312;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st236:
+		goto st306;
+	goto st216;
+st312:
 	if ( ++p == pe )
-		goto _test_eof236;
-case 236:
+		goto _test_eof312;
+case 312:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr279;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 75: goto st313;
+		case 107: goto st313;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-tr279:
-#line 143 "http_parser.rl"
-	{
-    CALLBACK(header_field);
-    if (callback_return_value != 0) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->header_field_mark = NULL;
-    parser->header_field_size = 0;
-  }
-	goto st237;
-st237:
+		goto st306;
+	goto st216;
+st313:
 	if ( ++p == pe )
-		goto _test_eof237;
-case 237:
-#line 5088 "http_parser.c"
+		goto _test_eof313;
+case 313:
 	switch( (*p) ) {
-		case 13: goto tr236;
-		case 32: goto st237;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 69: goto st314;
+		case 101: goto st314;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr281;
-	goto tr235;
-tr281:
-#line 223 "http_parser.rl"
-	{
-    if (parser->content_length > INT_MAX) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->content_length *= 10;
-    parser->content_length += *p - '0';
-  }
-#line 118 "http_parser.rl"
-	{
-    parser->header_value_mark = p;
-    parser->header_value_size = 0;
-  }
-	goto st238;
-tr282:
-#line 223 "http_parser.rl"
-	{
-    if (parser->content_length > INT_MAX) {
-      parser->error = TRUE;
-      return 0;
-    }
-    parser->content_length *= 10;
-    parser->content_length += *p - '0';
-  }
-	goto st238;
-st238:
-	if ( ++p == pe )
-		goto _test_eof238;
-case 238:
-#line 5127 "http_parser.c"
-	if ( (*p) == 13 )
-		goto tr239;
-	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr282;
-	goto st199;
-tr231:
-#line 113 "http_parser.rl"
-	{
-    parser->header_field_mark = p;
-    parser->header_field_size = 0;
-  }
-	goto st239;
-st239:
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
+		} else if ( (*p) >= 35 )
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
+	} else
+		goto st306;
+	goto st216;
+st314:
 	if ( ++p == pe )
-		goto _test_eof239;
-case 239:
-#line 5144 "http_parser.c"
+		goto _test_eof314;
+case 314:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 82: goto st240;
-		case 114: goto st240;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 68: goto st315;
+		case 100: goto st315;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st240:
+		goto st306;
+	goto st216;
+st315:
 	if ( ++p == pe )
-		goto _test_eof240;
-case 240:
+		goto _test_eof315;
+case 315:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 65: goto st241;
-		case 97: goto st241;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr434;
+		case 13: goto tr435;
+		case 32: goto tr434;
+		case 33: goto st306;
+		case 44: goto tr436;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 66 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st241:
-	if ( ++p == pe )
-		goto _test_eof241;
-case 241:
-	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st242;
-		case 110: goto st242;
-		case 124: goto st197;
-		case 126: goto st197;
+		goto st306;
+	goto st216;
+tr419:
+#line 558 "http_parser.rl"
+	{
+    parser->header_value_mark = p;
+    parser->header_value_size = 0;
+  }
+	goto st316;
+st316:
+	if ( ++p == pe )
+		goto _test_eof316;
+case 316:
+#line 12605 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 68: goto st317;
+		case 100: goto st317;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st242:
+		goto st306;
+	goto st216;
+st317:
 	if ( ++p == pe )
-		goto _test_eof242;
-case 242:
+		goto _test_eof317;
+case 317:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 83: goto st243;
-		case 115: goto st243;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 69: goto st318;
+		case 101: goto st318;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st243:
+		goto st306;
+	goto st216;
+st318:
 	if ( ++p == pe )
-		goto _test_eof243;
-case 243:
+		goto _test_eof318;
+case 318:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 70: goto st244;
-		case 102: goto st244;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 78: goto st319;
+		case 110: goto st319;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st244:
+		goto st306;
+	goto st216;
+st319:
 	if ( ++p == pe )
-		goto _test_eof244;
-case 244:
+		goto _test_eof319;
+case 319:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 69: goto st245;
-		case 101: goto st245;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 84: goto st320;
+		case 116: goto st320;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st245:
+		goto st306;
+	goto st216;
+st320:
 	if ( ++p == pe )
-		goto _test_eof245;
-case 245:
+		goto _test_eof320;
+case 320:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 82: goto st246;
-		case 114: goto st246;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 73: goto st321;
+		case 105: goto st321;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st246:
+		goto st306;
+	goto st216;
+st321:
 	if ( ++p == pe )
-		goto _test_eof246;
-case 246:
+		goto _test_eof321;
+case 321:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 45: goto st247;
-		case 46: goto st197;
-		case 58: goto tr234;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 84: goto st322;
+		case 116: goto st322;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
 	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st306;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st306;
 		} else if ( (*p) >= 65 )
-			goto st197;
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st247:
+		goto st306;
+	goto st216;
+st322:
 	if ( ++p == pe )
-		goto _test_eof247;
-case 247:
+		goto _test_eof322;
+case 322:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 69: goto st248;
-		case 101: goto st248;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto tr420;
+		case 13: goto tr421;
+		case 32: goto tr420;
+		case 33: goto st306;
+		case 44: goto tr423;
+		case 89: goto st323;
+		case 121: goto st323;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st248:
+		goto st306;
+	goto st216;
+st323:
 	if ( ++p == pe )
-		goto _test_eof248;
-case 248:
+		goto _test_eof323;
+case 323:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st249;
-		case 110: goto st249;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 9: goto st307;
+		case 13: goto tr311;
+		case 32: goto st307;
+		case 33: goto st306;
+		case 44: goto st308;
+		case 124: goto st306;
+		case 126: goto st306;
 	}
-	if ( (*p) < 45 ) {
+	if ( (*p) < 48 ) {
 		if ( (*p) > 39 ) {
-			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st306;
 		} else if ( (*p) >= 35 )
-			goto st197;
-	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
-			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
-		} else if ( (*p) > 90 ) {
+			goto st306;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
-		} else
-			goto st197;
+				goto st306;
+		} else if ( (*p) >= 65 )
+			goto st306;
 	} else
-		goto st197;
-	goto st0;
-st249:
+		goto st306;
+	goto st216;
+tr303:
+#line 553 "http_parser.rl"
+	{
+    parser->header_field_mark = p;
+    parser->header_field_size = 0;
+  }
+	goto st324;
+st324:
 	if ( ++p == pe )
-		goto _test_eof249;
-case 249:
+		goto _test_eof324;
+case 324:
+#line 12851 "http_parser.c"
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 67: goto st250;
-		case 99: goto st250;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 80: goto st325;
+		case 112: goto st325;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st250:
+		goto st214;
+	goto tr62;
+st325:
 	if ( ++p == pe )
-		goto _test_eof250;
-case 250:
+		goto _test_eof325;
+case 325:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 79: goto st251;
-		case 111: goto st251;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 71: goto st326;
+		case 103: goto st326;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
-	} else
-		goto st197;
-	goto st0;
-st251:
+			goto st214;
+	} else
+		goto st214;
+	goto tr62;
+st326:
 	if ( ++p == pe )
-		goto _test_eof251;
-case 251:
+		goto _test_eof326;
+case 326:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 68: goto st252;
-		case 100: goto st252;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 82: goto st327;
+		case 114: goto st327;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st252:
+		goto st214;
+	goto tr62;
+st327:
 	if ( ++p == pe )
-		goto _test_eof252;
-case 252:
+		goto _test_eof327;
+case 327:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 73: goto st253;
-		case 105: goto st253;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 65: goto st328;
+		case 97: goto st328;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
-		if ( (*p) < 65 ) {
+		if ( (*p) < 66 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st253:
+		goto st214;
+	goto tr62;
+st328:
 	if ( ++p == pe )
-		goto _test_eof253;
-case 253:
+		goto _test_eof328;
+case 328:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 78: goto st254;
-		case 110: goto st254;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 68: goto st329;
+		case 100: goto st329;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st254:
+		goto st214;
+	goto tr62;
+st329:
 	if ( ++p == pe )
-		goto _test_eof254;
-case 254:
+		goto _test_eof329;
+case 329:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr234;
-		case 71: goto st255;
-		case 103: goto st255;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr306;
+		case 69: goto st330;
+		case 101: goto st330;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-st255:
+		goto st214;
+	goto tr62;
+st330:
 	if ( ++p == pe )
-		goto _test_eof255;
-case 255:
+		goto _test_eof330;
+case 330:
 	switch( (*p) ) {
-		case 33: goto st197;
-		case 58: goto tr299;
-		case 124: goto st197;
-		case 126: goto st197;
+		case 33: goto st214;
+		case 58: goto tr450;
+		case 124: goto st214;
+		case 126: goto st214;
 	}
 	if ( (*p) < 45 ) {
 		if ( (*p) > 39 ) {
 			if ( 42 <= (*p) && (*p) <= 43 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) >= 35 )
-			goto st197;
+			goto st214;
 	} else if ( (*p) > 46 ) {
 		if ( (*p) < 65 ) {
 			if ( 48 <= (*p) && (*p) <= 57 )
-				goto st197;
+				goto st214;
 		} else if ( (*p) > 90 ) {
 			if ( 94 <= (*p) && (*p) <= 122 )
-				goto st197;
+				goto st214;
 		} else
-			goto st197;
+			goto st214;
 	} else
-		goto st197;
-	goto st0;
-tr299:
-#line 238 "http_parser.rl"
-	{ parser->transfer_encoding = HTTP_CHUNKED;  }
-#line 143 "http_parser.rl"
+		goto st214;
+	goto tr62;
+tr450:
+#line 599 "http_parser.rl"
 	{
-    CALLBACK(header_field);
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
       return 0;
     }
     parser->header_field_mark = NULL;
     parser->header_field_size = 0;
   }
-	goto st256;
-st256:
+	goto st331;
+st331:
 	if ( ++p == pe )
-		goto _test_eof256;
-case 256:
-#line 5664 "http_parser.c"
+		goto _test_eof331;
+case 331:
+#line 13093 "http_parser.c"
 	switch( (*p) ) {
-		case 13: goto tr236;
-		case 32: goto st256;
-		case 105: goto tr301;
+		case 13: goto tr308;
+		case 32: goto st331;
+		case 33: goto tr452;
+		case 124: goto tr452;
+		case 126: goto tr452;
 	}
-	goto tr235;
-tr301:
-#line 118 "http_parser.rl"
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto tr452;
+		} else if ( (*p) >= 35 )
+			goto tr452;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto tr452;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto tr452;
+		} else
+			goto tr452;
+	} else
+		goto tr452;
+	goto tr307;
+tr452:
+#line 558 "http_parser.rl"
 	{
     parser->header_value_mark = p;
     parser->header_value_size = 0;
   }
-	goto st257;
-st257:
-	if ( ++p == pe )
-		goto _test_eof257;
-case 257:
-#line 5682 "http_parser.c"
-	switch( (*p) ) {
-		case 13: goto tr239;
-		case 100: goto st258;
-	}
-	goto st199;
-st258:
-	if ( ++p == pe )
-		goto _test_eof258;
-case 258:
-	switch( (*p) ) {
-		case 13: goto tr239;
-		case 101: goto st259;
-	}
-	goto st199;
-st259:
-	if ( ++p == pe )
-		goto _test_eof259;
-case 259:
-	switch( (*p) ) {
-		case 13: goto tr239;
-		case 110: goto st260;
-	}
-	goto st199;
-st260:
+	goto st332;
+st332:
+	if ( ++p == pe )
+		goto _test_eof332;
+case 332:
+#line 13130 "http_parser.c"
+	switch( (*p) ) {
+		case 9: goto st333;
+		case 13: goto tr454;
+		case 32: goto st333;
+		case 33: goto st332;
+		case 44: goto st334;
+		case 47: goto st335;
+		case 124: goto st332;
+		case 126: goto st332;
+	}
+	if ( (*p) < 42 ) {
+		if ( 35 <= (*p) && (*p) <= 39 )
+			goto st332;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st332;
+		} else if ( (*p) >= 65 )
+			goto st332;
+	} else
+		goto st332;
+	goto st216;
+st333:
 	if ( ++p == pe )
-		goto _test_eof260;
-case 260:
+		goto _test_eof333;
+case 333:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 116: goto st261;
+		case 9: goto st333;
+		case 13: goto tr311;
+		case 32: goto st333;
+		case 44: goto st334;
 	}
-	goto st199;
-st261:
+	goto st216;
+st334:
 	if ( ++p == pe )
-		goto _test_eof261;
-case 261:
+		goto _test_eof334;
+case 334:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 105: goto st262;
+		case 9: goto st334;
+		case 13: goto tr311;
+		case 32: goto st334;
+		case 33: goto st332;
+		case 44: goto st334;
+		case 124: goto st332;
+		case 126: goto st332;
 	}
-	goto st199;
-st262:
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st332;
+		} else if ( (*p) >= 35 )
+			goto st332;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st332;
+		} else if ( (*p) >= 65 )
+			goto st332;
+	} else
+		goto st332;
+	goto st216;
+st335:
 	if ( ++p == pe )
-		goto _test_eof262;
-case 262:
+		goto _test_eof335;
+case 335:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 116: goto st263;
+		case 13: goto tr311;
+		case 33: goto st336;
+		case 124: goto st336;
+		case 126: goto st336;
 	}
-	goto st199;
-st263:
+	if ( (*p) < 45 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 43 )
+				goto st336;
+		} else if ( (*p) >= 35 )
+			goto st336;
+	} else if ( (*p) > 46 ) {
+		if ( (*p) < 65 ) {
+			if ( 48 <= (*p) && (*p) <= 57 )
+				goto st336;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st336;
+		} else
+			goto st336;
+	} else
+		goto st336;
+	goto st216;
+st336:
 	if ( ++p == pe )
-		goto _test_eof263;
-case 263:
+		goto _test_eof336;
+case 336:
 	switch( (*p) ) {
-		case 13: goto tr239;
-		case 121: goto st264;
+		case 9: goto st333;
+		case 13: goto tr454;
+		case 32: goto st333;
+		case 33: goto st336;
+		case 44: goto st334;
+		case 124: goto st336;
+		case 126: goto st336;
 	}
-	goto st199;
-st264:
-	if ( ++p == pe )
-		goto _test_eof264;
-case 264:
-	if ( (*p) == 13 )
-		goto tr309;
-	goto st199;
-st265:
+	if ( (*p) < 48 ) {
+		if ( (*p) > 39 ) {
+			if ( 42 <= (*p) && (*p) <= 46 )
+				goto st336;
+		} else if ( (*p) >= 35 )
+			goto st336;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 122 )
+				goto st336;
+		} else if ( (*p) >= 65 )
+			goto st336;
+	} else
+		goto st336;
+	goto st216;
+st337:
 	if ( ++p == pe )
-		goto _test_eof265;
-case 265:
+		goto _test_eof337;
+case 337:
 	if ( (*p) == 13 )
-		goto st194;
+		goto st211;
 	if ( (*p) > 9 ) {
 		if ( 11 <= (*p) )
-			goto st265;
+			goto st337;
 	} else if ( (*p) >= 0 )
-		goto st265;
+		goto st337;
 	goto st0;
 	}
 	_test_eof1: cs = 1; goto _test_eof; 
-	_test_eof266: cs = 266; goto _test_eof; 
+	_test_eof338: cs = 338; goto _test_eof; 
 	_test_eof2: cs = 2; goto _test_eof; 
 	_test_eof3: cs = 3; goto _test_eof; 
 	_test_eof4: cs = 4; goto _test_eof; 
 	_test_eof5: cs = 5; goto _test_eof; 
 	_test_eof6: cs = 6; goto _test_eof; 
-	_test_eof267: cs = 267; goto _test_eof; 
+	_test_eof339: cs = 339; goto _test_eof; 
 	_test_eof7: cs = 7; goto _test_eof; 
 	_test_eof8: cs = 8; goto _test_eof; 
 	_test_eof9: cs = 9; goto _test_eof; 
@@ -5779,11 +13278,11 @@ case 265:
 	_test_eof17: cs = 17; goto _test_eof; 
 	_test_eof18: cs = 18; goto _test_eof; 
 	_test_eof19: cs = 19; goto _test_eof; 
-	_test_eof268: cs = 268; goto _test_eof; 
 	_test_eof20: cs = 20; goto _test_eof; 
 	_test_eof21: cs = 21; goto _test_eof; 
 	_test_eof22: cs = 22; goto _test_eof; 
 	_test_eof23: cs = 23; goto _test_eof; 
+	_test_eof340: cs = 340; goto _test_eof; 
 	_test_eof24: cs = 24; goto _test_eof; 
 	_test_eof25: cs = 25; goto _test_eof; 
 	_test_eof26: cs = 26; goto _test_eof; 
@@ -5942,7 +13441,6 @@ case 265:
 	_test_eof179: cs = 179; goto _test_eof; 
 	_test_eof180: cs = 180; goto _test_eof; 
 	_test_eof181: cs = 181; goto _test_eof; 
-	_test_eof269: cs = 269; goto _test_eof; 
 	_test_eof182: cs = 182; goto _test_eof; 
 	_test_eof183: cs = 183; goto _test_eof; 
 	_test_eof184: cs = 184; goto _test_eof; 
@@ -5960,6 +13458,7 @@ case 265:
 	_test_eof196: cs = 196; goto _test_eof; 
 	_test_eof197: cs = 197; goto _test_eof; 
 	_test_eof198: cs = 198; goto _test_eof; 
+	_test_eof341: cs = 341; goto _test_eof; 
 	_test_eof199: cs = 199; goto _test_eof; 
 	_test_eof200: cs = 200; goto _test_eof; 
 	_test_eof201: cs = 201; goto _test_eof; 
@@ -6027,25 +13526,847 @@ case 265:
 	_test_eof263: cs = 263; goto _test_eof; 
 	_test_eof264: cs = 264; goto _test_eof; 
 	_test_eof265: cs = 265; goto _test_eof; 
+	_test_eof266: cs = 266; goto _test_eof; 
+	_test_eof267: cs = 267; goto _test_eof; 
+	_test_eof268: cs = 268; goto _test_eof; 
+	_test_eof269: cs = 269; goto _test_eof; 
+	_test_eof270: cs = 270; goto _test_eof; 
+	_test_eof271: cs = 271; goto _test_eof; 
+	_test_eof272: cs = 272; goto _test_eof; 
+	_test_eof273: cs = 273; goto _test_eof; 
+	_test_eof274: cs = 274; goto _test_eof; 
+	_test_eof275: cs = 275; goto _test_eof; 
+	_test_eof276: cs = 276; goto _test_eof; 
+	_test_eof277: cs = 277; goto _test_eof; 
+	_test_eof278: cs = 278; goto _test_eof; 
+	_test_eof279: cs = 279; goto _test_eof; 
+	_test_eof280: cs = 280; goto _test_eof; 
+	_test_eof281: cs = 281; goto _test_eof; 
+	_test_eof282: cs = 282; goto _test_eof; 
+	_test_eof283: cs = 283; goto _test_eof; 
+	_test_eof284: cs = 284; goto _test_eof; 
+	_test_eof285: cs = 285; goto _test_eof; 
+	_test_eof286: cs = 286; goto _test_eof; 
+	_test_eof287: cs = 287; goto _test_eof; 
+	_test_eof288: cs = 288; goto _test_eof; 
+	_test_eof289: cs = 289; goto _test_eof; 
+	_test_eof290: cs = 290; goto _test_eof; 
+	_test_eof291: cs = 291; goto _test_eof; 
+	_test_eof292: cs = 292; goto _test_eof; 
+	_test_eof293: cs = 293; goto _test_eof; 
+	_test_eof294: cs = 294; goto _test_eof; 
+	_test_eof295: cs = 295; goto _test_eof; 
+	_test_eof296: cs = 296; goto _test_eof; 
+	_test_eof297: cs = 297; goto _test_eof; 
+	_test_eof298: cs = 298; goto _test_eof; 
+	_test_eof299: cs = 299; goto _test_eof; 
+	_test_eof300: cs = 300; goto _test_eof; 
+	_test_eof301: cs = 301; goto _test_eof; 
+	_test_eof302: cs = 302; goto _test_eof; 
+	_test_eof303: cs = 303; goto _test_eof; 
+	_test_eof304: cs = 304; goto _test_eof; 
+	_test_eof305: cs = 305; goto _test_eof; 
+	_test_eof306: cs = 306; goto _test_eof; 
+	_test_eof307: cs = 307; goto _test_eof; 
+	_test_eof308: cs = 308; goto _test_eof; 
+	_test_eof309: cs = 309; goto _test_eof; 
+	_test_eof310: cs = 310; goto _test_eof; 
+	_test_eof311: cs = 311; goto _test_eof; 
+	_test_eof312: cs = 312; goto _test_eof; 
+	_test_eof313: cs = 313; goto _test_eof; 
+	_test_eof314: cs = 314; goto _test_eof; 
+	_test_eof315: cs = 315; goto _test_eof; 
+	_test_eof316: cs = 316; goto _test_eof; 
+	_test_eof317: cs = 317; goto _test_eof; 
+	_test_eof318: cs = 318; goto _test_eof; 
+	_test_eof319: cs = 319; goto _test_eof; 
+	_test_eof320: cs = 320; goto _test_eof; 
+	_test_eof321: cs = 321; goto _test_eof; 
+	_test_eof322: cs = 322; goto _test_eof; 
+	_test_eof323: cs = 323; goto _test_eof; 
+	_test_eof324: cs = 324; goto _test_eof; 
+	_test_eof325: cs = 325; goto _test_eof; 
+	_test_eof326: cs = 326; goto _test_eof; 
+	_test_eof327: cs = 327; goto _test_eof; 
+	_test_eof328: cs = 328; goto _test_eof; 
+	_test_eof329: cs = 329; goto _test_eof; 
+	_test_eof330: cs = 330; goto _test_eof; 
+	_test_eof331: cs = 331; goto _test_eof; 
+	_test_eof332: cs = 332; goto _test_eof; 
+	_test_eof333: cs = 333; goto _test_eof; 
+	_test_eof334: cs = 334; goto _test_eof; 
+	_test_eof335: cs = 335; goto _test_eof; 
+	_test_eof336: cs = 336; goto _test_eof; 
+	_test_eof337: cs = 337; goto _test_eof; 
 
 	_test_eof: {}
+	if ( p == eof )
+	{
+	switch ( cs ) {
+	case 24: 
+#line 808 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_METHOD);         }
+	break;
+	case 25: 
+	case 26: 
+	case 166: 
+	case 167: 
+	case 168: 
+	case 169: 
+	case 170: 
+	case 171: 
+	case 172: 
+	case 173: 
+	case 174: 
+	case 175: 
+	case 176: 
+	case 177: 
+	case 178: 
+	case 179: 
+	case 180: 
+	case 181: 
+	case 182: 
+	case 183: 
+	case 184: 
+	case 185: 
+	case 186: 
+	case 187: 
+	case 188: 
+	case 189: 
+	case 190: 
+	case 191: 
+	case 192: 
+	case 193: 
+	case 194: 
+	case 195: 
+	case 196: 
+	case 197: 
+	case 198: 
+#line 809 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_URI);            }
+	break;
+	case 27: 
+	case 28: 
+	case 29: 
+	case 30: 
+	case 31: 
+	case 32: 
+	case 33: 
+	case 34: 
+	case 35: 
+	case 199: 
+	case 200: 
+	case 201: 
+	case 202: 
+	case 203: 
+	case 204: 
+	case 205: 
+	case 206: 
+#line 810 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_VERSION);        }
+	break;
+	case 207: 
+	case 208: 
+	case 209: 
+	case 210: 
+#line 811 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_STATUS);         }
+	break;
+	case 37: 
+	case 38: 
+	case 39: 
+	case 40: 
+	case 41: 
+	case 42: 
+	case 43: 
+	case 44: 
+	case 45: 
+	case 46: 
+	case 47: 
+	case 48: 
+	case 49: 
+	case 50: 
+	case 51: 
+	case 52: 
+	case 53: 
+	case 54: 
+	case 55: 
+	case 56: 
+	case 57: 
+	case 58: 
+	case 59: 
+	case 60: 
+	case 61: 
+	case 62: 
+	case 63: 
+	case 64: 
+	case 65: 
+	case 66: 
+	case 67: 
+	case 68: 
+	case 69: 
+	case 70: 
+	case 71: 
+	case 72: 
+	case 73: 
+	case 74: 
+	case 75: 
+	case 76: 
+	case 77: 
+	case 78: 
+	case 79: 
+	case 80: 
+	case 81: 
+	case 82: 
+	case 83: 
+	case 84: 
+	case 85: 
+	case 86: 
+	case 87: 
+	case 88: 
+	case 89: 
+	case 90: 
+	case 91: 
+	case 92: 
+	case 93: 
+	case 94: 
+	case 95: 
+	case 96: 
+	case 97: 
+	case 98: 
+	case 99: 
+	case 100: 
+	case 101: 
+	case 102: 
+	case 103: 
+	case 104: 
+	case 105: 
+	case 106: 
+	case 107: 
+	case 108: 
+	case 109: 
+	case 110: 
+	case 111: 
+	case 112: 
+	case 113: 
+	case 114: 
+	case 115: 
+	case 116: 
+	case 117: 
+	case 118: 
+	case 119: 
+	case 120: 
+	case 121: 
+	case 122: 
+	case 123: 
+	case 124: 
+	case 125: 
+	case 126: 
+	case 127: 
+	case 128: 
+	case 129: 
+	case 130: 
+	case 131: 
+	case 132: 
+	case 133: 
+	case 134: 
+	case 135: 
+	case 136: 
+	case 137: 
+	case 138: 
+	case 139: 
+	case 140: 
+	case 141: 
+	case 142: 
+	case 143: 
+	case 144: 
+	case 145: 
+	case 146: 
+	case 147: 
+	case 148: 
+	case 149: 
+	case 150: 
+	case 151: 
+	case 152: 
+	case 153: 
+	case 154: 
+	case 155: 
+	case 156: 
+	case 157: 
+	case 158: 
+	case 159: 
+	case 160: 
+	case 161: 
+	case 212: 
+	case 213: 
+	case 214: 
+	case 215: 
+	case 216: 
+	case 217: 
+	case 218: 
+	case 219: 
+	case 220: 
+	case 221: 
+	case 222: 
+	case 223: 
+	case 224: 
+	case 225: 
+	case 226: 
+	case 227: 
+	case 228: 
+	case 229: 
+	case 230: 
+	case 231: 
+	case 232: 
+	case 233: 
+	case 234: 
+	case 235: 
+	case 236: 
+	case 237: 
+	case 238: 
+	case 239: 
+	case 240: 
+	case 241: 
+	case 242: 
+	case 243: 
+	case 244: 
+	case 245: 
+	case 246: 
+	case 247: 
+	case 248: 
+	case 249: 
+	case 250: 
+	case 251: 
+	case 252: 
+	case 253: 
+	case 254: 
+	case 255: 
+	case 256: 
+	case 257: 
+	case 258: 
+	case 259: 
+	case 260: 
+	case 261: 
+	case 262: 
+	case 263: 
+	case 264: 
+	case 265: 
+	case 266: 
+	case 267: 
+	case 268: 
+	case 269: 
+	case 270: 
+	case 271: 
+	case 272: 
+	case 273: 
+	case 274: 
+	case 275: 
+	case 276: 
+	case 277: 
+	case 278: 
+	case 279: 
+	case 280: 
+	case 281: 
+	case 282: 
+	case 283: 
+	case 284: 
+	case 285: 
+	case 286: 
+	case 287: 
+	case 288: 
+	case 289: 
+	case 290: 
+	case 291: 
+	case 292: 
+	case 293: 
+	case 294: 
+	case 295: 
+	case 296: 
+	case 297: 
+	case 298: 
+	case 299: 
+	case 300: 
+	case 301: 
+	case 302: 
+	case 303: 
+	case 304: 
+	case 305: 
+	case 306: 
+	case 307: 
+	case 308: 
+	case 309: 
+	case 310: 
+	case 311: 
+	case 312: 
+	case 313: 
+	case 314: 
+	case 315: 
+	case 316: 
+	case 317: 
+	case 318: 
+	case 319: 
+	case 320: 
+	case 321: 
+	case 322: 
+	case 323: 
+	case 324: 
+	case 325: 
+	case 326: 
+	case 327: 
+	case 328: 
+	case 329: 
+	case 330: 
+	case 331: 
+	case 332: 
+	case 333: 
+	case 334: 
+	case 335: 
+	case 336: 
+#line 812 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_HEADER);         }
+	break;
+	case 4: 
+	case 5: 
+	case 6: 
+	case 7: 
+	case 8: 
+	case 9: 
+	case 10: 
+	case 11: 
+	case 12: 
+	case 14: 
+	case 15: 
+	case 16: 
+	case 17: 
+	case 18: 
+	case 19: 
+	case 20: 
+	case 21: 
+	case 22: 
+	case 23: 
+#line 814 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK);          }
+	break;
+	case 2: 
+	case 3: 
+	case 13: 
+#line 813 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK_SIZE);     }
+#line 814 "http_parser.rl"
+	{ SET_PARSE_ERROR(HPE_INVALID_CHUNK);          }
+	break;
+#line 13959 "http_parser.c"
+	}
+	}
+
 	_out: {}
 	}
-#line 471 "http_parser.rl"
+#line 1255 "http_parser.rl"
 
   parser->cs = cs;
 
-  CALLBACK(header_field);
-  CALLBACK(header_value);
+  if (cs == http_parser_error && parser->http_errno == HPE_OK) {
+    SET_ERROR(HPE_UNKNOWN);
+  }
+
+  if (parser->header_filter) {
+    BUFFER_FIELD;
+  } else {
+    PARTIAL_CALLBACK(header_field, parser->reassemble_tokens || parser->headers);
+  }
+  if (parser->skip_header) {
+    SKIP_CALLBACK(header_value);
+  } else {
+    PARTIAL_CALLBACK(header_value, parser->reassemble_tokens || parser->headers);
+  }
   CALLBACK(fragment);
+  DECODE(query_string);
   CALLBACK(query_string);
-  CALLBACK(path);
+  DECODE(path);
+  ROUTE;
+  PARTIAL_CALLBACK(path, parser->reassemble_tokens);
   CALLBACK(uri);
+  CALLBACK(chunk_extension);
+  CALLBACK(scheme);
+  CALLBACK(host);
+
+  if (parser->framing) {
+    FRAMING(p);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+  }
+
+  if (parser->inplace_begin) {
+    callback_return_value = inplace_flush(parser);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+  }
 
   assert(p <= pe && "buffer overflow after parsing execute");
+  parser->stream_offset += p - buffer;
   return(p - buffer);
 }
 
+size_t
+http_parser_execute_inplace (http_parser *parser, char *data, size_t len)
+{
+  size_t parsed;
+
+  parser->inplace = TRUE;
+  parsed = http_parser_execute(parser, data, len);
+  parser->inplace = FALSE;
+  /* left over if it stopped with an error */
+  parser->inplace_begin = parser->inplace_end = NULL;
+  return parsed;
+}
+
+size_t
+http_parser_execute_batch (http_parser *const *parsers,
+                           const char *const *bufs,
+                           const size_t *lens,
+                           size_t *parsed,
+                           size_t n)
+{
+  size_t i, errors = 0;
+
+  for (i = 0; i < n; i++) {
+    if (i + 1 < n) {
+      /* the machine state and the marks, and the first of the data */
+      PREFETCH(parsers[i + 1]);
+      PREFETCH(&parsers[i + 1]->header_field_mark);
+      PREFETCH(bufs[i + 1]);
+    }
+    parsed[i] = http_parser_execute(parsers[i], bufs[i], lens[i]);
+    if (http_parser_has_error(parsers[i])) errors++;
+  }
+  return errors;
+}
+
+size_t
+http_parser_consume_body (http_parser *parser, size_t len)
+{
+  int callback_return_value = 0;
+
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    parser->body_read += len;
+    parser->stream_offset += len;
+    return len;
+  }
+  if (!parser->eating || parser->transfer_encoding != HTTP_IDENTITY) {
+    return 0;
+  }
+
+  len = MIN(len, parser->chunk_size);
+  parser->body_read += len;
+  parser->stream_offset += len;
+  parser->chunk_size -= len;
+  if (parser->chunk_size == 0) {
+    parser->eating = FALSE;
+    END_REQUEST;
+    if (callback_return_value != 0) {
+      parser->error = TRUE;
+      parser->http_errno = HPE_CALLBACK_ABORT;
+      parser->error_offset = 0;
+    }
+  }
+  return len;
+}
+
+int
+http_parser_finish (http_parser *parser)
+{
+  int callback_return_value = 0;
+
+  if (parser->flags & HTTP_FLAG_UPGRADE) {
+    return 0;
+  } else if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    END_REQUEST;
+    if (callback_return_value != 0) {
+      parser->error = TRUE;
+      parser->http_errno = HPE_CALLBACK_ABORT;
+      parser->error_offset = 0;
+      return 1;
+    }
+  } else if (parser->flags & HTTP_FLAG_IN_MESSAGE) {
+    parser->error = TRUE;
+    parser->http_errno = HPE_INVALID_EOF_STATE;
+    parser->error_offset = 0;
+    return 1;
+  }
+  return 0;
+}
+
+/* Snapshots are a version byte, a fingerprint of the machine and then the
+ * fields in a fixed order, little endian. A data mark is only recorded as
+ * set, the data before it has been called back already and the mark is
+ * moved to the start of the next buffer parsed anyway.
+ */
+#define SNAPSHOT_VERSION 4
+
+/* bytes up to and including the size of the method token */
+#define SNAPSHOT_FIXED_SIZE 77
+
+/* ragel numbers the final states last, in the order the machines are
+ * instantiated. The only final state of Responses, the last of them, is its
+ * start, so it is the highest numbered state.
+ */
+#define SNAPSHOT_STATES (http_parser_en_Responses + 1)
+
+/* FNV-1a of the state count and the numbers ragel gives the start, first
+ * final and entry states, any change to the grammar moves some of them */
+static uint32_t
+machine_fingerprint (void)
+{
+  const int numbers[] = { SNAPSHOT_STATES, http_parser_start,
+    http_parser_first_final, http_parser_error, http_parser_en_main,
+    http_parser_en_ChunkedBody, http_parser_en_ChunkedBody_chunk_chunk_end,
+    http_parser_en_Requests, http_parser_en_Responses };
+  uint32_t hash = 2166136261u;
+  unsigned int i;
+  int b;
+
+  for (i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+    for (b = 0; b < 32; b += 8) {
+      hash ^= (numbers[i] >> b) & 0xff;
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
+
+#define SNAPSHOT_MARKS(XX)                                           \
+  XX(header_field)                                                   \
+  XX(header_value)                                                   \
+  XX(query_string)                                                   \
+  XX(path)                                                           \
+  XX(uri)                                                            \
+  XX(fragment)                                                       \
+  XX(chunk_extension)                                                \
+  XX(scheme)                                                         \
+  XX(host)
+
+/* what restored marks point at until the next http_parser_execute() */
+static const char restored_mark = '\0';
+
+static char *
+put_uint (char *out, uint64_t value, int bytes)
+{
+  while (bytes--) {
+    *out++ = (char)(value & 0xff);
+    value >>= 8;
+  }
+  return out;
+}
+
+static const char *
+get_uint (const char *in, uint64_t *value, int bytes)
+{
+  int i;
+
+  *value = 0;
+  for (i = 0; i < bytes; i++) {
+    *value |= (uint64_t)(unsigned char)in[i] << (8 * i);
+  }
+  return in + bytes;
+}
+
+/* the bits of _flags a parser can have between http_parser_execute() calls
+ * without an error */
+static unsigned char
+between_calls_flags (void)
+{
+  http_parser probe;
+
+  probe._flags = 0;
+  probe.eating = 1;
+  probe.skip_header = 1;
+  probe.framing = 1;
+  return probe._flags;
+}
+
+size_t
+http_parser_snapshot (const http_parser *parser, char *buf, size_t len)
+{
+  char *out = buf;
+  unsigned int marks = 0;
+  size_t name_size;
+
+  if (len < HTTP_PARSER_SNAPSHOT_SIZE) return 0;
+  /* the route match refers into the router */
+  if (parser->router && parser->route->node) return 0;
+  /* nor are the pieces of a string being reassembled or the headers
+   * collected, which are in the arena */
+  if (parser->token_len > 0) return 0;
+  if (parser->headers && parser->headers->count > 0) return 0;
+  /* nor the middle of http_parser_execute_inplace() or a failed parse */
+  if (parser->inplace || parser->error) return 0;
+
+  out = put_uint(out, SNAPSHOT_VERSION, 1);
+  out = put_uint(out, machine_fingerprint(), 4);
+  out = put_uint(out, parser->type, 1);
+  out = put_uint(out, parser->cs, 4);
+  out = put_uint(out, parser->_flags, 1);
+  out = put_uint(out, parser->chunk_size, 8);
+  out = put_uint(out, parser->body_read, 8);
+  out = put_uint(out, parser->content_length, 8);
+  out = put_uint(out, parser->status_code, 2);
+  out = put_uint(out, parser->method, 2);
+  out = put_uint(out, parser->port, 2);
+  out = put_uint(out, (unsigned short)parser->transfer_encoding, 2);
+  out = put_uint(out, parser->version_major, 2);
+  out = put_uint(out, parser->version_minor, 2);
+  out = put_uint(out, (unsigned short)parser->keep_alive, 2);
+  out = put_uint(out, parser->flags, 2);
+  out = put_uint(out, parser->http_errno, 1);
+  out = put_uint(out, parser->error_offset, 8);
+  out = put_uint(out, parser->stream_offset, 8);
+  out = put_uint(out, parser->framing_offset, 8);
+
+  out = put_uint(out, parser->method_size, 1);
+  memcpy(out, parser->method_token.buf, parser->method_size);
+  out += parser->method_size;
+
+#define SNAPSHOT_MARK_BIT(FOR)                                       \
+  marks = (marks << 1) | (parser->FOR##_mark != NULL);
+  SNAPSHOT_MARKS(SNAPSHOT_MARK_BIT)
+#undef SNAPSHOT_MARK_BIT
+  out = put_uint(out, marks, 2);
+#define SNAPSHOT_MARK_SIZE(FOR)                                      \
+  out = put_uint(out, parser->FOR##_size, 8);
+  SNAPSHOT_MARKS(SNAPSHOT_MARK_SIZE)
+#undef SNAPSHOT_MARK_SIZE
+
+  /* a field name being gathered for the header filter */
+  name_size = parser->header_filter ?
+    MIN(parser->header_field_size, HTTP_MAX_HEADER_NAME_SIZE) : 0;
+  out = put_uint(out, name_size, 1);
+  memcpy(out, parser->header_name, name_size);
+  out += name_size;
+
+  out = put_uint(out, parser->path_decoder.len, 8);
+  out = put_uint(out, parser->path_decoder.state, 1);
+  out = put_uint(out, parser->path_decoder.hi, 1);
+  out = put_uint(out, parser->query_string_decoder.len, 8);
+  out = put_uint(out, parser->query_string_decoder.state, 1);
+  out = put_uint(out, parser->query_string_decoder.hi, 1);
+
+  assert(out - buf <= HTTP_PARSER_SNAPSHOT_SIZE);
+  return out - buf;
+}
+
+int
+http_parser_restore (http_parser *parser, const char *buf, size_t len)
+{
+  const char *in = buf;
+  const char *end = buf + len;
+  http_parser restored;
+  uint64_t v;
+  unsigned int marks;
+  const char *name;
+  size_t name_size;
+
+  if (len < SNAPSHOT_FIXED_SIZE) return -1;
+  in = get_uint(in, &v, 1); if (v != SNAPSHOT_VERSION) return -1;
+  in = get_uint(in, &v, 4); if (v != machine_fingerprint()) return -1;
+  in = get_uint(in, &v, 1); if (v != (uint64_t)parser->type) return -1;
+
+  /* nothing of parser changes unless all of it is restored, what it
+   * shares is reset at the end */
+  restored = *parser;
+  restored.arena = NULL;
+  restored.headers = NULL;
+  restored.route = NULL;
+  RESET_PARSER((&restored));
+
+  in = get_uint(in, &v, 4);
+  if (v >= SNAPSHOT_STATES) return -1;
+  restored.cs = (int)v;
+  in = get_uint(in, &v, 1);
+  if (v & ~(uint64_t)between_calls_flags()) return -1;
+  restored._flags = (unsigned char)v;
+  in = get_uint(in, &v, 8); restored.chunk_size = v;
+  in = get_uint(in, &v, 8); restored.body_read = v;
+  in = get_uint(in, &v, 8); restored.content_length = v;
+  in = get_uint(in, &v, 2); restored.status_code = v;
+  in = get_uint(in, &v, 2);
+  if (v > HTTP_EXTENSION_METHOD) return -1;
+  restored.method = v;
+  in = get_uint(in, &v, 2); restored.port = v;
+  in = get_uint(in, &v, 2);
+  if (v != HTTP_IDENTITY && v != HTTP_CHUNKED) return -1;
+  restored.transfer_encoding = (short)v;
+  in = get_uint(in, &v, 2); restored.version_major = v;
+  in = get_uint(in, &v, 2); restored.version_minor = v;
+  in = get_uint(in, &v, 2); restored.keep_alive = (short)v;
+  in = get_uint(in, &v, 2); restored.flags = v;
+  in = get_uint(in, &v, 1);
+  if (v > HPE_UNKNOWN) return -1;
+  restored.http_errno = (enum http_errno)v;
+  in = get_uint(in, &v, 8); restored.error_offset = v;
+  in = get_uint(in, &v, 8); restored.stream_offset = v;
+  in = get_uint(in, &v, 8); restored.framing_offset = v;
+
+  in = get_uint(in, &v, 1);
+  assert(in - buf == SNAPSHOT_FIXED_SIZE);
+  if (v > HTTP_MAX_METHOD_SIZE || end - in < (long)v + 2 + 9 * 8 + 1) return -1;
+  restored.method_size = v;
+  memcpy(restored.method_token.buf, in, restored.method_size);
+  in += restored.method_size;
+
+  in = get_uint(in, &v, 2);
+  if (v >> 9) return -1;
+  marks = v;
+  /* sizes past MAX_FIELD_SIZE would have failed the parse */
+#define RESTORE_MARK(FOR)                                            \
+  in = get_uint(in, &v, 8);                                          \
+  if (v > MAX_FIELD_SIZE) return -1;                                 \
+  restored.FOR##_size = v;                                           \
+  restored.FOR##_mark = NULL;
+  SNAPSHOT_MARKS(RESTORE_MARK)
+#undef RESTORE_MARK
+  /* the first mark is the highest bit */
+#define RESTORE_MARK_BIT(FOR)                                        \
+  if (marks & (1u << --n)) restored.FOR##_mark = &restored_mark;
+  {
+    int n = 9;
+    SNAPSHOT_MARKS(RESTORE_MARK_BIT)
+  }
+#undef RESTORE_MARK_BIT
+
+  in = get_uint(in, &v, 1);
+  name_size = v;
+  if (name_size > MIN(restored.header_field_size, HTTP_MAX_HEADER_NAME_SIZE) ||
+      end - in < (long)name_size + 20) {
+    return -1;
+  }
+  name = in;
+  in += name_size;
+
+  in = get_uint(in, &v, 8); restored.path_decoder.len = v;
+  in = get_uint(in, &v, 1); restored.path_decoder.state = v;
+  in = get_uint(in, &v, 1); restored.path_decoder.hi = v;
+  in = get_uint(in, &v, 8); restored.query_string_decoder.len = v;
+  in = get_uint(in, &v, 1); restored.query_string_decoder.state = v;
+  in = get_uint(in, &v, 1); restored.query_string_decoder.hi = v;
+  if (restored.path_decoder.len > restored.path_decoder.size ||
+      restored.query_string_decoder.len > restored.query_string_decoder.size ||
+      restored.path_decoder.state > 2 || restored.query_string_decoder.state > 2) {
+    return -1;
+  }
+
+  RESET_PARSER(parser);
+  restored.arena = parser->arena;
+  restored.headers = parser->headers;
+  restored.route = parser->route;
+  if (restored.header_name) memcpy(restored.header_name, name, name_size);
+  *parser = restored;
+  return 0;
+}
+
 int
 http_parser_has_error (http_parser *parser) 
 {
@@ -6053,9 +14374,44 @@ http_parser_has_error (http_parser *parser)
   return parser->cs == http_parser_error;
 }
 
+#define HTTP_ERRNO_NAME_GEN(n, s) "HPE_" #n,
+static const char *http_errno_names[] = { HTTP_ERRNO_MAP(HTTP_ERRNO_NAME_GEN) };
+#undef HTTP_ERRNO_NAME_GEN
+
+#define HTTP_ERRNO_DESCRIPTION_GEN(n, s) s,
+static const char *http_errno_descriptions[] = { HTTP_ERRNO_MAP(HTTP_ERRNO_DESCRIPTION_GEN) };
+#undef HTTP_ERRNO_DESCRIPTION_GEN
+
+const char *
+http_errno_name (enum http_errno err)
+{
+  if ((unsigned)err > HPE_UNKNOWN) err = HPE_UNKNOWN;
+  return http_errno_names[err];
+}
+
+const char *
+http_errno_description (enum http_errno err)
+{
+  if ((unsigned)err > HPE_UNKNOWN) err = HPE_UNKNOWN;
+  return http_errno_descriptions[err];
+}
+
+#define HTTP_METHOD_STR_GEN(n, s) s,
+static const char *http_method_strs[] = { NULL, HTTP_METHOD_MAP(HTTP_METHOD_STR_GEN) NULL };
+#undef HTTP_METHOD_STR_GEN
+
+const char *
+http_method_str (enum http_method method)
+{
+  if ((unsigned)method > HTTP_EXTENSION_METHOD) return NULL;
+  return http_method_strs[method];
+}
+
 int
 http_parser_should_keep_alive (http_parser *parser)
 {
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF)
+    return FALSE;
   if (parser->keep_alive == -1)
     if (parser->version_major == 1)
       return (parser->version_minor != 0);
@@ -29,6 +29,10 @@ extern "C" {
 #endif 
 
 #include <sys/types.h> 
+#include <stdint.h>
+#include "http_router.h"
+#include "http_arena.h"
+#include "http_headers.h"
 
 typedef struct http_parser http_parser;
 
@@ -41,29 +45,145 @@ typedef struct http_parser http_parser;
  */
 typedef int (*http_data_cb) (http_parser*, const char *at, size_t length);
 typedef int (*http_cb) (http_parser*);
+typedef int (*http_range_cb) (http_parser*, uint64_t offset, size_t length);
 
-/* Request Methods */
-#define HTTP_COPY       0x0001
-#define HTTP_DELETE     0x0002
-#define HTTP_GET        0x0004
-#define HTTP_HEAD       0x0008
-#define HTTP_LOCK       0x0010
-#define HTTP_MKCOL      0x0020
-#define HTTP_MOVE       0x0040
-#define HTTP_OPTIONS    0x0080
-#define HTTP_POST       0x0100
-#define HTTP_PROPFIND   0x0200
-#define HTTP_PROPPATCH  0x0400
-#define HTTP_PUT        0x0800
-#define HTTP_TRACE      0x1000
-#define HTTP_UNLOCK     0x2000
+/* Request Methods, the value of parser->method. Any other token is accepted
+ * as HTTP_EXTENSION_METHOD and handed to on_extension_method. The map is
+ * ordered most common first, that is the order they are looked up in.
+ */
+#define HTTP_METHOD_MAP(XX)             \
+  XX(GET,          "GET")               \
+  XX(POST,         "POST")              \
+  XX(PUT,          "PUT")               \
+  XX(HEAD,         "HEAD")              \
+  XX(DELETE,       "DELETE")            \
+  XX(PATCH,        "PATCH")             \
+  XX(OPTIONS,      "OPTIONS")           \
+  XX(CONNECT,      "CONNECT")           \
+  XX(TRACE,        "TRACE")             \
+  XX(COPY,         "COPY")              \
+  XX(LOCK,         "LOCK")              \
+  XX(MKCOL,        "MKCOL")             \
+  XX(MOVE,         "MOVE")              \
+  XX(PROPFIND,     "PROPFIND")          \
+  XX(PROPPATCH,    "PROPPATCH")         \
+  XX(SEARCH,       "SEARCH")            \
+  XX(UNLOCK,       "UNLOCK")            \
+  XX(BIND,         "BIND")              \
+  XX(REBIND,       "REBIND")            \
+  XX(UNBIND,       "UNBIND")            \
+  XX(ACL,          "ACL")               \
+  XX(REPORT,       "REPORT")            \
+  XX(MKACTIVITY,   "MKACTIVITY")        \
+  XX(CHECKOUT,     "CHECKOUT")          \
+  XX(MERGE,        "MERGE")             \
+  XX(MSEARCH,      "M-SEARCH")          \
+  XX(NOTIFY,       "NOTIFY")            \
+  XX(SUBSCRIBE,    "SUBSCRIBE")         \
+  XX(UNSUBSCRIBE,  "UNSUBSCRIBE")       \
+  XX(PURGE,        "PURGE")             \
+  XX(MKCALENDAR,   "MKCALENDAR")        \
+  XX(LINK,         "LINK")              \
+  XX(UNLINK,       "UNLINK")
+
+#define HTTP_METHOD_GEN(n, s) HTTP_##n,
+enum http_method { HTTP_NO_METHOD, HTTP_METHOD_MAP(HTTP_METHOD_GEN) HTTP_EXTENSION_METHOD };
+#undef HTTP_METHOD_GEN
+
+/* longest method token accepted, extension methods included */
+#define HTTP_MAX_METHOD_SIZE 24
 
 /* Transfer Encodings */
 #define HTTP_IDENTITY   0x01
 #define HTTP_CHUNKED    0x02
 
+/* Message flags, see parser->flags */
+#define HTTP_FLAG_TRAILER    0x0001 /* header callbacks are for trailers */
+#define HTTP_FLAG_SKIP_BODY  0x0002 /* the message has no body, set this from
+                                       on_headers_complete or before parsing
+                                       the response to a HEAD request */
+#define HTTP_FLAG_IN_MESSAGE     0x0004 /* a message has begun */
+#define HTTP_FLAG_CONTENT_LENGTH 0x0008 /* a Content-Length header was seen */
+#define HTTP_FLAG_READ_UNTIL_EOF 0x0010 /* the body runs until the connection
+                                           closes, see http_parser_finish() */
+#define HTTP_FLAG_CONNECTION_UPGRADE 0x0020 /* "Connection: Upgrade" */
+#define HTTP_FLAG_UPGRADE        0x0040 /* CONNECT or protocol upgrade (an
+                                           Upgrade header and "Connection:
+                                           Upgrade"), the bytes after the
+                                           headers are not HTTP, see
+                                           http_parser_execute() */
+#define HTTP_FLAG_EXPECT_CONTINUE 0x0080 /* "Expect: 100-continue", the client
+                                            waits for a 100 before sending
+                                            the body, check this in
+                                            on_headers_complete */
+#define HTTP_FLAG_BODY_PENDING   0x0100 /* stopped at the start of the body
+                                           with parser->headers_only set,
+                                           until the message is complete */
+#define HTTP_FLAG_UPGRADE_HEADER 0x0200 /* an Upgrade header was seen */
+#define HTTP_FLAG_UNCHUNKED      0x0400 /* the last transfer coding is not
+                                           chunked, an error for a request,
+                                           a response body runs until the
+                                           connection closes */
+
+/* Error codes. After http_parser_has_error() returns true, parser->http_errno
+ * says what went wrong and parser->error_offset is the offset of the failing
+ * byte within the buffer given to that http_parser_execute() call.
+ */
+#define HTTP_ERRNO_MAP(XX)                                          \
+  XX(OK,                      "success")                            \
+  XX(CALLBACK_ABORT,          "a callback returned non-zero")       \
+  XX(INVALID_METHOD,          "invalid HTTP method")                \
+  XX(INVALID_URI,             "invalid request URI")                \
+  XX(INVALID_VERSION,         "invalid HTTP version")               \
+  XX(INVALID_STATUS,          "invalid HTTP status code")           \
+  XX(INVALID_HEADER,          "invalid header line")                \
+  XX(HEADER_OVERFLOW,         "field larger than MAX_FIELD_SIZE")   \
+  XX(INVALID_CONTENT_LENGTH,  "invalid or too large Content-Length")\
+  XX(INVALID_CHUNK_SIZE,      "invalid chunk size")                 \
+  XX(CHUNK_SIZE_OVERFLOW,     "chunk size too large")               \
+  XX(INVALID_CHUNK,           "invalid chunked body framing")       \
+  XX(INVALID_EOF_STATE,       "connection closed mid-message")      \
+  XX(DECODE_OVERFLOW,         "decoded URI larger than its buffer") \
+  XX(TOKEN_OVERFLOW,          "string larger than its buffers")     \
+  XX(INVALID_TRANSFER_ENCODING, "request not chunked by its last transfer coding") \
+  XX(UNKNOWN,                 "unknown parse error")
+
+#define HTTP_ERRNO_GEN(n, s) HPE_##n,
+enum http_errno { HTTP_ERRNO_MAP(HTTP_ERRNO_GEN) };
+#undef HTTP_ERRNO_GEN
+
 enum http_parser_type { HTTP_REQUEST, HTTP_RESPONSE };
 
+/* A set of header names, see parser->header_filter. Fill it with
+ * http_header_set_add(), names compare case-insensitively.
+ */
+#define HTTP_HEADER_SET_SLOTS     32 /* a power of two */
+#define HTTP_MAX_HEADER_NAME_SIZE 64
+
+typedef struct http_header_set http_header_set;
+struct http_header_set {
+  /** PRIVATE **/
+  unsigned char length[HTTP_HEADER_SET_SLOTS]; /* 0 for an empty slot */
+  char name[HTTP_HEADER_SET_SLOTS][HTTP_MAX_HEADER_NAME_SIZE];
+};
+
+/* Percent-decoding of the request path and query string as they are parsed,
+ * see http_parser_decode_path(). buf[0 .. len) holds the bytes decoded so
+ * far, the whole value once its last on_path/on_query_string has been made.
+ */
+typedef struct http_decoder http_decoder;
+struct http_decoder {
+  char  *buf;                  /* caller supplied, NULL when not decoding */
+  size_t size;
+  size_t len;
+  unsigned char state;         /* PRIVATE: hex digits of a '%' still due */
+  unsigned char hi;            /* PRIVATE: the first of them */
+  unsigned char plus_is_space; /* PRIVATE: set for the query string */
+};
+
+/* the first buffer for split strings, see reassemble_tokens */
+#define HTTP_TOKEN_BUF_SIZE 128
+
 struct http_parser {
   /** PRIVATE **/
   int cs;
@@ -71,6 +191,12 @@ struct http_parser {
 
   size_t chunk_size;
 
+  union {
+    char     buf[HTTP_MAX_METHOD_SIZE];
+    uint64_t word[HTTP_MAX_METHOD_SIZE / 8];
+  } method_token;
+  unsigned char method_size;
+
   /**
     XXX
     do this so no other code has to change, but make the field only 1 byte wide
@@ -83,6 +209,9 @@ struct http_parser {
     struct {
       unsigned eating:1;
       unsigned error:1;
+      unsigned skip_header:1; /* not in header_filter */
+      unsigned framing:1;     /* chunk framing from framing_offset on */
+      unsigned inplace:1;     /* in http_parser_execute_inplace() */
     };
     struct {
       unsigned char _flags;
@@ -90,11 +219,17 @@ struct http_parser {
   };
 
   size_t body_read;
+  uint64_t framing_offset;
+  char *inplace_begin; /* the body moved together so far */
+  char *inplace_end;
 
   const char *header_field_mark; 
   size_t      header_field_size; 
   const char *header_value_mark; 
   size_t      header_value_size; 
+  size_t      token_len;  /* with reassemble_tokens */
+  char       *token_buf;  /* in the arena */
+  size_t      token_buf_size;
   const char *query_string_mark; 
   size_t      query_string_size; 
   const char *path_mark; 
@@ -103,25 +238,58 @@ struct http_parser {
   size_t      uri_size; 
   const char *fragment_mark; 
   size_t      fragment_size; 
+  const char *chunk_extension_mark; 
+  size_t      chunk_extension_size; 
+  const char *scheme_mark; 
+  size_t      scheme_size; 
+  const char *host_mark; 
+  size_t      host_size; 
 
   /** READ-ONLY **/
   unsigned short status_code; /* responses only */
-  unsigned short method;      /* requests only */
+  unsigned short method;      /* requests only, enum http_method */
+  unsigned short port;        /* requests only, 0 unless the target has one */
   short transfer_encoding;
   unsigned short version_major;
   unsigned short version_minor;
   short keep_alive;
   size_t content_length;
+  unsigned short flags;
+  enum http_errno http_errno;
+  size_t error_offset;
+  http_decoder path_decoder;         /* requests only */
+  http_decoder query_string_decoder; /* requests only */
+  uint64_t stream_offset; /* bytes of the stream parsed before the current
+                             http_parser_execute() */
 
   /** PUBLIC **/
   void *data; /* A pointer to get hook to the "connection" or "socket" object */
+  http_router *router; /* requests only, match the path against this */
+  http_route_match *route; /* with a router, where the match goes. The
+                              caller's, set it along with router */
+  const http_header_set *header_filter; /* only call on_header_field and
+                                           on_header_value for these */
+  char *header_name; /* with a header_filter, HTTP_MAX_HEADER_NAME_SIZE bytes
+                        to gather field names in. The caller's, set it along
+                        with header_filter */
+  unsigned char headers_only; /* stop at the start of each body, see
+                                 http_parser_consume_body() */
+  unsigned char reassemble_tokens; /* see below */
+  http_arena *arena; /* for the parser's storage, reset at the end of every
+                        message. One per parser. */
+  http_headers *headers; /* with an arena, collect the headers here */
 
   /* an ordered list of callbacks */
 
   http_cb      on_message_begin;
 
   /* requests only */
+  http_data_cb on_extension_method; /* called once with the whole token */
+  http_data_cb on_scheme;  /* absolute-form targets only */
+  http_data_cb on_host;    /* absolute-form and CONNECT authority-form targets,
+                            * an IPv6 literal is given without its brackets */
   http_data_cb on_path;
+  http_cb      on_route; /* with a router, once the whole path is matched */
   http_data_cb on_query_string;
   http_data_cb on_uri;
   http_data_cb on_fragment;
@@ -129,19 +297,166 @@ struct http_parser {
   http_data_cb on_header_field;
   http_data_cb on_header_value;
   http_cb      on_headers_complete;
+
+  /* chunked bodies only, chunk_size is valid during on_chunk_header and is
+   * 0 for the last chunk */
+  http_data_cb on_chunk_extension;
+  http_cb      on_chunk_header;
+  http_cb      on_chunk_complete;
+
   http_data_cb on_body;
   http_cb      on_message_complete;
+
+  /* body forwarding. When on_body_range is set it is called instead of
+   * on_body with where the body bytes are in the stream, counting from
+   * the first byte given to the parser. on_framing_range is given the
+   * rest of a chunked body, the chunk size lines, the CRLF after each
+   * chunk and the last chunk with its trailers, so a proxy can splice()
+   * the payloads and copy the framing, or drop it.
+   */
+  http_range_cb on_body_range;
+  http_range_cb on_framing_range;
 };
 
+/* Token reassembly. Data callbacks are given a string a piece at a time
+ * when it is split across http_parser_execute() calls. With
+ * parser->reassemble_tokens set on_header_field, on_header_value and
+ * on_path are each called once with the whole string instead. Strings that
+ * are not split are passed straight from the data as before, the pieces of
+ * those that are are gathered in parser->arena, in HTTP_TOKEN_BUF_SIZE
+ * bytes to start with. A split string without an arena, or when it cannot
+ * allocate, fails the parse with HPE_TOKEN_OVERFLOW.
+ *
+ * An obsolete line folded header value is still given a line at a time,
+ * with a " " for each fold in between.
+ *
+ * Collecting headers, see parser->headers and http_headers.h, reassembles
+ * header fields and values the same way, whether or not reassemble_tokens
+ * is set. The names and values are copied into parser->arena, a message
+ * with headers fails the parse with HPE_TOKEN_OVERFLOW without one. With
+ * a header_filter only the interesting headers are collected.
+ */
+
 /* Initializes an http_parser structure.  The second argument specifies if
  * it will be parsing requests or responses. 
  */
 void http_parser_init (http_parser *parser, enum http_parser_type);
 
+/* Returns the number of bytes parsed. When a CONNECT request or a protocol
+ * upgrade (e.g. WebSocket) is seen, parsing stops at the end of its headers
+ * with HTTP_FLAG_UPGRADE set and the return value is the offset in data
+ * where the tunnelled bytes begin. The parser will not consume any more
+ * data after that.
+ */
 size_t http_parser_execute (http_parser *parser, const char *data, size_t len);
 
+/* A convenience wrapper for parsing what every connection an epoll_wait()
+ * returned has read: http_parser_execute() is called for each parser in
+ * turn, parsers[i] parses lens[i] bytes of bufs[i] and parsed[i] is set to
+ * what it returns. Nothing is shared between the calls, the only thing it
+ * adds is prefetching the next parser and buffer while one is being
+ * parsed. Returns the number of parsers that have an error afterwards.
+ */
+size_t http_parser_execute_batch (http_parser *const *parsers,
+                                  const char *const *bufs,
+                                  const size_t *lens,
+                                  size_t *parsed,
+                                  size_t n);
+
+/* http_parser_execute() on writable data that moves the body down over
+ * the chunk framing as it goes. The body parsed by a call ends up
+ * contiguous in data, from where its first byte was, and on_body is
+ * called with all of it at once, at the end of the call or before
+ * on_message_complete. The bytes of data that were framing are
+ * overwritten. on_body_range is not called.
+ */
+size_t http_parser_execute_inplace (http_parser *parser, char *data, size_t len);
+
+/* Headers only mode. With parser->headers_only set http_parser_execute()
+ * stops at the start of the body of a message that has one, with
+ * HTTP_FLAG_BODY_PENDING set, and returns the offset of the body in data.
+ * The framing is in parser->transfer_encoding, parser->content_length and
+ * HTTP_FLAG_READ_UNTIL_EOF.
+ *
+ * A Content-Length or read until close body can then be passed on without
+ * the parser seeing it, say with splice(), telling it with
+ * http_parser_consume_body() how many bytes went by. It returns how many
+ * of them were body, less than len if the message ended first, and
+ * on_message_complete is called at the end of a Content-Length body.
+ * A chunked body has to be given to http_parser_execute() to find where
+ * it ends, as can any other body.
+ */
+size_t http_parser_consume_body (http_parser *parser, size_t len);
+
+/* Tell the parser the connection has closed. A response without a
+ * Content-Length or chunked encoding has its body delimited by the close,
+ * so this fires its on_message_complete. Returns non-zero, and sets an
+ * error, if the stream ended in the middle of any other message.
+ */
+int http_parser_finish (http_parser *parser);
+
 int http_parser_has_error (http_parser *parser);
 
+/* Checkpoints. http_parser_snapshot() writes the state of the message being
+ * parsed into buf as a pointer free blob of at most
+ * HTTP_PARSER_SNAPSHOT_SIZE bytes, http_parser_restore() puts it back into a
+ * parser, possibly in another process, so parsing can carry on there.
+ *
+ * The parser's configuration is not in the snapshot: callbacks, data, the
+ * router, the header filter and the decode buffers are those of the parser
+ * restored into, which must have been initialized for the same type of
+ * message. The decode buffers are the caller's to carry over. The route of
+ * the request is not carried over either and a snapshot cannot be taken
+ * while the path is being routed, while a string is being reassembled,
+ * once headers have been collected, from a callback of
+ * http_parser_execute_inplace() or after an error.
+ *
+ * http_parser_snapshot() returns the size of the blob, 0 if buf is too small
+ * or a snapshot cannot be taken now. http_parser_restore() returns 0, or -1
+ * if the blob is not a well formed snapshot from this version of the parser
+ * and its grammar for this type of message, and then the parser is left as
+ * it was.
+ */
+#define HTTP_PARSER_SNAPSHOT_SIZE 320
+
+size_t http_parser_snapshot (const http_parser *parser, char *buf, size_t len);
+int http_parser_restore (http_parser *parser, const char *buf, size_t len);
+
+/* Header interest sets. With parser->header_filter set the headers, and
+ * trailers, whose names are not in the set are parsed and skipped without
+ * any on_header_field or on_header_value calls. A name that is in the set
+ * is given to on_header_field in a single call, once it is complete.
+ *
+ * http_header_set_add() returns 0, or -1 if the set is full or the name
+ * is empty or longer than HTTP_MAX_HEADER_NAME_SIZE.
+ */
+void http_header_set_init (http_header_set *set);
+int http_header_set_add (http_header_set *set, const char *name);
+
+/* Decode the percent escapes of the request path into buf as the request
+ * line is parsed, the result is in parser->path_decoder. Decoding stops at
+ * the end of every request so a single buffer serves the whole connection.
+ * A path that decodes to more than size bytes fails the parse with
+ * HPE_DECODE_OVERFLOW. Pass a NULL buf to stop decoding.
+ *
+ * http_parser_decode_query_string() is the same for the query string, in
+ * parser->query_string_decoder, where "+" also decodes to a space.
+ */
+void http_parser_decode_path (http_parser *parser, char *buf, size_t size);
+void http_parser_decode_query_string (http_parser *parser, char *buf, size_t size);
+
+/* "GET" for HTTP_GET, NULL for HTTP_EXTENSION_METHOD or an unset method.
+ * The extension method token is in parser->method_token.buf, it is
+ * parser->method_size bytes long and not NUL terminated.
+ */
+const char *http_method_str (enum http_method method);
+
+/* The symbolic name ("HPE_INVALID_METHOD") and a short description of an
+ * error code. Both return static strings.
+ */
+const char *http_errno_name (enum http_errno err);
+const char *http_errno_description (enum http_errno err);
+
 int http_parser_should_keep_alive (http_parser *parser);
 
 #ifdef __cplusplus
@@ -25,6 +25,10 @@
 #include "http_parser.h"
 #include <limits.h>
 #include <assert.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 static int unhex[] = {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
                      ,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
@@ -38,17 +42,43 @@ static int unhex[] = {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
 #define TRUE 1
 #define FALSE 0
 #define MIN(a,b) (a < b ? a : b)
+#ifndef NULL
 #define NULL (void*)(0)
+#endif
 
 #define MAX_FIELD_SIZE 80*1024
 
+#if defined(__GNUC__)
+# define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+# define PREFETCH(addr)
+#endif
+
 #define REMAINING (unsigned long)(pe - p)
+
+#define SET_ERROR(ERRNO)                                             \
+do {                                                                 \
+  parser->error = TRUE;                                              \
+  parser->http_errno = (ERRNO);                                      \
+  parser->error_offset = p - buffer;                                 \
+} while(0)
+
+/* Used by the ragel error actions. More than one may be embedded in the
+ * failing state, so the first (innermost) one to run wins.
+ */
+#define SET_PARSE_ERROR(ERRNO)                                       \
+do {                                                                 \
+  if (parser->http_errno == HPE_OK) {                                \
+    SET_ERROR(ERRNO);                                                \
+  }                                                                  \
+} while(0)
+
 #define CALLBACK(FOR)                                                \
 do {                                                                 \
   if (parser->FOR##_mark) {                                          \
     parser->FOR##_size += p - parser->FOR##_mark;                    \
     if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
-      parser->error = TRUE;                                          \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
       return 0;                                                      \
     }                                                                \
     if (parser->on_##FOR) {                                          \
@@ -59,38 +89,215 @@ do {                                                                 \
   }                                                                  \
 } while(0)
 
+#define DECODE(FOR)                                                  \
+do {                                                                 \
+  if (parser->FOR##_mark && parser->FOR##_decoder.buf) {             \
+    if (http_decoder_feed(&parser->FOR##_decoder,                    \
+          parser->FOR##_mark, p - parser->FOR##_mark)) {             \
+      SET_ERROR(HPE_DECODE_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* with a header_filter field names are gathered in header_name, up to
+ * HTTP_MAX_HEADER_NAME_SIZE, instead of being passed to on_header_field */
+#define BUFFER_FIELD                                                 \
+do {                                                                 \
+  if (parser->header_field_mark) {                                   \
+    tmp = p - parser->header_field_mark;                             \
+    if (parser->header_field_size + tmp <= HTTP_MAX_HEADER_NAME_SIZE) { \
+      memcpy(parser->header_name + parser->header_field_size,        \
+             parser->header_field_mark, tmp);                        \
+    }                                                                \
+    parser->header_field_size += tmp;                                \
+    if (parser->header_field_size > MAX_FIELD_SIZE) {                \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* CALLBACK without the callback, for the values of skipped headers */
+#define SKIP_CALLBACK(FOR)                                           \
+do {                                                                 \
+  if (parser->FOR##_mark) {                                          \
+    parser->FOR##_size += p - parser->FOR##_mark;                    \
+    if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+  }                                                                  \
+} while(0)
+
+/* if KEEP the piece of FOR at the end of the data is kept until the rest
+ * of it is parsed */
+#define PARTIAL_CALLBACK(FOR, KEEP)                                  \
+do {                                                                 \
+  if ((KEEP) && parser->FOR##_mark) {                                \
+    tmp = p - parser->FOR##_mark;                                    \
+    parser->FOR##_size += tmp;                                       \
+    if (parser->FOR##_size > MAX_FIELD_SIZE) {                       \
+      SET_ERROR(HPE_HEADER_OVERFLOW);                                \
+      return 0;                                                      \
+    }                                                                \
+    if (token_append(parser, parser->FOR##_mark, tmp) != 0) {        \
+      SET_ERROR(HPE_TOKEN_OVERFLOW);                                 \
+      return 0;                                                      \
+    }                                                                \
+  } else {                                                           \
+    CALLBACK(FOR);                                                   \
+  }                                                                  \
+} while(0)
+
+/* the end of FOR in token_at and token_length, all of it if pieces have
+ * been kept */
+#define TOKEN(FOR)                                                   \
+do {                                                                 \
+  tmp = p - parser->FOR##_mark;                                      \
+  parser->FOR##_size += tmp;                                         \
+  if (parser->FOR##_size > MAX_FIELD_SIZE) {                         \
+    SET_ERROR(HPE_HEADER_OVERFLOW);                                  \
+    return 0;                                                        \
+  }                                                                  \
+  if (parser->token_len > 0) {                                       \
+    if (token_append(parser, parser->FOR##_mark, tmp) != 0) {        \
+      SET_ERROR(HPE_TOKEN_OVERFLOW);                                 \
+      return 0;                                                      \
+    }                                                                \
+    token_at = parser->token_buf;                                    \
+    token_length = parser->token_len;                                \
+    parser->token_len = 0;                                           \
+  } else {                                                           \
+    token_at = parser->FOR##_mark;                                   \
+    token_length = tmp;                                              \
+  }                                                                  \
+} while(0)
+
+#define TOKEN_CALLBACK(FOR)                                          \
+do {                                                                 \
+  TOKEN(FOR);                                                        \
+  if (parser->on_##FOR) {                                            \
+    callback_return_value = parser->on_##FOR(parser,                 \
+      token_at, token_length);                                       \
+  }                                                                  \
+} while(0)
+
+#define ROUTE                                                        \
+do {                                                                 \
+  if (parser->path_mark && parser->router) {                         \
+    http_route_feed(parser->route,                                   \
+        parser->path_mark, p - parser->path_mark);                   \
+  }                                                                  \
+} while(0)
+
 #define RESET_PARSER(parser)                                         \
     parser->chunk_size = 0;                                          \
     parser->eating = 0;                                              \
+    parser->skip_header = 0;                                         \
+    parser->framing = 0;                                             \
+    parser->token_len = 0;                                           \
+    parser->token_buf = NULL;                                        \
+    parser->token_buf_size = 0;                                      \
+    if (parser->arena) http_arena_reset(parser->arena);              \
+    if (parser->headers) http_headers_clear(parser->headers);        \
     parser->header_field_mark = NULL;                                \
     parser->header_value_mark = NULL;                                \
     parser->query_string_mark = NULL;                                \
     parser->path_mark = NULL;                                        \
     parser->uri_mark = NULL;                                         \
     parser->fragment_mark = NULL;                                    \
+    parser->chunk_extension_mark = NULL;                             \
+    parser->scheme_mark = NULL;                                      \
+    parser->host_mark = NULL;                                        \
     parser->status_code = 0;                                         \
     parser->method = 0;                                              \
+    parser->port = 0;                                                \
+    parser->path_decoder.len = 0;                                    \
+    parser->path_decoder.state = 0;                                  \
+    parser->query_string_decoder.len = 0;                            \
+    parser->query_string_decoder.state = 0;                          \
+    if (parser->route) {                                             \
+      parser->route->route_id = HTTP_NO_ROUTE;                       \
+      parser->route->nparams = 0;                                    \
+      parser->route->node = NULL;                                    \
+    }                                                                \
     parser->transfer_encoding = HTTP_IDENTITY;                       \
     parser->version_major = 0;                                       \
     parser->version_minor = 0;                                       \
     parser->keep_alive = -1;                                         \
+    parser->flags = 0;                                               \
     parser->content_length = 0;                                      \
     parser->body_read = 0; 
 
 #define END_REQUEST                                                  \
 do {                                                                 \
-    if (parser->on_message_complete) {                               \
+    if (parser->inplace_begin) {                                     \
+      callback_return_value = inplace_flush(parser);                 \
+    }                                                                \
+    if (callback_return_value == 0 && parser->on_message_complete) { \
       callback_return_value =                                        \
         parser->on_message_complete(parser);                         \
     }                                                                \
     RESET_PARSER(parser);                                            \
 } while (0)
 
+/* where q is in the stream */
+#define STREAM_OFFSET(q) (parser->stream_offset + (uint64_t)((q) - buffer))
+
+/* a response body with no Content-Length, or whose last transfer coding is
+ * not chunked, runs until the connection closes */
+#define UNFRAMED_RESPONSE                                            \
+  (!(parser->flags & HTTP_FLAG_CONTENT_LENGTH) ||                    \
+   (parser->flags & HTTP_FLAG_UNCHUNKED))
+
+/* body bytes go to on_body, or only where they are to on_body_range */
+#define BODY(at, length)                                             \
+do {                                                                 \
+  if (parser->on_body_range) {                                       \
+    callback_return_value = parser->on_body_range(parser,            \
+        STREAM_OFFSET(at), (length));                                \
+  } else if (parser->on_body) {                                      \
+    callback_return_value = parser->on_body(parser, (at), (length)); \
+  }                                                                  \
+} while (0)
+
+/* the chunk framing from framing_offset up to q */
+#define FRAMING(q)                                                   \
+do {                                                                 \
+  if (parser->on_framing_range &&                                    \
+      STREAM_OFFSET(q) > parser->framing_offset) {                   \
+    callback_return_value = parser->on_framing_range(parser,         \
+        parser->framing_offset,                                      \
+        STREAM_OFFSET(q) - parser->framing_offset);                  \
+  }                                                                  \
+  parser->framing_offset = STREAM_OFFSET(q);                         \
+} while (0)
+
+/* moves the body down to the end of what has been moved so far */
+#define INPLACE(at, length)                                          \
+do {                                                                 \
+  if (parser->inplace_begin == NULL) {                               \
+    parser->inplace_begin = parser->inplace_end = (char *)(at);      \
+  } else if (parser->inplace_end != (at)) {                          \
+    memmove(parser->inplace_end, (at), (length));                    \
+  }                                                                  \
+  parser->inplace_end += (length);                                   \
+} while (0)
+
 #define SKIP_BODY(nskip)                                             \
 do {                                                                 \
   tmp = (nskip);                                                     \
-  if (parser->on_body && tmp > 0) {                                  \
-    callback_return_value = parser->on_body(parser, p, tmp);         \
+  if (parser->framing) {                                             \
+    FRAMING(p);                                                      \
+    parser->framing = FALSE;                                         \
+  }                                                                  \
+  if (callback_return_value == 0 && tmp > 0) {                       \
+    if (parser->inplace) {                                           \
+      INPLACE(p, tmp);                                               \
+    } else {                                                         \
+      BODY(p, tmp);                                                  \
+    }                                                                \
   }                                                                  \
   if (callback_return_value == 0) {                                  \
     p += tmp;                                                        \
@@ -100,6 +307,9 @@ do {                                                                 \
       parser->eating = FALSE;                                        \
       if (parser->transfer_encoding == HTTP_IDENTITY) {              \
         END_REQUEST;                                                 \
+      } else {                                                       \
+        parser->framing = TRUE;                                      \
+        parser->framing_offset = STREAM_OFFSET(p);                   \
       }                                                              \
     } else {                                                         \
       parser->eating = TRUE;                                         \
@@ -107,9 +317,239 @@ do {                                                                 \
   }                                                                  \
 } while (0)
 
+/* the body moved together by http_parser_execute_inplace() goes to
+ * on_body in one piece */
+static int
+inplace_flush (http_parser *parser)
+{
+  size_t length = parser->inplace_end - parser->inplace_begin;
+  int callback_return_value = 0;
+
+  if (parser->on_body && length > 0) {
+    callback_return_value = parser->on_body(parser, parser->inplace_begin, length);
+  }
+  parser->inplace_begin = parser->inplace_end = NULL;
+  return callback_return_value;
+}
+
+/* the string being reassembled is kept in the arena, from when the first
+ * string of a message is split, and doubles when it outgrows that */
+static int
+token_append (http_parser *parser, const char *at, size_t length)
+{
+  size_t len = parser->token_len + length;
+
+  if (length == 0) return 0;
+  if (len > parser->token_buf_size) {
+    /* the old buffer goes back with the rest of the arena at the end of
+     * the message */
+    size_t size = len > 2 * parser->token_buf_size ?
+                  len : 2 * parser->token_buf_size;
+    char *buf;
+
+    if (size < HTTP_TOKEN_BUF_SIZE) size = HTTP_TOKEN_BUF_SIZE;
+    if (parser->arena == NULL) return -1;
+    buf = http_arena_alloc(parser->arena, size);
+    if (buf == NULL) return -1;
+    if (parser->token_len > 0) memcpy(buf, parser->token_buf, parser->token_len);
+    parser->token_buf = buf;
+    parser->token_buf_size = size;
+  }
+  memcpy(parser->token_buf + parser->token_len, at, length);
+  parser->token_len = len;
+  return 0;
+}
+
+#define LOWER(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+
+/* FNV-1a of the lower cased name */
+static unsigned int
+header_hash (const char *name, size_t length)
+{
+  unsigned int hash = 2166136261u;
+
+  while (length--) {
+    hash ^= (unsigned char)LOWER(*name);
+    hash *= 16777619u;
+    name++;
+  }
+  return hash;
+}
+
+static int
+header_set_contains (const http_header_set *set, const char *name, size_t length)
+{
+  unsigned int i = header_hash(name, length) & (HTTP_HEADER_SET_SLOTS - 1);
+  unsigned int n, j;
+
+  for (n = 0; n < HTTP_HEADER_SET_SLOTS; n++) {
+    if (set->length[i] == 0) return FALSE;
+    if (set->length[i] == length) {
+      for (j = 0; j < length && set->name[i][j] == LOWER(name[j]); j++) ;
+      if (j == length) return TRUE;
+    }
+    i = (i + 1) & (HTTP_HEADER_SET_SLOTS - 1);
+  }
+  return FALSE;
+}
+
+void
+http_header_set_init (http_header_set *set)
+{
+  memset(set->length, 0, sizeof(set->length));
+}
+
+int
+http_header_set_add (http_header_set *set, const char *name)
+{
+  size_t length = strlen(name);
+  unsigned int i, n, j;
+
+  if (length == 0 || length > HTTP_MAX_HEADER_NAME_SIZE) return -1;
+  if (header_set_contains(set, name, length)) return 0;
+
+  i = header_hash(name, length) & (HTTP_HEADER_SET_SLOTS - 1);
+  for (n = 0; n < HTTP_HEADER_SET_SLOTS; n++) {
+    if (set->length[i] == 0) {
+      for (j = 0; j < length; j++) set->name[i][j] = LOWER(name[j]);
+      set->length[i] = length;
+      return 0;
+    }
+    i = (i + 1) & (HTTP_HEADER_SET_SLOTS - 1);
+  }
+  return -1;
+}
+
+/* Returns the first '%', or '+' when that decodes to a space, in
+ * [p, end) or end if there is none.
+ */
+static const char *
+decoder_scan (const char *p, const char *end, int plus_is_space)
+{
+#ifdef __SSE2__
+  const __m128i percent = _mm_set1_epi8('%');
+  const __m128i plus = _mm_set1_epi8(plus_is_space ? '+' : '%');
+  __m128i chunk;
+  int mask;
+
+  while (end - p >= 16) {
+    chunk = _mm_loadu_si128((const __m128i *)p);
+    mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, percent),
+                                          _mm_cmpeq_epi8(chunk, plus)));
+    if (mask) return p + __builtin_ctz(mask);
+    p += 16;
+  }
+#endif
+  while (p < end && *p != '%' && !(plus_is_space && *p == '+')) p++;
+  return p;
+}
+
+/* Appends the decoding of [at, at + length) to dec->buf. An escape may be
+ * split across calls, the grammar has already checked its hex digits.
+ * Returns non-zero if dec->buf is full.
+ */
+static int
+http_decoder_feed (http_decoder *dec, const char *at, size_t length)
+{
+  const char *end = at + length;
+  const char *run;
+
+  while (at < end) {
+    if (dec->state == 2) {
+      dec->hi = unhex[(unsigned char)*at++];
+      dec->state = 1;
+      continue;
+    }
+    if (dec->state == 1) {
+      if (dec->len == dec->size) return 1;
+      dec->buf[dec->len++] = (char)(dec->hi << 4 | unhex[(unsigned char)*at++]);
+      dec->state = 0;
+      continue;
+    }
+
+    run = decoder_scan(at, end, dec->plus_is_space);
+    if ((size_t)(run - at) > dec->size - dec->len) return 1;
+    memcpy(dec->buf + dec->len, at, run - at);
+    dec->len += run - at;
+    at = run;
+
+    if (at == end) break;
+    if (*at == '+') {
+      if (dec->len == dec->size) return 1;
+      dec->buf[dec->len++] = ' ';
+    } else {
+      dec->state = 2;
+    }
+    at++;
+  }
+  return 0;
+}
+
+/* The known methods, in the order of HTTP_METHOD_MAP. The names are zero
+ * padded to 16 bytes so a token is compared a word at a time rather than a
+ * character at a time.
+ */
+static const struct {
+  union {
+    char     name[16];
+    uint64_t word[2];
+  } token;
+  unsigned char size;
+  unsigned char method;
+} methods[] = {
+#define HTTP_METHOD_ENTRY_GEN(n, s) { { s }, sizeof(s) - 1, HTTP_##n },
+  HTTP_METHOD_MAP(HTTP_METHOD_ENTRY_GEN)
+#undef HTTP_METHOD_ENTRY_GEN
+};
+
+static enum http_method
+lookup_method (http_parser *parser)
+{
+  unsigned int i;
+
+  if (parser->method_size > sizeof(methods[0].token.name)) {
+    return HTTP_EXTENSION_METHOD;
+  }
+  for (i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+    if (methods[i].size == parser->method_size &&
+        methods[i].token.word[0] == parser->method_token.word[0] &&
+        methods[i].token.word[1] == parser->method_token.word[1]) {
+      return methods[i].method;
+    }
+  }
+  return HTTP_EXTENSION_METHOD;
+}
+
 %%{
   machine http_parser;
 
+  action start_method {
+    parser->method_token.word[0] = 0;
+    parser->method_token.word[1] = 0;
+    parser->method_token.word[2] = 0;
+    parser->method_size = 0;
+  }
+
+  action method_char {
+    if (parser->method_size == HTTP_MAX_METHOD_SIZE) {
+      SET_ERROR(HPE_INVALID_METHOD);
+      return 0;
+    }
+    parser->method_token.buf[parser->method_size++] = *p;
+  }
+
+  action method {
+    parser->method = lookup_method(parser);
+    if (parser->method == HTTP_EXTENSION_METHOD && parser->on_extension_method) {
+      callback_return_value = parser->on_extension_method(parser,
+        parser->method_token.buf, parser->method_size);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+
   action mark_header_field {
     parser->header_field_mark = p;
     parser->header_field_size = 0;
@@ -133,6 +573,7 @@ do {                                                                 \
   action mark_request_path {
     parser->path_mark = p;
     parser->path_size = 0;
+    if (parser->router) http_route_start(parser->route, parser->router);
   }
 
   action mark_request_uri {
@@ -140,10 +581,46 @@ do {                                                                 \
     parser->uri_size = 0;
   }
 
+  action mark_chunk_extension {
+    parser->chunk_extension_mark = p;
+    parser->chunk_extension_size = 0;
+  }
+
+  action mark_scheme {
+    parser->scheme_mark = p;
+    parser->scheme_size = 0;
+  }
+
+  action mark_host {
+    parser->host_mark = p;
+    parser->host_size = 0;
+  }
+
   action header_field {
-    CALLBACK(header_field);
+    if (parser->header_filter) {
+      BUFFER_FIELD;
+      parser->skip_header =
+        parser->header_field_size > HTTP_MAX_HEADER_NAME_SIZE ||
+        !header_set_contains(parser->header_filter,
+                             parser->header_name, parser->header_field_size);
+      if (!parser->skip_header && parser->on_header_field) {
+        callback_return_value = parser->on_header_field(parser,
+          parser->header_name, parser->header_field_size);
+      }
+      token_at = parser->header_name;
+      token_length = parser->header_field_size;
+    } else {
+      parser->skip_header = FALSE;
+      TOKEN_CALLBACK(header_field);
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add(parser->headers, parser->arena,
+                         token_at, token_length) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
       return 0;
     }
     parser->header_field_mark = NULL;
@@ -151,9 +628,19 @@ do {                                                                 \
   }
 
   action header_value {
-    CALLBACK(header_value);
+    if (parser->skip_header) {
+      SKIP_CALLBACK(header_value);
+    } else {
+      TOKEN_CALLBACK(header_value);
+      if (callback_return_value == 0 && parser->headers &&
+          http_headers_add_value(parser->headers, parser->arena,
+                                 token_at, token_length) != 0) {
+        SET_ERROR(HPE_TOKEN_OVERFLOW);
+        return 0;
+      }
+    }
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->header_value_mark = NULL;
@@ -163,7 +650,7 @@ do {                                                                 \
   action request_uri { 
     CALLBACK(uri);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->uri_mark = NULL;
@@ -173,7 +660,7 @@ do {                                                                 \
   action fragment { 
     CALLBACK(fragment);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->fragment_mark = NULL;
@@ -181,9 +668,10 @@ do {                                                                 \
   }
 
   action query_string { 
+    DECODE(query_string);
     CALLBACK(query_string);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->query_string_mark = NULL;
@@ -191,30 +679,112 @@ do {                                                                 \
   }
 
   action request_path {
-    CALLBACK(path);
+    DECODE(path);
+    ROUTE;
+    TOKEN_CALLBACK(path);
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
     parser->path_mark = NULL;
     parser->path_size = 0;
+
+    if (parser->router) {
+      http_route_finish(parser->route);
+      if (parser->on_route) {
+        callback_return_value = parser->on_route(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+    }
+  }
+
+  action scheme {
+    CALLBACK(scheme);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->scheme_mark = NULL;
+    parser->scheme_size = 0;
+  }
+
+  action host {
+    CALLBACK(host);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->host_mark = NULL;
+    parser->host_size = 0;
+  }
+
+  action port {
+    tmp = parser->port * 10 + (*p - '0');
+    if (tmp > USHRT_MAX) {
+      SET_ERROR(HPE_INVALID_URI);
+      return 0;
+    }
+    parser->port = tmp;
+  }
+
+  # the request-target form depends on the method, see Request_URI
+  action is_connect  { parser->method == HTTP_CONNECT }
+  action not_connect { parser->method != HTTP_CONNECT }
+
+  action chunk_extension {
+    CALLBACK(chunk_extension);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+    parser->chunk_extension_mark = NULL;
+    parser->chunk_extension_size = 0;
+  }
+
+  action chunk_header {
+    if(parser->on_chunk_header) {
+      callback_return_value = parser->on_chunk_header(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+  }
+
+  action chunk_complete {
+    if(parser->on_chunk_complete) {
+      callback_return_value = parser->on_chunk_complete(parser);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
   }
 
   action headers_complete {
+    if (parser->type == HTTP_REQUEST && parser->flags & HTTP_FLAG_UNCHUNKED) {
+      /* there is no telling where the body ends, RFC 7230 3.3.3 */
+      SET_ERROR(HPE_INVALID_TRANSFER_ENCODING);
+      return 0;
+    }
     if(parser->on_headers_complete) {
       callback_return_value = parser->on_headers_complete(parser);
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
     }
   }
 
   action begin_message {
+    parser->flags |= HTTP_FLAG_IN_MESSAGE;
     if(parser->on_message_begin) {
       callback_return_value = parser->on_message_begin(parser);
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
     }
@@ -222,9 +792,10 @@ do {                                                                 \
 
   action content_length {
     if (parser->content_length > INT_MAX) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_INVALID_CONTENT_LENGTH);
       return 0;
     }
+    parser->flags |= HTTP_FLAG_CONTENT_LENGTH;
     parser->content_length *= 10;
     parser->content_length += *p - '0';
   }
@@ -234,23 +805,69 @@ do {                                                                 \
     parser->status_code += *p - '0';
   }
 
-  action use_identity_encoding { parser->transfer_encoding = HTTP_IDENTITY; }
-  action use_chunked_encoding  { parser->transfer_encoding = HTTP_CHUNKED;  }
+  action err_method         { SET_PARSE_ERROR(HPE_INVALID_METHOD);         }
+  action err_uri            { SET_PARSE_ERROR(HPE_INVALID_URI);            }
+  action err_version        { SET_PARSE_ERROR(HPE_INVALID_VERSION);        }
+  action err_status         { SET_PARSE_ERROR(HPE_INVALID_STATUS);         }
+  action err_header         { SET_PARSE_ERROR(HPE_INVALID_HEADER);         }
+  action err_chunk_size     { SET_PARSE_ERROR(HPE_INVALID_CHUNK_SIZE);     }
+  action err_chunk          { SET_PARSE_ERROR(HPE_INVALID_CHUNK);          }
+
+  action use_other_encoding {
+    parser->transfer_encoding = HTTP_IDENTITY;
+    parser->flags |= HTTP_FLAG_UNCHUNKED;
+  }
+  action use_chunked_encoding {
+    parser->transfer_encoding = HTTP_CHUNKED;
+    parser->flags &= ~HTTP_FLAG_UNCHUNKED;
+  }
 
-  action set_keep_alive { parser->keep_alive = TRUE; }
+  # close wins no matter what order the options come in
+  action set_keep_alive { if (parser->keep_alive != FALSE) parser->keep_alive = TRUE; }
   action set_not_keep_alive { parser->keep_alive = FALSE; }
+  action set_connection_upgrade { parser->flags |= HTTP_FLAG_CONNECTION_UPGRADE; }
+  action set_upgrade_header { parser->flags |= HTTP_FLAG_UPGRADE_HEADER; }
+  action set_expect_continue { parser->flags |= HTTP_FLAG_EXPECT_CONTINUE; }
+
+  # obs-fold: a continuation line is joined onto the value with one space
+  action fold_header_value {
+    if (parser->on_header_value && !parser->skip_header) {
+      callback_return_value = parser->on_header_value(parser, " ", 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    if (parser->headers && !parser->skip_header &&
+        http_headers_add_value(parser->headers, parser->arena, " ", 1) != 0) {
+      SET_ERROR(HPE_TOKEN_OVERFLOW);
+      return 0;
+    }
+  }
 
   action version_major {
+    if (parser->version_major > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
+      return 0;
+    }
     parser->version_major *= 10;
     parser->version_major += *p - '0';
   }
 
   action version_minor {
+    if (parser->version_minor > (USHRT_MAX - 9) / 10) {
+      SET_ERROR(HPE_INVALID_VERSION);
+      return 0;
+    }
     parser->version_minor *= 10;
     parser->version_minor += *p - '0';
   }
 
   action add_to_chunk_size {
+    if (parser->chunk_size > INT_MAX) {
+      SET_ERROR(HPE_CHUNK_SIZE_OVERFLOW);
+      return 0;
+    }
     parser->chunk_size *= 16;
     parser->chunk_size += unhex[(int)*p];
   }
@@ -258,7 +875,7 @@ do {                                                                 \
   action skip_chunk_data {
     SKIP_BODY(MIN(parser->chunk_size, REMAINING));
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
 
@@ -270,7 +887,18 @@ do {                                                                 \
     }
   }
 
+  action begin_trailers {
+    parser->flags |= HTTP_FLAG_TRAILER;
+  }
+
   action end_chunked_body {
+    if (parser->framing) {
+      FRAMING(p + 1);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
     END_REQUEST;
     if (parser->type == HTTP_REQUEST) {
       fnext Requests;
@@ -280,8 +908,72 @@ do {                                                                 \
   }
 
   action body_logic {
-    if (parser->transfer_encoding == HTTP_CHUNKED) {
+    if ((parser->type == HTTP_REQUEST && 
+         (parser->method == HTTP_CONNECT || 
+          (parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+           parser->flags & HTTP_FLAG_UPGRADE_HEADER))) ||
+        (parser->type == HTTP_RESPONSE &&
+         parser->status_code == 101 && 
+         parser->flags & HTTP_FLAG_CONNECTION_UPGRADE &&
+         parser->flags & HTTP_FLAG_UPGRADE_HEADER)) {
+      /* the rest of the stream is another protocol, stop right after the
+       * headers and leave it to the caller */
+      parser->flags |= HTTP_FLAG_UPGRADE;
+      if (parser->on_message_complete) {
+        callback_return_value = parser->on_message_complete(parser);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      fbreak;
+    } else if (parser->flags & HTTP_FLAG_SKIP_BODY || 
+        (parser->type == HTTP_RESPONSE &&
+         (parser->status_code / 100 == 1 || 
+          parser->status_code == 204 || 
+          parser->status_code == 304))) {
+      /* no body whatever the headers say, go straight to the next message */
+      END_REQUEST;
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    } else if (parser->headers_only &&
+               (parser->transfer_encoding == HTTP_CHUNKED ||
+                parser->content_length > 0 ||
+                (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE))) {
+      /* stop at the start of the body, the caller takes it from here */
+      parser->flags |= HTTP_FLAG_BODY_PENDING;
+      if (parser->transfer_encoding == HTTP_CHUNKED) {
+        parser->framing = TRUE;
+        parser->framing_offset = STREAM_OFFSET(p + 1);
+        fnext ChunkedBody;
+      } else if (UNFRAMED_RESPONSE) {
+        parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      } else {
+        parser->chunk_size = parser->content_length;
+        parser->eating = TRUE;
+      }
+      fbreak;
+    } else if (parser->transfer_encoding == HTTP_CHUNKED) {
+      parser->framing = TRUE;
+      parser->framing_offset = STREAM_OFFSET(p + 1);
       fnext ChunkedBody;
+    } else if (parser->type == HTTP_RESPONSE && UNFRAMED_RESPONSE) {
+      /* no framing, everything up to the connection closing is body */
+      parser->flags |= HTTP_FLAG_READ_UNTIL_EOF;
+      p += 1;
+      if (REMAINING > 0) {
+        BODY(p, REMAINING);
+        if (callback_return_value != 0) {
+          SET_ERROR(HPE_CALLBACK_ABORT);
+          return 0;
+        }
+      }
+      parser->body_read += REMAINING;
+      p = pe;
+      fhold;
+      fbreak;
     } else {
       /* this is pretty stupid. i'd prefer to combine this with skip_chunk_data */
       parser->chunk_size = parser->content_length;
@@ -290,7 +982,7 @@ do {                                                                 \
       SKIP_BODY(MIN(REMAINING, parser->content_length));
 
       if (callback_return_value != 0) {
-        parser->error = TRUE;
+        SET_ERROR(HPE_CALLBACK_ABORT);
         return 0;
       }
 
@@ -326,33 +1018,34 @@ do {                                                                 \
 
 #  headers
 
-  Method = ( "COPY"      %{ parser->method = HTTP_COPY;      }
-           | "DELETE"    %{ parser->method = HTTP_DELETE;    }
-           | "GET"       %{ parser->method = HTTP_GET;       }
-           | "HEAD"      %{ parser->method = HTTP_HEAD;      }
-           | "LOCK"      %{ parser->method = HTTP_LOCK;      }
-           | "MKCOL"     %{ parser->method = HTTP_MKCOL;     }
-           | "MOVE"      %{ parser->method = HTTP_MOVE;      }
-           | "OPTIONS"   %{ parser->method = HTTP_OPTIONS;   }
-           | "POST"      %{ parser->method = HTTP_POST;      }
-           | "PROPFIND"  %{ parser->method = HTTP_PROPFIND;  }
-           | "PROPPATCH" %{ parser->method = HTTP_PROPPATCH; }
-           | "PUT"       %{ parser->method = HTTP_PUT;       }
-           | "TRACE"     %{ parser->method = HTTP_TRACE;     }
-           | "UNLOCK"    %{ parser->method = HTTP_UNLOCK;    }
-           ); # Not allowing extension methods
-
-  HTTP_Version = "HTTP/" digit $version_major "." digit $version_minor;
+  Method = token+ >start_method $method_char %method $err(err_method);
+
+  HTTP_Version = ( "HTTP/" digit+ $version_major "." digit+ $version_minor ) $err(err_version);
 
   scheme = ( alpha | digit | "+" | "-" | "." )* ;
-  absolute_uri = (scheme ":" (uchar | reserved )*);
   path = ( pchar+ ( "/" pchar* )* ) ;
   query = ( uchar | reserved )* >mark_query_string %query_string ;
   param = ( pchar | "/" )* ;
   params = ( param ( ";" param )* ) ;
   rel_path = ( path? (";" params)? ) ;
   absolute_path = ( "/"+ rel_path ) >mark_request_path %request_path ("?" query)?;
-  Request_URI = ( "*" | absolute_uri | absolute_path ) >mark_request_uri %request_uri;
+
+  # userinfo is not accepted, RFC 7230 forbids it in http(s) targets
+  host_char = ( unreserved - ( "[" | "]" ) ) | escape;
+  IP_literal = "[" ( xdigit | ":" | "." )+ >mark_host %host "]";
+  reg_name = host_char+ >mark_host %host;
+  authority = ( IP_literal | reg_name ) ( ":" digit* $port )?;
+  absolute_uri = ( scheme >mark_scheme %scheme ":"
+                   ( "//" authority ( absolute_path | "?" query )?
+                   | ( (uchar | reserved)* - ( "//" any* ) )
+                   )
+                 );
+  authority_form = ( IP_literal | reg_name ) ":" digit+ $port;
+
+  Request_URI = ( "*"
+                | ( ( absolute_uri | absolute_path ) when not_connect )
+                | ( authority_form when is_connect )
+                ) >mark_request_uri %request_uri $err(err_uri);
   Fragment = ( uchar | reserved )* >mark_fragment %fragment;
 
   field_name = ( token -- ":" )+;
@@ -362,38 +1055,59 @@ do {                                                                 \
   Field_Value = field_value >mark_header_value %header_value;
 
   hsep = ":" " "*;
-  header = (field_name hsep field_value) :> CRLF;
+
+  folded_value = ((any - (" " | "\t")) any*)?;
+  Folded_Line = ( (" " | "\t")+ >fold_header_value
+                  folded_value >mark_header_value %header_value
+                ) :> CRLF;
+
+# comma separated token lists, "gzip, chunked" or "keep-alive, Upgrade"
+  ows = (" " | "\t")*;
+  list_sep = ows ("," ows)+;
+  connection_option = ( "keep-alive"i %set_keep_alive
+                      | "close"i %set_not_keep_alive
+                      | "upgrade"i %set_connection_upgrade
+                      | token+
+                      );
+  # "websocket" or "HTTP/2.0", an empty Upgrade asks for nothing
+  upgrade_protocol = token+ ("/" token+)?;
+  # chunked is only in effect if it is the final coding, identity (RFC 2616)
+  # is no coding at all
+  transfer_coding = ( "chunked"i %use_chunked_encoding
+                    | "identity"i
+                    | (token+ - ("chunked"i | "identity"i)) %use_other_encoding
+                    );
   Header = ( ("Content-Length"i hsep digit+ $content_length)
-           | ("Connection"i hsep 
-               ( "Keep-Alive"i %set_keep_alive
-               | "close"i %set_not_keep_alive
-               )
-             )
-           | ("Transfer-Encoding"i %use_chunked_encoding hsep "identity" %use_identity_encoding)
+           | ("Connection"i hsep connection_option (list_sep connection_option)*)
+           | ("Expect"i hsep "100-continue"i %set_expect_continue)
+           | ("Upgrade"i hsep (upgrade_protocol (list_sep upgrade_protocol)*) %set_upgrade_header)
+           | ("Transfer-Encoding"i hsep transfer_coding (list_sep transfer_coding)*)
            | (Field_Name hsep Field_Value)
-           ) :> CRLF;
+           ) :> CRLF Folded_Line*;
 
-  Headers = (Header)* :> CRLF @headers_complete;
+  Headers = ( (Header)* :> CRLF @headers_complete ) @err(err_header);
 
   Request_Line = ( Method " " Request_URI ("#" Fragment)? " " HTTP_Version CRLF ) ;
 
-  StatusCode = (digit digit digit) $status_code;
+  StatusCode = (digit digit digit) $status_code $err(err_status);
   ReasonPhrase =  ascii* -- ("\r" | "\n");
   StatusLine = HTTP_Version  " " StatusCode (" " ReasonPhrase)? CRLF;
 
 # chunked message
-  trailing_headers = header*;
+  Trailer = (Field_Name hsep Field_Value) :> CRLF Folded_Line*;
+  trailing_headers = Trailer*;
   #chunk_ext_val   = token | quoted_string;
   chunk_ext_val = token*;
   chunk_ext_name = token*;
-  chunk_extension = ( ";" " "* chunk_ext_name ("=" chunk_ext_val)? )*;
-  last_chunk = "0"+ chunk_extension CRLF;
-  chunk_size = (xdigit* [1-9a-fA-F] xdigit*) $add_to_chunk_size;
-  chunk_end  = CRLF;
+  chunk_extension = ( ";" " "* chunk_ext_name ("=" chunk_ext_val)? )+;
+  Chunk_Extension = chunk_extension >mark_chunk_extension %chunk_extension;
+  last_chunk = "0"+ Chunk_Extension? CRLF @chunk_header @chunk_complete @begin_trailers;
+  chunk_size = (xdigit* [1-9a-fA-F] xdigit*) $add_to_chunk_size $err(err_chunk_size);
+  chunk_end  = CRLF @chunk_complete;
   chunk_body = any >skip_chunk_data;
-  chunk_begin = chunk_size chunk_extension CRLF;
+  chunk_begin = chunk_size Chunk_Extension? CRLF @chunk_header;
   chunk = chunk_begin chunk_body chunk_end;
-  ChunkedBody := chunk* last_chunk trailing_headers CRLF @end_chunked_body;
+  ChunkedBody := ( chunk* last_chunk trailing_headers CRLF ) @err(err_chunk) @end_chunked_body;
 
   Request = (Request_Line Headers) >begin_message @body_logic;
   Response = (StatusLine Headers) >begin_message @body_logic;
@@ -422,66 +1136,527 @@ http_parser_init (http_parser *parser, enum http_parser_type type)
   parser->cs = cs;
   parser->type = type;
   parser->error = 0;
+  parser->http_errno = HPE_OK;
+  parser->error_offset = 0;
 
   parser->data = NULL;
+  parser->router = NULL;
+  parser->route = NULL;
+  parser->header_filter = NULL;
+  parser->header_name = NULL;
+  parser->headers_only = FALSE;
+  parser->reassemble_tokens = FALSE;
+  parser->arena = NULL;
+  parser->headers = NULL;
 
   parser->on_message_begin = NULL;
+  parser->on_extension_method = NULL;
+  parser->on_scheme = NULL;
+  parser->on_host = NULL;
   parser->on_path = NULL;
+  parser->on_route = NULL;
   parser->on_query_string = NULL;
   parser->on_uri = NULL;
   parser->on_fragment = NULL;
   parser->on_header_field = NULL;
   parser->on_header_value = NULL;
   parser->on_headers_complete = NULL;
+  parser->on_chunk_extension = NULL;
+  parser->on_chunk_header = NULL;
+  parser->on_chunk_complete = NULL;
   parser->on_body = NULL;
   parser->on_message_complete = NULL;
+  parser->on_body_range = NULL;
+  parser->on_framing_range = NULL;
+  parser->stream_offset = 0;
+  parser->inplace = FALSE;
+  parser->inplace_begin = parser->inplace_end = NULL;
+
+  http_parser_decode_path(parser, NULL, 0);
+  http_parser_decode_query_string(parser, NULL, 0);
 
   RESET_PARSER(parser);
 }
 
+void
+http_parser_decode_path (http_parser *parser, char *buf, size_t size)
+{
+  parser->path_decoder.buf = buf;
+  parser->path_decoder.size = size;
+  parser->path_decoder.len = 0;
+  parser->path_decoder.state = 0;
+  parser->path_decoder.plus_is_space = FALSE;
+}
+
+void
+http_parser_decode_query_string (http_parser *parser, char *buf, size_t size)
+{
+  parser->query_string_decoder.buf = buf;
+  parser->query_string_decoder.size = size;
+  parser->query_string_decoder.len = 0;
+  parser->query_string_decoder.state = 0;
+  parser->query_string_decoder.plus_is_space = TRUE;
+}
+
 /** exec **/
 size_t
 http_parser_execute (http_parser *parser, const char *buffer, size_t len)
 {
   size_t tmp; // REMOVE ME this is extremely hacky
+  const char *token_at;
+  size_t token_length;
   int callback_return_value = 0;
   const char *p, *pe;
+  const char *eof = NULL; /* the end of a buffer is not the end of the stream */
   int cs = parser->cs;
 
   p = buffer;
   pe = buffer+len;
 
+  if (parser->flags & HTTP_FLAG_UPGRADE) {
+    /* nothing after an upgrade is ours to parse */
+    return 0;
+  }
+
   if (0 < parser->chunk_size && parser->eating) {
     /* eat body */
     SKIP_BODY(MIN(len, parser->chunk_size));
     if (callback_return_value != 0) {
-      parser->error = TRUE;
+      SET_ERROR(HPE_CALLBACK_ABORT);
       return 0;
     }
   }
 
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    /* all of it is body until http_parser_finish() */
+    if (len > 0) {
+      BODY(p, len);
+      if (callback_return_value != 0) {
+        SET_ERROR(HPE_CALLBACK_ABORT);
+        return 0;
+      }
+    }
+    parser->body_read += len;
+    parser->stream_offset += len;
+    return len;
+  }
+
   if (parser->header_field_mark)   parser->header_field_mark   = buffer;
   if (parser->header_value_mark)   parser->header_value_mark   = buffer;
   if (parser->fragment_mark)       parser->fragment_mark       = buffer;
   if (parser->query_string_mark)   parser->query_string_mark   = buffer;
   if (parser->path_mark)           parser->path_mark           = buffer;
   if (parser->uri_mark)            parser->uri_mark            = buffer;
+  if (parser->chunk_extension_mark) parser->chunk_extension_mark = buffer;
+  if (parser->scheme_mark)         parser->scheme_mark         = buffer;
+  if (parser->host_mark)           parser->host_mark           = buffer;
 
   %% write exec;
 
   parser->cs = cs;
 
-  CALLBACK(header_field);
-  CALLBACK(header_value);
+  if (cs == http_parser_error && parser->http_errno == HPE_OK) {
+    SET_ERROR(HPE_UNKNOWN);
+  }
+
+  if (parser->header_filter) {
+    BUFFER_FIELD;
+  } else {
+    PARTIAL_CALLBACK(header_field, parser->reassemble_tokens || parser->headers);
+  }
+  if (parser->skip_header) {
+    SKIP_CALLBACK(header_value);
+  } else {
+    PARTIAL_CALLBACK(header_value, parser->reassemble_tokens || parser->headers);
+  }
   CALLBACK(fragment);
+  DECODE(query_string);
   CALLBACK(query_string);
-  CALLBACK(path);
+  DECODE(path);
+  ROUTE;
+  PARTIAL_CALLBACK(path, parser->reassemble_tokens);
   CALLBACK(uri);
+  CALLBACK(chunk_extension);
+  CALLBACK(scheme);
+  CALLBACK(host);
+
+  if (parser->framing) {
+    FRAMING(p);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+  }
+
+  if (parser->inplace_begin) {
+    callback_return_value = inplace_flush(parser);
+    if (callback_return_value != 0) {
+      SET_ERROR(HPE_CALLBACK_ABORT);
+      return 0;
+    }
+  }
 
   assert(p <= pe && "buffer overflow after parsing execute");
+  parser->stream_offset += p - buffer;
   return(p - buffer);
 }
 
+size_t
+http_parser_execute_inplace (http_parser *parser, char *data, size_t len)
+{
+  size_t parsed;
+
+  parser->inplace = TRUE;
+  parsed = http_parser_execute(parser, data, len);
+  parser->inplace = FALSE;
+  /* left over if it stopped with an error */
+  parser->inplace_begin = parser->inplace_end = NULL;
+  return parsed;
+}
+
+size_t
+http_parser_execute_batch (http_parser *const *parsers,
+                           const char *const *bufs,
+                           const size_t *lens,
+                           size_t *parsed,
+                           size_t n)
+{
+  size_t i, errors = 0;
+
+  for (i = 0; i < n; i++) {
+    if (i + 1 < n) {
+      /* the machine state and the marks, and the first of the data */
+      PREFETCH(parsers[i + 1]);
+      PREFETCH(&parsers[i + 1]->header_field_mark);
+      PREFETCH(bufs[i + 1]);
+    }
+    parsed[i] = http_parser_execute(parsers[i], bufs[i], lens[i]);
+    if (http_parser_has_error(parsers[i])) errors++;
+  }
+  return errors;
+}
+
+size_t
+http_parser_consume_body (http_parser *parser, size_t len)
+{
+  int callback_return_value = 0;
+
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    parser->body_read += len;
+    parser->stream_offset += len;
+    return len;
+  }
+  if (!parser->eating || parser->transfer_encoding != HTTP_IDENTITY) {
+    return 0;
+  }
+
+  len = MIN(len, parser->chunk_size);
+  parser->body_read += len;
+  parser->stream_offset += len;
+  parser->chunk_size -= len;
+  if (parser->chunk_size == 0) {
+    parser->eating = FALSE;
+    END_REQUEST;
+    if (callback_return_value != 0) {
+      parser->error = TRUE;
+      parser->http_errno = HPE_CALLBACK_ABORT;
+      parser->error_offset = 0;
+    }
+  }
+  return len;
+}
+
+int
+http_parser_finish (http_parser *parser)
+{
+  int callback_return_value = 0;
+
+  if (parser->flags & HTTP_FLAG_UPGRADE) {
+    return 0;
+  } else if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF) {
+    END_REQUEST;
+    if (callback_return_value != 0) {
+      parser->error = TRUE;
+      parser->http_errno = HPE_CALLBACK_ABORT;
+      parser->error_offset = 0;
+      return 1;
+    }
+  } else if (parser->flags & HTTP_FLAG_IN_MESSAGE) {
+    parser->error = TRUE;
+    parser->http_errno = HPE_INVALID_EOF_STATE;
+    parser->error_offset = 0;
+    return 1;
+  }
+  return 0;
+}
+
+/* Snapshots are a version byte, a fingerprint of the machine and then the
+ * fields in a fixed order, little endian. A data mark is only recorded as
+ * set, the data before it has been called back already and the mark is
+ * moved to the start of the next buffer parsed anyway.
+ */
+#define SNAPSHOT_VERSION 4
+
+/* bytes up to and including the size of the method token */
+#define SNAPSHOT_FIXED_SIZE 77
+
+/* ragel numbers the final states last, in the order the machines are
+ * instantiated. The only final state of Responses, the last of them, is its
+ * start, so it is the highest numbered state.
+ */
+#define SNAPSHOT_STATES (http_parser_en_Responses + 1)
+
+/* FNV-1a of the state count and the numbers ragel gives the start, first
+ * final and entry states, any change to the grammar moves some of them */
+static uint32_t
+machine_fingerprint (void)
+{
+  const int numbers[] = { SNAPSHOT_STATES, http_parser_start,
+    http_parser_first_final, http_parser_error, http_parser_en_main,
+    http_parser_en_ChunkedBody, http_parser_en_ChunkedBody_chunk_chunk_end,
+    http_parser_en_Requests, http_parser_en_Responses };
+  uint32_t hash = 2166136261u;
+  unsigned int i;
+  int b;
+
+  for (i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+    for (b = 0; b < 32; b += 8) {
+      hash ^= (numbers[i] >> b) & 0xff;
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
+
+#define SNAPSHOT_MARKS(XX)                                           \
+  XX(header_field)                                                   \
+  XX(header_value)                                                   \
+  XX(query_string)                                                   \
+  XX(path)                                                           \
+  XX(uri)                                                            \
+  XX(fragment)                                                       \
+  XX(chunk_extension)                                                \
+  XX(scheme)                                                         \
+  XX(host)
+
+/* what restored marks point at until the next http_parser_execute() */
+static const char restored_mark = '\0';
+
+static char *
+put_uint (char *out, uint64_t value, int bytes)
+{
+  while (bytes--) {
+    *out++ = (char)(value & 0xff);
+    value >>= 8;
+  }
+  return out;
+}
+
+static const char *
+get_uint (const char *in, uint64_t *value, int bytes)
+{
+  int i;
+
+  *value = 0;
+  for (i = 0; i < bytes; i++) {
+    *value |= (uint64_t)(unsigned char)in[i] << (8 * i);
+  }
+  return in + bytes;
+}
+
+/* the bits of _flags a parser can have between http_parser_execute() calls
+ * without an error */
+static unsigned char
+between_calls_flags (void)
+{
+  http_parser probe;
+
+  probe._flags = 0;
+  probe.eating = 1;
+  probe.skip_header = 1;
+  probe.framing = 1;
+  return probe._flags;
+}
+
+size_t
+http_parser_snapshot (const http_parser *parser, char *buf, size_t len)
+{
+  char *out = buf;
+  unsigned int marks = 0;
+  size_t name_size;
+
+  if (len < HTTP_PARSER_SNAPSHOT_SIZE) return 0;
+  /* the route match refers into the router */
+  if (parser->router && parser->route->node) return 0;
+  /* nor are the pieces of a string being reassembled or the headers
+   * collected, which are in the arena */
+  if (parser->token_len > 0) return 0;
+  if (parser->headers && parser->headers->count > 0) return 0;
+  /* nor the middle of http_parser_execute_inplace() or a failed parse */
+  if (parser->inplace || parser->error) return 0;
+
+  out = put_uint(out, SNAPSHOT_VERSION, 1);
+  out = put_uint(out, machine_fingerprint(), 4);
+  out = put_uint(out, parser->type, 1);
+  out = put_uint(out, parser->cs, 4);
+  out = put_uint(out, parser->_flags, 1);
+  out = put_uint(out, parser->chunk_size, 8);
+  out = put_uint(out, parser->body_read, 8);
+  out = put_uint(out, parser->content_length, 8);
+  out = put_uint(out, parser->status_code, 2);
+  out = put_uint(out, parser->method, 2);
+  out = put_uint(out, parser->port, 2);
+  out = put_uint(out, (unsigned short)parser->transfer_encoding, 2);
+  out = put_uint(out, parser->version_major, 2);
+  out = put_uint(out, parser->version_minor, 2);
+  out = put_uint(out, (unsigned short)parser->keep_alive, 2);
+  out = put_uint(out, parser->flags, 2);
+  out = put_uint(out, parser->http_errno, 1);
+  out = put_uint(out, parser->error_offset, 8);
+  out = put_uint(out, parser->stream_offset, 8);
+  out = put_uint(out, parser->framing_offset, 8);
+
+  out = put_uint(out, parser->method_size, 1);
+  memcpy(out, parser->method_token.buf, parser->method_size);
+  out += parser->method_size;
+
+#define SNAPSHOT_MARK_BIT(FOR)                                       \
+  marks = (marks << 1) | (parser->FOR##_mark != NULL);
+  SNAPSHOT_MARKS(SNAPSHOT_MARK_BIT)
+#undef SNAPSHOT_MARK_BIT
+  out = put_uint(out, marks, 2);
+#define SNAPSHOT_MARK_SIZE(FOR)                                      \
+  out = put_uint(out, parser->FOR##_size, 8);
+  SNAPSHOT_MARKS(SNAPSHOT_MARK_SIZE)
+#undef SNAPSHOT_MARK_SIZE
+
+  /* a field name being gathered for the header filter */
+  name_size = parser->header_filter ?
+    MIN(parser->header_field_size, HTTP_MAX_HEADER_NAME_SIZE) : 0;
+  out = put_uint(out, name_size, 1);
+  memcpy(out, parser->header_name, name_size);
+  out += name_size;
+
+  out = put_uint(out, parser->path_decoder.len, 8);
+  out = put_uint(out, parser->path_decoder.state, 1);
+  out = put_uint(out, parser->path_decoder.hi, 1);
+  out = put_uint(out, parser->query_string_decoder.len, 8);
+  out = put_uint(out, parser->query_string_decoder.state, 1);
+  out = put_uint(out, parser->query_string_decoder.hi, 1);
+
+  assert(out - buf <= HTTP_PARSER_SNAPSHOT_SIZE);
+  return out - buf;
+}
+
+int
+http_parser_restore (http_parser *parser, const char *buf, size_t len)
+{
+  const char *in = buf;
+  const char *end = buf + len;
+  http_parser restored;
+  uint64_t v;
+  unsigned int marks;
+  const char *name;
+  size_t name_size;
+
+  if (len < SNAPSHOT_FIXED_SIZE) return -1;
+  in = get_uint(in, &v, 1); if (v != SNAPSHOT_VERSION) return -1;
+  in = get_uint(in, &v, 4); if (v != machine_fingerprint()) return -1;
+  in = get_uint(in, &v, 1); if (v != (uint64_t)parser->type) return -1;
+
+  /* nothing of parser changes unless all of it is restored, what it
+   * shares is reset at the end */
+  restored = *parser;
+  restored.arena = NULL;
+  restored.headers = NULL;
+  restored.route = NULL;
+  RESET_PARSER((&restored));
+
+  in = get_uint(in, &v, 4);
+  if (v >= SNAPSHOT_STATES) return -1;
+  restored.cs = (int)v;
+  in = get_uint(in, &v, 1);
+  if (v & ~(uint64_t)between_calls_flags()) return -1;
+  restored._flags = (unsigned char)v;
+  in = get_uint(in, &v, 8); restored.chunk_size = v;
+  in = get_uint(in, &v, 8); restored.body_read = v;
+  in = get_uint(in, &v, 8); restored.content_length = v;
+  in = get_uint(in, &v, 2); restored.status_code = v;
+  in = get_uint(in, &v, 2);
+  if (v > HTTP_EXTENSION_METHOD) return -1;
+  restored.method = v;
+  in = get_uint(in, &v, 2); restored.port = v;
+  in = get_uint(in, &v, 2);
+  if (v != HTTP_IDENTITY && v != HTTP_CHUNKED) return -1;
+  restored.transfer_encoding = (short)v;
+  in = get_uint(in, &v, 2); restored.version_major = v;
+  in = get_uint(in, &v, 2); restored.version_minor = v;
+  in = get_uint(in, &v, 2); restored.keep_alive = (short)v;
+  in = get_uint(in, &v, 2); restored.flags = v;
+  in = get_uint(in, &v, 1);
+  if (v > HPE_UNKNOWN) return -1;
+  restored.http_errno = (enum http_errno)v;
+  in = get_uint(in, &v, 8); restored.error_offset = v;
+  in = get_uint(in, &v, 8); restored.stream_offset = v;
+  in = get_uint(in, &v, 8); restored.framing_offset = v;
+
+  in = get_uint(in, &v, 1);
+  assert(in - buf == SNAPSHOT_FIXED_SIZE);
+  if (v > HTTP_MAX_METHOD_SIZE || end - in < (long)v + 2 + 9 * 8 + 1) return -1;
+  restored.method_size = v;
+  memcpy(restored.method_token.buf, in, restored.method_size);
+  in += restored.method_size;
+
+  in = get_uint(in, &v, 2);
+  if (v >> 9) return -1;
+  marks = v;
+  /* sizes past MAX_FIELD_SIZE would have failed the parse */
+#define RESTORE_MARK(FOR)                                            \
+  in = get_uint(in, &v, 8);                                          \
+  if (v > MAX_FIELD_SIZE) return -1;                                 \
+  restored.FOR##_size = v;                                           \
+  restored.FOR##_mark = NULL;
+  SNAPSHOT_MARKS(RESTORE_MARK)
+#undef RESTORE_MARK
+  /* the first mark is the highest bit */
+#define RESTORE_MARK_BIT(FOR)                                        \
+  if (marks & (1u << --n)) restored.FOR##_mark = &restored_mark;
+  {
+    int n = 9;
+    SNAPSHOT_MARKS(RESTORE_MARK_BIT)
+  }
+#undef RESTORE_MARK_BIT
+
+  in = get_uint(in, &v, 1);
+  name_size = v;
+  if (name_size > MIN(restored.header_field_size, HTTP_MAX_HEADER_NAME_SIZE) ||
+      end - in < (long)name_size + 20) {
+    return -1;
+  }
+  name = in;
+  in += name_size;
+
+  in = get_uint(in, &v, 8); restored.path_decoder.len = v;
+  in = get_uint(in, &v, 1); restored.path_decoder.state = v;
+  in = get_uint(in, &v, 1); restored.path_decoder.hi = v;
+  in = get_uint(in, &v, 8); restored.query_string_decoder.len = v;
+  in = get_uint(in, &v, 1); restored.query_string_decoder.state = v;
+  in = get_uint(in, &v, 1); restored.query_string_decoder.hi = v;
+  if (restored.path_decoder.len > restored.path_decoder.size ||
+      restored.query_string_decoder.len > restored.query_string_decoder.size ||
+      restored.path_decoder.state > 2 || restored.query_string_decoder.state > 2) {
+    return -1;
+  }
+
+  RESET_PARSER(parser);
+  restored.arena = parser->arena;
+  restored.headers = parser->headers;
+  restored.route = parser->route;
+  if (restored.header_name) memcpy(restored.header_name, name, name_size);
+  *parser = restored;
+  return 0;
+}
+
 int
 http_parser_has_error (http_parser *parser) 
 {
@@ -489,9 +1664,44 @@ http_parser_has_error (http_parser *parser)
   return parser->cs == http_parser_error;
 }
 
+#define HTTP_ERRNO_NAME_GEN(n, s) "HPE_" #n,
+static const char *http_errno_names[] = { HTTP_ERRNO_MAP(HTTP_ERRNO_NAME_GEN) };
+#undef HTTP_ERRNO_NAME_GEN
+
+#define HTTP_ERRNO_DESCRIPTION_GEN(n, s) s,
+static const char *http_errno_descriptions[] = { HTTP_ERRNO_MAP(HTTP_ERRNO_DESCRIPTION_GEN) };
+#undef HTTP_ERRNO_DESCRIPTION_GEN
+
+const char *
+http_errno_name (enum http_errno err)
+{
+  if ((unsigned)err > HPE_UNKNOWN) err = HPE_UNKNOWN;
+  return http_errno_names[err];
+}
+
+const char *
+http_errno_description (enum http_errno err)
+{
+  if ((unsigned)err > HPE_UNKNOWN) err = HPE_UNKNOWN;
+  return http_errno_descriptions[err];
+}
+
+#define HTTP_METHOD_STR_GEN(n, s) s,
+static const char *http_method_strs[] = { NULL, HTTP_METHOD_MAP(HTTP_METHOD_STR_GEN) NULL };
+#undef HTTP_METHOD_STR_GEN
+
+const char *
+http_method_str (enum http_method method)
+{
+  if ((unsigned)method > HTTP_EXTENSION_METHOD) return NULL;
+  return http_method_strs[method];
+}
+
 int
 http_parser_should_keep_alive (http_parser *parser)
 {
+  if (parser->flags & HTTP_FLAG_READ_UNTIL_EOF)
+    return FALSE;
   if (parser->keep_alive == -1)
     if (parser->version_major == 1)
       return (parser->version_minor != 0);
@@ -0,0 +1,190 @@
+/* Parsers for many connections in one table, see http_parser_table.h */
+#include "http_parser_table.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* A slot's state is the http_parser fields before data, the rest is the
+ * settings. The table's fields are taken from its arrays, the slot's copy
+ * of them in cold is not used. */
+#define COLD(table, slot) ((table)->cold + (slot) * (table)->cold_size)
+
+static void
+load_hot (http_parser_table *table, size_t slot)
+{
+  http_parser *parser = &table->parser;
+
+  parser->cs = table->cs[slot];
+  parser->flags = table->flags[slot];
+  parser->_flags = table->bits[slot];
+  parser->chunk_size = table->chunk_size[slot];
+  parser->content_length = table->content_length[slot];
+  parser->body_read = table->body_read[slot];
+  parser->stream_offset = table->stream_offset[slot];
+  parser->data = table->data[slot];
+}
+
+/* the slot into the table's parser, with the settings */
+static void
+load_slot (http_parser_table *table, size_t slot)
+{
+  http_parser *parser = &table->parser;
+
+  memcpy(parser, COLD(table, slot), table->cold_size);
+  memcpy((char *)parser + table->cold_size,
+         (const char *)&table->settings + table->cold_size,
+         sizeof(http_parser) - table->cold_size);
+  parser->router = NULL;
+  parser->route = NULL;
+  parser->header_filter = NULL;
+  parser->header_name = NULL;
+  parser->reassemble_tokens = 0;
+  parser->arena = NULL;
+  parser->headers = NULL;
+  load_hot(table, slot);
+}
+
+static void
+store_slot (http_parser_table *table, size_t slot)
+{
+  const http_parser *parser = &table->parser;
+
+  table->cs[slot] = parser->cs;
+  table->flags[slot] = parser->flags;
+  table->bits[slot] = parser->_flags;
+  table->chunk_size[slot] = parser->chunk_size;
+  table->content_length[slot] = parser->content_length;
+  table->body_read[slot] = parser->body_read;
+  table->stream_offset[slot] = parser->stream_offset;
+  memcpy(COLD(table, slot), parser, table->cold_size);
+}
+
+http_parser_table *
+http_parser_table_new (size_t size, enum http_parser_type type)
+{
+  http_parser_table *table = calloc(1, sizeof(http_parser_table));
+  size_t slot;
+
+  if (table == NULL) return NULL;
+  table->size = size;
+  table->type = type;
+  table->cold_size = offsetof(http_parser, data);
+  table->cs = calloc(size, sizeof(int));
+  table->flags = calloc(size, sizeof(unsigned short));
+  table->bits = calloc(size, sizeof(unsigned char));
+  table->chunk_size = calloc(size, sizeof(size_t));
+  table->content_length = calloc(size, sizeof(size_t));
+  table->body_read = calloc(size, sizeof(size_t));
+  table->stream_offset = calloc(size, sizeof(uint64_t));
+  table->data = calloc(size, sizeof(void *));
+  table->cold = calloc(size, table->cold_size);
+
+  if (!table->cs || !table->flags || !table->bits || !table->chunk_size ||
+      !table->content_length || !table->body_read || !table->stream_offset ||
+      !table->data || !table->cold) {
+    http_parser_table_free(table);
+    return NULL;
+  }
+
+  http_parser_init(&table->settings, type);
+
+  /* where the compiler put the eating and error bits */
+  table->parser._flags = 0;
+  table->parser.eating = 1;
+  table->eating_bit = table->parser._flags;
+  table->parser._flags = 0;
+  table->parser.error = 1;
+  table->error_bit = table->parser._flags;
+
+  for (slot = 0; slot < size; slot++) http_parser_table_open(table, slot);
+  return table;
+}
+
+void
+http_parser_table_free (http_parser_table *table)
+{
+  if (table == NULL) return;
+  free(table->cs);
+  free(table->flags);
+  free(table->bits);
+  free(table->chunk_size);
+  free(table->content_length);
+  free(table->body_read);
+  free(table->stream_offset);
+  free(table->data);
+  free(table->cold);
+  free(table);
+}
+
+void
+http_parser_table_open (http_parser_table *table, size_t slot)
+{
+  http_parser_init(&table->parser, table->type);
+  table->data[slot] = NULL;
+  store_slot(table, slot);
+}
+
+size_t
+http_parser_table_execute (http_parser_table *table, size_t slot,
+                           const char *data, size_t len)
+{
+  const http_parser *settings = &table->settings;
+  size_t parsed;
+
+  /* More of a body that does not finish it, counted in the table alone.
+   * Reaching the end of a chunk or message is left to the parser. */
+  if (len > 0 && !(table->bits[slot] & table->error_bit) &&
+      !(table->flags[slot] & HTTP_FLAG_UPGRADE) &&
+      ((table->flags[slot] & HTTP_FLAG_READ_UNTIL_EOF) ||
+       ((table->bits[slot] & table->eating_bit) && len < table->chunk_size[slot]))) {
+    int rc = 0;
+
+    if (settings->on_body_range) {
+      load_hot(table, slot);
+      rc = settings->on_body_range(&table->parser, table->stream_offset[slot], len);
+    } else if (settings->on_body) {
+      load_hot(table, slot);
+      rc = settings->on_body(&table->parser, data, len);
+    }
+    if (rc != 0) {
+      load_slot(table, slot);
+      table->parser.error = 1;
+      table->parser.http_errno = HPE_CALLBACK_ABORT;
+      table->parser.error_offset = 0;
+      store_slot(table, slot);
+      return 0;
+    }
+    if (!(table->flags[slot] & HTTP_FLAG_READ_UNTIL_EOF)) {
+      table->chunk_size[slot] -= len;
+    }
+    table->body_read[slot] += len;
+    table->stream_offset[slot] += len;
+    return len;
+  }
+
+  load_slot(table, slot);
+  parsed = http_parser_execute(&table->parser, data, len);
+  store_slot(table, slot);
+  return parsed;
+}
+
+int
+http_parser_table_finish (http_parser_table *table, size_t slot)
+{
+  int rc;
+
+  load_slot(table, slot);
+  rc = http_parser_finish(&table->parser);
+  store_slot(table, slot);
+  return rc;
+}
+
+int
+http_parser_table_has_error (const http_parser_table *table, size_t slot)
+{
+  http_parser probe;
+
+  probe.cs = table->cs[slot];
+  probe._flags = table->bits[slot];
+  return http_parser_has_error(&probe);
+}
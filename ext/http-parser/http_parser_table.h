@@ -0,0 +1,77 @@
+/* Parsers for many connections in one table.
+ *
+ * A server with a great many connections can keep their parsers in an
+ * http_parser_table instead of allocating one http_parser per connection.
+ * Connections are identified by slot, 0 to size - 1. The callbacks and
+ * options are set once for the whole table, in its settings. The state
+ * that is looked at on every read, the machine state, flags and body
+ * counters, is kept in dense arrays indexed by slot, so servicing a batch
+ * of connections touches a few cache lines of it rather than a whole
+ * parser each. Reads that are only more of a body in progress are handled
+ * from those arrays alone. Everything else copies the rest of the slot's
+ * state into the table's own parser, runs it there and copies it back.
+ */
+#ifndef http_parser_table_h
+#define http_parser_table_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "http_parser.h"
+
+typedef struct http_parser_table http_parser_table;
+
+struct http_parser_table {
+  /** READ-ONLY **/
+  size_t size;
+  enum http_parser_type type;
+
+  /* hot state, indexed by slot, see the http_parser fields of the same
+   * names. bits holds the eating/error bits. */
+  int            *cs;
+  unsigned short *flags;
+  unsigned char  *bits;
+  size_t         *chunk_size;
+  size_t         *content_length;
+  size_t         *body_read;
+  uint64_t       *stream_offset;
+
+  /** PUBLIC **/
+  void **data; /* indexed by slot, the callbacks get it as parser->data */
+
+  /* The callbacks and headers_only of every slot. The rest of it is not
+   * used: a table has no router, header_filter, arena or headers, so no
+   * reassemble_tokens either. */
+  http_parser settings;
+
+  /** PRIVATE **/
+  http_parser    parser;     /* where a slot is run */
+  unsigned char *cold;       /* the rest of each slot's state */
+  size_t         cold_size;  /* per slot */
+  unsigned char  eating_bit; /* of bits */
+  unsigned char  error_bit;
+};
+
+/* Returns NULL if memory ran out. All slots start out as a new connection.
+ */
+http_parser_table *http_parser_table_new (size_t size, enum http_parser_type type);
+void http_parser_table_free (http_parser_table *table);
+
+/* Start a new connection in slot. Its data is set to NULL. */
+void http_parser_table_open (http_parser_table *table, size_t slot);
+
+/* http_parser_execute(), http_parser_finish() and http_parser_has_error()
+ * for slot. The callbacks are given the table's parser with the slot
+ * loaded into it. For a read that is only more of a body, on_body and
+ * on_body_range, only the table's fields of the slot and its data are
+ * loaded, the rest of the parser is not the slot's.
+ */
+size_t http_parser_table_execute (http_parser_table *table, size_t slot,
+                                  const char *data, size_t len);
+int http_parser_table_finish (http_parser_table *table, size_t slot);
+int http_parser_table_has_error (const http_parser_table *table, size_t slot);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
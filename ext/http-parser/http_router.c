@@ -0,0 +1,200 @@
+/* Request path routing for http_parser, see http_router.h */
+#include "http_router.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct http_route_node {
+  char *segment;                 /* literal segment, NULL for a parameter */
+  size_t length;
+  char *param_name;              /* set on parameter nodes */
+  int route_id;
+  http_route_node *children;     /* literal children */
+  http_route_node *next;         /* next literal sibling */
+  http_route_node *param;        /* the parameter child */
+};
+
+struct http_router {
+  http_route_node root;
+};
+
+static http_route_node *
+node_new (const char *segment, size_t length)
+{
+  http_route_node *node = calloc(1, sizeof(http_route_node));
+
+  if (node == NULL) return NULL;
+  node->route_id = HTTP_NO_ROUTE;
+  if (segment) {
+    node->segment = malloc(length + 1);
+    if (node->segment == NULL) {
+      free(node);
+      return NULL;
+    }
+    memcpy(node->segment, segment, length);
+    node->segment[length] = '\0';
+    node->length = length;
+  }
+  return node;
+}
+
+static void
+node_free_children (http_route_node *node)
+{
+  http_route_node *child, *next;
+
+  for (child = node->children; child; child = next) {
+    next = child->next;
+    node_free_children(child);
+    free(child->segment);
+    free(child);
+  }
+  if (node->param) {
+    node_free_children(node->param);
+    free(node->param->param_name);
+    free(node->param);
+  }
+}
+
+static const http_route_node *
+node_child (const http_route_node *node, const char *segment, size_t length)
+{
+  const http_route_node *child;
+
+  for (child = node->children; child; child = child->next) {
+    if (child->length == length && memcmp(child->segment, segment, length) == 0)
+      return child;
+  }
+  return NULL;
+}
+
+http_router *
+http_router_new (void)
+{
+  http_router *router = calloc(1, sizeof(http_router));
+
+  if (router) router->root.route_id = HTTP_NO_ROUTE;
+  return router;
+}
+
+void
+http_router_free (http_router *router)
+{
+  if (router == NULL) return;
+  node_free_children(&router->root);
+  free(router);
+}
+
+int
+http_router_add (http_router *router, const char *pattern, int route_id)
+{
+  http_route_node *node = &router->root;
+  http_route_node *child;
+  const char *end;
+  size_t length;
+  int nparams = 0;
+
+  if (*pattern != '/') return -1;
+
+  while (*pattern) {
+    while (*pattern == '/') pattern++;
+    if (*pattern == '\0') break;
+    for (end = pattern; *end && *end != '/'; end++) ;
+    length = end - pattern;
+
+    if (*pattern == ':') {
+      if (++nparams > HTTP_ROUTE_MAX_PARAMS) return -1;
+      if (node->param == NULL) {
+        if ((child = node_new(NULL, 0)) == NULL) return -1;
+        if ((child->param_name = malloc(length)) == NULL) {
+          free(child);
+          return -1;
+        }
+        memcpy(child->param_name, pattern + 1, length - 1);
+        child->param_name[length - 1] = '\0';
+        node->param = child;
+      } else if (strlen(node->param->param_name) != length - 1 ||
+                 memcmp(node->param->param_name, pattern + 1, length - 1) != 0) {
+        return -1;
+      }
+      node = node->param;
+    } else {
+      child = (http_route_node *)node_child(node, pattern, length);
+      if (child == NULL) {
+        if ((child = node_new(pattern, length)) == NULL) return -1;
+        child->next = node->children;
+        node->children = child;
+      }
+      node = child;
+    }
+    pattern = end;
+  }
+
+  node->route_id = route_id;
+  return 0;
+}
+
+void
+http_route_start (http_route_match *match, const http_router *router)
+{
+  match->route_id = HTTP_NO_ROUTE;
+  match->nparams = 0;
+  match->node = &router->root;
+  match->used = 0;
+  match->segment = 0;
+}
+
+/* the segment in buf[segment .. used) is complete, step to its node */
+static void
+route_segment (http_route_match *match)
+{
+  const http_route_node *child;
+  size_t length = match->used - match->segment;
+
+  if (length == 0) return;
+
+  child = node_child(match->node, match->buf + match->segment, length);
+  if (child) {
+    /* literal segments are not kept */
+    match->used = match->segment;
+  } else if (match->node->param && match->nparams < HTTP_ROUTE_MAX_PARAMS) {
+    child = match->node->param;
+    match->params[match->nparams].name = child->param_name;
+    match->params[match->nparams].offset = match->segment;
+    match->params[match->nparams].length = length;
+    match->nparams++;
+    match->segment = match->used;
+  }
+  match->node = child;
+}
+
+void
+http_route_feed (http_route_match *match, const char *at, size_t length)
+{
+  const char *end = at + length;
+  const char *slash;
+  size_t n;
+
+  while (at < end && match->node) {
+    slash = memchr(at, '/', end - at);
+    n = (slash ? slash : end) - at;
+
+    if (n > (size_t)(HTTP_ROUTE_BUFFER_SIZE - match->used)) {
+      match->node = NULL;
+      return;
+    }
+    memcpy(match->buf + match->used, at, n);
+    match->used += n;
+
+    if (slash == NULL) return;
+    route_segment(match);
+    at = slash + 1;
+  }
+}
+
+void
+http_route_finish (http_route_match *match)
+{
+  if (match->node) route_segment(match);
+  match->route_id = match->node ? match->node->route_id : HTTP_NO_ROUTE;
+  match->node = NULL;
+}
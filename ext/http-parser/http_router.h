@@ -0,0 +1,75 @@
+/* Request path routing for http_parser.
+ *
+ * A router is a trie of path segments built once with http_router_add().
+ * Attached to a parser, see parser->router, the request path is matched
+ * as it is parsed, a segment at a time, so the route is known when the
+ * path ends, before any of the headers have been read.
+ *
+ * Matching is on the raw path, percent escapes are not decoded.
+ */
+#ifndef http_router_h
+#define http_router_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+
+/* parameters captured per request, and the bytes for their values and the
+ * segment being matched
+ */
+#define HTTP_ROUTE_MAX_PARAMS  8
+#define HTTP_ROUTE_BUFFER_SIZE 256
+
+/* route_id of a path that did not match a route */
+#define HTTP_NO_ROUTE -1
+
+typedef struct http_router http_router;
+typedef struct http_route_node http_route_node;
+typedef struct http_route_match http_route_match;
+
+struct http_route_match {
+  /** READ-ONLY **/
+  int route_id;           /* HTTP_NO_ROUTE until the path has matched */
+  unsigned char nparams;
+  struct {
+    const char *name;     /* owned by the router, NUL terminated */
+    unsigned short offset; /* of the value in buf */
+    unsigned short length;
+  } params[HTTP_ROUTE_MAX_PARAMS];
+  char buf[HTTP_ROUTE_BUFFER_SIZE];
+
+  /** PRIVATE **/
+  const http_route_node *node; /* NULL once the path cannot match */
+  unsigned short used;         /* bytes of buf in use */
+  unsigned short segment;      /* offset of the current segment in buf */
+};
+
+http_router *http_router_new (void);
+void http_router_free (http_router *router);
+
+/* Adds a route. Segments of the pattern starting with ':' match any one
+ * segment of a path and capture it, "/users/:id/posts" matches
+ * "/users/42/posts" with the parameter "id" = "42". A literal segment is
+ * preferred over a parameter and there is no backtracking, "/users/new"
+ * wins over "/users/:id" for "/users/new" and "/users/new/posts" matches
+ * neither. Empty segments, "//" and a trailing "/", are ignored. Adding a
+ * pattern again replaces its route_id.
+ *
+ * Returns 0, or -1 if memory ran out, the pattern does not start with "/",
+ * has more than HTTP_ROUTE_MAX_PARAMS parameters or names a parameter
+ * differently than an earlier pattern did at the same position.
+ */
+int http_router_add (http_router *router, const char *pattern, int route_id);
+
+/* Matching, used by the parser. Feed the path in as many pieces as it
+ * comes in, http_route_finish() sets match->route_id.
+ */
+void http_route_start (http_route_match *match, const http_router *router);
+void http_route_feed (http_route_match *match, const char *at, size_t length);
+void http_route_finish (http_route_match *match);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
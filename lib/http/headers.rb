@@ -11,6 +11,10 @@ module Http
   #
   # All keys are strings, and all values are Strings or Array's of strings.
   #
+  # For reading the headers of a parsed message see Parser#headers, which
+  # gives an Http::ParsedHeaders with the same reading methods that only
+  # makes Strings of the headers that are read.
+  #
   class Headers
     class << Headers
       # From Thin
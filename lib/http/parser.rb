@@ -13,11 +13,15 @@ require 'http/parser_callbacks'
 
 module Http
   #
-  # The list of methods defined in the extension
+  # The list of methods known to the extension.  Any other method token is
+  # still parsed, see RequestParserCallbacks#on_extension_method
   #
   def Http::Methods
-    @methods ||= [ COPY, DELETE, GET, HEAD, LOCK, MKCOL, MOVE, OPTIONS, 
-                   POST, PROPFIND, PROPPATCH, PUT, TRACE, UNLOCK ].freeze
+    @methods ||= [ GET, POST, PUT, HEAD, DELETE, PATCH, OPTIONS, CONNECT,
+                   TRACE, COPY, LOCK, MKCOL, MOVE, PROPFIND, PROPPATCH,
+                   SEARCH, UNLOCK, BIND, REBIND, UNBIND, ACL, REPORT,
+                   MKACTIVITY, CHECKOUT, MERGE, MSEARCH, NOTIFY, SUBSCRIBE,
+                   UNSUBSCRIBE, PURGE, MKCALENDAR, LINK, UNLINK ].freeze
   end
   #
   # see ext/http-parser/http-parser_ext.c
@@ -26,7 +30,18 @@ module Http
   # RequestParser or a ResponseParser
   #
   class Parser
-    class Error < StandardError; end
+    #
+    # Raised from +parse_chunk+ when parsing fails and there is no +on_error+
+    # callback.
+    #
+    class Error < StandardError
+      # the reason for the failure as a Symbol, e.g. :invalid_method,
+      # :header_overflow or :callback_abort.  See Parser#error_code
+      attr_reader :code
+
+      # the offset of the failing byte within the chunk being parsed
+      attr_reader :offset
+    end
 
     class << Parser
       #
@@ -68,8 +83,13 @@ module Http
       @on_header_field_callback     = nil
       @on_header_value_callback     = nil
       @on_headers_complete_callback = nil
+      @on_chunk_extension_callback  = nil
+      @on_chunk_header_callback     = nil
+      @on_chunk_complete_callback   = nil
       @on_body_callback             = nil
       @on_message_complete_callback = nil
+      @on_body_range_callback       = nil
+      @on_framing_range_callback    = nil
       @on_error_callback            = nil
 
       @callback_exception           = nil
@@ -98,17 +118,20 @@ module Http
     #
     # In the case of a readable object , the 2nd parameter can be used to set a
     # how many bytes of data to +read+ at once.  +parse+ will conintually call
-    # +read+ until +read+ returns nil, and at that ponit parse will return.
+    # +read+ until +read+ returns nil, and at that ponit it calls +finish+ and
+    # returns.
     #
     # In the case of anything else, +to_s+ will be invoked upon the object and
-    # the result will be parsed.
+    # the result will be parsed.  Call +finish+ yourself when there is no more
+    # input.
     #
     def parse( read_or_string, chunk_size = self.buffer_size )
       if read_or_string.respond_to?( :read ) then
         buffer = String.new
         while read_or_string.read( chunk_size, buffer ) do
-          parse_chunk( buffer )
+          parse_chunk!( buffer )
         end
+        finish
       else
         parse_chunk( read_or_string.to_s )
       end
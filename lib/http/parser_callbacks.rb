@@ -7,14 +7,20 @@ module Http
   # parsing.  The RequestParser has a few more callbacks and those are
   # documented in RequestParserCallbacks.
   #
-  # There are 7 callbacks.  In the normal course of things, you should only see
-  # 6 of them.
+  # There are 12 callbacks.  In the normal course of things, you should only
+  # see 6 of them, the chunk callbacks are only invoked for chunked bodies and
+  # the range callbacks replace on_body for forwarding bodies untouched.
   #
   # * on_message_begin( parser )
   # * on_header_field( parser, field )
   # * on_header_value( parser, value )
   # * on_headers_complete( parser )
+  # * on_chunk_extension( parser, extension )
+  # * on_chunk_header( parser )
   # * on_body( parser, data )
+  # * on_body_range( parser, offset, length )
+  # * on_framing_range( parser, offset, length )
+  # * on_chunk_complete( parser )
   # * on_message_complete( parser )
   #
   # The callbacks come in 2 forms, data callbacks and notification callbacks.
@@ -29,7 +35,9 @@ module Http
   # - a single call to on_message_begin
   # - multiple calls to on_header_field and on_header_value 
   # - a single call to on_headers_complete
-  # - multiple calls to on_body
+  # - multiple calls to on_body, each chunk of a chunked body is bracketed by
+  #   on_chunk_header and on_chunk_complete
+  # - multiple calls to on_header_field and on_header_value for trailers
   # - a single call to on_message_complete
   #
   #
@@ -75,6 +83,10 @@ module Http
     # invoke this callback as +callback(parser,'Ho')+ and as soon as more data
     # arrives it will probably make another callback of +callback(parser,'st')+ 
     #
+    # The trailing headers of a chunked body are delivered through this callback
+    # too, after the last +on_body+.  While they are being delivered
+    # +parser.trailer?+ is true.
+    #
     def on_header_field( &block )     self.on_header_field = block     ; end
 
     # 
@@ -106,6 +118,43 @@ module Http
     #
     def on_headers_complete( &block ) self.on_headers_complete= block  ; end
 
+    #
+    # call-seq:
+    #   parser.on_chunk_extension { |parser, extension_data| ... }
+    #   parser.on_chunk_extension = lambda { |parser, extension_data| ... }
+    #
+    # register the callback for the on_chunk_extension callback.  This callback
+    # is passed the raw chunk extension, everything between the chunk size and
+    # the CRLF, e.g. ';name=value'.  It may be called multiple times for the
+    # same chunk and is always called before +on_chunk_header+ for that chunk.
+    #
+    def on_chunk_extension( &block )  self.on_chunk_extension = block  ; end
+
+    #
+    # call-seq:
+    #   parser.on_chunk_header { |parser| ... }
+    #   parser.on_chunk_header = lambda { |parser| ... }
+    #
+    # register the callback for the on_chunk_header callback.  This is a
+    # notification callback called once at the start of each chunk of a
+    # chunked body, before any +on_body+ for the chunk.  +parser.chunk_size+ is
+    # the size of the chunk, it is 0 for the last chunk.
+    #
+    # Together with +on_chunk_complete+ this lets a proxy re-emit the chunks
+    # with their original framing.
+    #
+    def on_chunk_header( &block )     self.on_chunk_header = block     ; end
+
+    #
+    # call-seq:
+    #   parser.on_chunk_complete { |parser| ... }
+    #   parser.on_chunk_complete = lambda { |parser| ... }
+    #
+    # register the callback for the on_chunk_complete callback.  This is a
+    # notification callback called once at the end of each chunk.
+    #
+    def on_chunk_complete( &block )   self.on_chunk_complete = block   ; end
+
     # 
     # call-seq:
     #   parser.on_body { |parser, body_data| ... }
@@ -120,6 +169,31 @@ module Http
     #
     def on_body( &block )             self.on_body = block             ; end
 
+    #
+    # call-seq:
+    #   parser.on_body_range { |parser, offset, length| ... }
+    #   parser.on_body_range = lambda { |parser, offset, length| ... }
+    #
+    # register the callback for the on_body_range callback.  When it is set
+    # it is called instead of +on_body+, with where the body bytes are in
+    # the input rather than the bytes.  +offset+ counts from the first byte
+    # given to the parser, see +stream_offset+.  A proxy can use it to copy
+    # the body straight from one IO to another.
+    #
+    def on_body_range( &block )       self.on_body_range = block       ; end
+
+    #
+    # call-seq:
+    #   parser.on_framing_range { |parser, offset, length| ... }
+    #   parser.on_framing_range = lambda { |parser, offset, length| ... }
+    #
+    # register the callback for the on_framing_range callback.  It is given
+    # the parts of a chunked body that are not +on_body_range+ payload, the
+    # chunk size lines, the CRLF after each chunk and the last chunk with
+    # its trailers, in the same way.
+    #
+    def on_framing_range( &block )    self.on_framing_range = block    ; end
+
     #
     # call-seq:
     #   parser.on_message_complete { |parser| ... }
@@ -162,8 +236,10 @@ module Http
     #
     def callback_methods
       @callback_methods ||= %w[ on_message_begin on_header_field on_header_value
-                                on_headers_complete on_body on_message_complete
-                                on_error ]
+                                on_headers_complete on_chunk_extension
+                                on_chunk_header on_body on_chunk_complete
+                                on_body_range on_framing_range
+                                on_message_complete on_error ]
     end
     #
     # call-seq:
@@ -11,19 +11,56 @@ module Http
   # ParserCallbacks plus the following additional callbacks based around the
   # request URI.
   #
+  # * on_extension_method
+  # * on_scheme
+  # * on_host
   # * on_path
+  # * on_route
   # * on_query_string
   # * on_uri
   # * on_fragment
   #
-  # All of them are data callbacks and so receive to parameters, first the
-  # parser instance itself and then the data.
+  # All of them except +on_route+ are data callbacks and so receive to
+  # parameters, first the parser instance itself and then the data.
   #
   # These callbacks will be invoked between the +on_message_begin+ and 
   # +on_header_field+ callbacks.
   #
   module RequestParserCallbacks
     include ParserCallbacks
+    #
+    # call-seq:
+    #   parser.on_extension_method { |parser, method| ... }
+    #   parser.on_extension_method = lambda {|parser, method| ... }
+    #
+    # Called when the request method is not one of Http.Methods.  Unlike the
+    # other data callbacks it is called exactly once, with the whole method
+    # token.  Raise an exception in the callback to reject the request.
+    #
+    def on_extension_method( &block ) self.on_extension_method = block ; end
+
+    #
+    # call-seq:
+    #   parser.on_scheme { |parser, scheme_data| ... }
+    #   parser.on_scheme = lambda {|parser, scheme_data| ... }
+    #
+    # Called with the scheme of an absolute-form Request-URI, the 'http' of
+    # 'GET http://example.com/ HTTP/1.1', as sent to a proxy.
+    #
+    def on_scheme( &block )        self.on_scheme = block       ; end
+
+    #
+    # call-seq:
+    #   parser.on_host { |parser, host_data| ... }
+    #   parser.on_host = lambda {|parser, host_data| ... }
+    #
+    # Called with the host of an absolute-form Request-URI, or of the
+    # host:port target of a CONNECT.  An IPv6 literal is given without its
+    # surrounding brackets.  The port, if there was one, is available from
+    # RequestParser#port until the request is complete.
+    #
+    def on_host( &block )          self.on_host = block         ; end
+
     #
     # call-seq:
     #   parser.on_path { |parser, path_data| ... }
@@ -35,6 +72,18 @@ module Http
     #
     def on_path( &block )          self.on_path = block         ; end
 
+    #
+    # call-seq:
+    #   parser.on_route { |parser| ... }
+    #   parser.on_route = lambda {|parser| ... }
+    #
+    # Called once the path has been matched against the Http::Router set
+    # with RequestParser#router=, before any of the headers are parsed.
+    # RequestParser#route is nil if the path did not match, raise an
+    # exception in the callback to stop parsing the request there.
+    #
+    def on_route( &block )         self.on_route = block        ; end
+
     #
     # call-seq:
     #   parser.on_query_string {|parser, query_string_data| ... }
@@ -77,8 +126,8 @@ module Http
     #
     def callback_methods
       @callback_methods ||= ParserCallbacks.callback_methods + 
-                            %w[ on_path on_query_string
-                                on_uri on_fragment ]
+                            %w[ on_extension_method on_scheme on_host on_path
+                                on_route on_query_string on_uri on_fragment ]
     end
     module_function :callback_methods
  
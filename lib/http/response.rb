@@ -18,6 +18,9 @@ module Http
     # Headers hash-like object
     attr_reader   :headers
 
+    # Headers hash-like object of the trailing headers of a chunked response
+    attr_reader   :trailers
+
     # The HTTP Protocol version of this response
     attr_accessor :protocol_version
 
@@ -44,6 +47,7 @@ module Http
       # these will have good values after on_message_complete 
       @content_length = nil
       @body = nil
+      @trailers = nil
 
       # internal state items used during parsing
       @header_state = nil
@@ -98,6 +102,7 @@ module Http
     # value.
     #
     def on_header_field( parser, data )
+      start_trailers if @header_state.nil? and parser.trailer?
       case @header_state
       when :field
         append_header_token( data )
@@ -154,9 +159,11 @@ module Http
     end
 
     #
-    # When the message is done, be nice and unbind from the parser
+    # When the message is done, collect any trailers and be nice and unbind
+    # from the parser
     #
     def on_message_complete( parser )
+      finish_trailers
       parser.unbind_callbacks
     end
 
@@ -193,6 +200,26 @@ module Http
       @header_token.write( data )
     end
 
+    # trailers come after the body, so restart the header accumulation for them
+    def start_trailers
+      @header_fields_values = []
+      @header_state         = :field
+      @header_token         = StringIO.new
+    end
+
+    # turn whatever trailers were accumulated into a Headers
+    def finish_trailers
+      if @header_state then
+        rotate_header_token
+        @trailers = Headers[ *@header_fields_values ]
+        @header_state = nil
+        @header_fields_values = nil
+        @header_token = nil
+      else
+        @trailers = Headers.new
+      end
+    end
+
     # dump the current header toke into the fields values and start a new one
     # with the given data
     def rotate_header_token( data = nil )
@@ -5,7 +5,7 @@ require 'http/parser'
 describe Http::Parser do
 
   it "has a list of HTTP Methods" do
-    Http.Methods.size.should == 14
+    Http.Methods.size.should == 33
   end
 
   it "can set a global default parser buffer size" do
@@ -27,7 +27,114 @@ describe Http::Parser do
                                                              /buffer size must be a number greater than 0/ )
   end
 
-  %w[ copy delete get head lock mkcol move options post propfind proppatch put trace unlock ].each do |m|
+  describe "dump and load" do
+    it "carries on parsing a message in a loaded parser" do
+      parser = Http::RequestParser.new
+      parser.parse_chunk( "POST /upload HTTP/1.1\r\nContent-Len" )
+
+      body = ""
+      fields = []
+      loaded = Http::Parser.load( parser.dump )
+      loaded.should be_kind_of( Http::RequestParser )
+      loaded.on_header_field { |p, data| fields << data.dup }
+      loaded.on_body { |p, data| body << data }
+      loaded.on_message_complete { |p| p.method.should == "POST" }
+      loaded.parse_chunk( "gth: 5\r\n\r\nhello" )
+      fields.should == [ "gth" ]
+      body.should == "hello"
+    end
+
+    it "loads a response parser" do
+      parser = Http::ResponseParser.new
+      parser.parse_chunk( "HTTP/1.1 200 OK\r\n" )
+      Http::ResponseParser.load( parser.dump ).should be_kind_of( Http::ResponseParser )
+    end
+
+    it "rejects a dump of the wrong kind of parser" do
+      dump = Http::ResponseParser.new.dump
+      lambda { Http::RequestParser.load( dump ) }.should raise_error( ArgumentError )
+    end
+
+    it "rejects anything else" do
+      lambda { Http::Parser.load( "garbage" ) }.should raise_error( ArgumentError )
+    end
+
+    it "rejects a dump with a state the parser does not have" do
+      parser = Http::RequestParser.new
+      parser.parse_chunk( "GET / HTTP/1.1\r\n" )
+      dump = parser.dump
+      dump[6, 4] = [ 0x7fffffff ].pack( "V" )
+      lambda { Http::RequestParser.load( dump ) }.should raise_error( ArgumentError )
+    end
+
+    it "rejects a dump with sizes the parser cannot have reached" do
+      parser = Http::RequestParser.new
+      parser.parse_chunk( "GET / HTTP/1.1\r\nHost: exam" )
+      dump = parser.dump
+      method_size = dump.getbyte( 76 )
+      dump[77 + method_size + 2, 8] = [ 1 << 40 ].pack( "Q<" )
+      lambda { Http::RequestParser.load( dump ) }.should raise_error( ArgumentError )
+    end
+
+    it "rejects a dump with flags a parser cannot have between calls" do
+      parser = Http::RequestParser.new
+      parser.parse_chunk( "POST / HTTP/1.1\r\nContent-Length: 10\r\n\r\nhello" )
+      dump = parser.dump
+      Http::RequestParser.load( dump ).should be_kind_of( Http::RequestParser )
+      # the error and inplace bits
+      [ 0x02, 0x10 ].each do |bit|
+        bad = dump.dup
+        bad.setbyte( 10, bad.getbyte( 10 ) | bit )
+        lambda { Http::RequestParser.load( bad ) }.should raise_error( ArgumentError )
+      end
+    end
+
+    it "cannot dump from a callback of parse_chunk!" do
+      parser = Http::ResponseParser.new
+      error = nil
+      parser.on_body do |p, data|
+        begin
+          p.dump
+        rescue Http::Parser::Error => e
+          error = e
+        end
+      end
+      parser.parse_chunk!( "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello" )
+      error.should be_kind_of( Http::Parser::Error )
+    end
+  end
+
+  describe "parse_chunks" do
+    it "parses a chunk with each parser" do
+      a = Http::RequestParser.new
+      b = Http::ResponseParser.new
+      bodies = [ "", "" ]
+      a.on_body { |p, data| bodies[0] << data }
+      b.on_body { |p, data| bodies[1] << data }
+      Http::Parser.parse_chunks( [ a, b ], [ "POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\nab",
+                                             "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nxyz" ] ).should == [ 40, 41 ]
+      Http::Parser.parse_chunks( [ a ], [ "cd" ] ).should == [ 2 ]
+      bodies.should == [ "abcd", "xyz" ]
+    end
+
+    it "parses every chunk before raising for the first parser that failed" do
+      a = Http::RequestParser.new
+      b = Http::RequestParser.new
+      done = false
+      b.on_message_complete { |p| done = true }
+      lambda {
+        Http::Parser.parse_chunks( [ a, b ], [ "GET / HTTP/1.1\r\n\x01", "GET / HTTP/1.1\r\n\r\n" ] )
+      }.should raise_error( Http::Parser::Error )
+      done.should == true
+    end
+
+    it "needs a chunk for each parser" do
+      lambda { Http::Parser.parse_chunks( [ Http::RequestParser.new ], [] ) }.should raise_error( ArgumentError )
+    end
+  end
+
+  %w[ connect copy delete get head lock mkcol move options post propfind proppatch put trace unlock
+      patch search purge report mkcalendar m-search ].each do |m|
     m.upcase!
     it "should have the #{m} method" do
       Http.Methods.include?( m ).should == true
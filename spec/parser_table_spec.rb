@@ -0,0 +1,103 @@
+require File.expand_path( File.join( File.dirname( __FILE__ ), "spec_helper.rb" ) )
+
+require 'http/parser'
+
+describe Http::ParserTable do
+  before( :each ) do
+    @table    = Http::ParserTable.new( 4 )
+    @bodies   = Hash.new { |h, k| h[k] = "" }
+    @complete = []
+    @table.on_body = lambda { |slot, data| @bodies[slot] << data }
+    @table.on_message_complete = lambda { |slot| @complete << slot }
+  end
+
+  it "has a slot per connection" do
+    @table.size.should == 4
+  end
+
+  it "parses connections interleaved a piece at a time" do
+    @table.parse_chunk( 0, "POST /a HTTP/1.1\r\nContent-Length: 10\r\n\r\nab" )
+    @table.parse_chunk( 1, "POST /b HTTP/1.1\r\nContent-Length: 6\r\n\r\nxy" )
+    @table.parse_chunk( 0, "cdef" )
+    @table.parse_chunk( 1, "zw" )
+    @table.parse_chunk( 0, "ghij" )
+    @table.parse_chunk( 1, "uv" )
+    @bodies[0].should == "abcdefghij"
+    @bodies[1].should == "xyzwuv"
+    @complete.should == [ 0, 1 ]
+  end
+
+  it "parses chunked bodies" do
+    @table.parse_chunk( 2, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n8\r\nab" )
+    @table.parse_chunk( 2, "cd" )
+    @table.parse_chunk( 2, "efgh\r\n0\r\n\r\n" )
+    @bodies[2].should == "abcdefgh"
+    @complete.should == [ 2 ]
+  end
+
+  it "parses one message after another in a slot" do
+    2.times do
+      @table.parse_chunk( 3, "POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\nab" )
+      @table.parse_chunk( 3, "cd" )
+    end
+    @bodies[3].should == "abcdabcd"
+    @complete.should == [ 3, 3 ]
+  end
+
+  it "reads a response body until the connection is finished" do
+    table = Http::ParserTable.new( 2, :response )
+    body  = ""
+    done  = false
+    table.on_body = lambda { |slot, data| body << data }
+    table.on_message_complete = lambda { |slot| done = true }
+    table.parse_chunk( 1, "HTTP/1.0 200 OK\r\n\r\nhello" )
+    table.parse_chunk( 1, " world" )
+    done.should == false
+    table.finish( 1 )
+    body.should == "hello world"
+    done.should == true
+  end
+
+  it "keeps an error to the slot it happened in" do
+    @table.parse_chunk( 1, "POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\nab" )
+    lambda { @table.parse_chunk( 0, "GET / HTTP/1.1\r\n\x01" ) }.should raise_error( Http::Parser::Error )
+    @table.error?( 0 ).should == true
+    @table.error?( 1 ).should == false
+    @table.parse_chunk( 1, "cd" )
+    @bodies[1].should == "abcd"
+  end
+
+  it "stops a body when on_body raises, and reraises what it raised" do
+    calls = 0
+    @table.on_body = lambda { |slot, data| calls += 1; raise ArgumentError, "stop #{slot}" if calls == 2 }
+    @table.parse_chunk( 0, "POST / HTTP/1.1\r\nContent-Length: 10\r\n\r\nab" )
+    error = nil
+    begin
+      @table.parse_chunk( 0, "cd" )
+    rescue => e
+      error = e
+    end
+    error.should be_kind_of( ArgumentError )
+    error.message.should == "stop 0"
+    error.backtrace.first.should =~ /parser_table_spec/
+    @table.error?( 0 ).should == true
+  end
+
+  it "reraises what on_message_complete raised" do
+    @table.on_message_complete = lambda { |slot| raise IOError, "done #{slot}" }
+    lambda { @table.parse_chunk( 2, "GET / HTTP/1.1\r\n\r\n" ) }.should raise_error( IOError, "done 2" )
+    lambda { @table.parse_chunk( 3, "\x01" ) }.should raise_error( Http::Parser::Error )
+  end
+
+  it "starts a new connection in a slot that is opened again" do
+    lambda { @table.parse_chunk( 0, "\x01" ) }.should raise_error( Http::Parser::Error )
+    @table.open( 0 )
+    @table.error?( 0 ).should == false
+    @table.parse_chunk( 0, "POST / HTTP/1.1\r\nContent-Length: 2\r\n\r\nok" )
+    @bodies[0].should == "ok"
+  end
+
+  it "raises IndexError for a slot outside the table" do
+    lambda { @table.parse_chunk( 4, "" ) }.should raise_error( IndexError )
+  end
+end
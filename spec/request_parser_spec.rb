@@ -35,6 +35,15 @@ describe Http::RequestParser do
     @parser.parse( @firefox )
   end
 
+  it "can detect multi-digit HTTP versions" do
+    version = nil
+    @parser.on_headers_complete do |p|
+      version = p.version
+    end
+    @parser.parse_chunk( "GET / HTTP/10.12\r\n\r\n" )
+    version.should == "10.12"
+  end
+
   it "knows if keep alive was used" do
     @parser.on_message_complete do |p|
       p.should be_keep_alive
@@ -42,6 +51,63 @@ describe Http::RequestParser do
     @parser.parse( @firefox )
   end
 
+  it "knows if the client expects a 100 Continue before the body" do
+    expect_continue = nil
+    @parser.on_headers_complete do |p|
+      expect_continue = p.expect_continue?
+    end
+    @parser.parse_chunk( "PUT /upload HTTP/1.1\r\nContent-Length: 5\r\nExpect: 100-Continue\r\n\r\n" )
+    expect_continue.should == true
+    @parser.parse_chunk( "hello" )
+    @parser.should_not be_expect_continue
+  end
+
+  describe "header token lists" do
+    before( :each ) do
+      @seen = nil
+    end
+
+    def parse_headers( headers )
+      @parser.on_headers_complete { |p| @seen = yield( p ) }
+      @parser.parse_chunk( "POST / HTTP/1.1\r\n#{headers}\r\n\r\n" )
+    end
+
+    it "finds chunked as the last of several transfer codings" do
+      parse_headers( "Transfer-Encoding: gzip, chunked" ) { |p| p.chunked_encoding? }
+      @seen.should == true
+    end
+
+    it "rejects a request whose last transfer coding is not chunked" do
+      [ "gzip", "chunked, gzip" ].each do |codings|
+        @parser = Http::RequestParser.new
+        lambda { parse_headers( "Transfer-Encoding: #{codings}" ) { |p| true } }.should raise_error( Http::Parser::Error ) { |e|
+          e.code.should == :invalid_transfer_encoding
+        }
+        @seen.should == nil
+      end
+    end
+
+    it "takes chunked from a later Transfer-Encoding header" do
+      parse_headers( "Transfer-Encoding: gzip\r\nTransfer-Encoding: chunked" ) { |p| p.chunked_encoding? }
+      @seen.should == true
+    end
+
+    it "finds close amongst other connection options" do
+      parse_headers( "Connection: close, TE" ) { |p| p.keep_alive? }
+      @seen.should == false
+    end
+
+    it "lets close win over keep-alive" do
+      parse_headers( "Connection: keep-alive,close" ) { |p| p.keep_alive? }
+      @seen.should == false
+    end
+
+    it "finds upgrade amongst other connection options" do
+      @parser.parse_chunk( "GET /chat HTTP/1.1\r\nUpgrade: websocket\r\nConnection: keep-alive, Upgrade\r\n\r\n" )
+      @parser.should be_upgrade
+    end
+  end
+
   it "resets the parser automatically after on_message_complete" do
     @parser.keep_alive?.should == false
     keep_alive = nil
@@ -75,6 +141,50 @@ describe Http::RequestParser do
       header_values.size.should == 8 
     end
 
+    it "joins folded header lines onto the value with a single space" do
+      value = ""
+      @p.on_header_value do |p,data|
+        value << data
+      end
+      @p.parse_chunk( "GET / HTTP/1.1\r\nX-Folded: first\r\n \t second\r\n\tthird\r\n\r\n" )
+      value.should == "first second third"
+    end
+
+    it "only calls back for the interesting headers" do
+      headers = []
+      @p.interesting_headers = %w[ host KEEP-ALIVE ]
+      @p.on_header_field { |p,data| headers << [ data.dup ] }
+      @p.on_header_value { |p,data| headers.last << data.dup }
+      @p.parse( @firefox )
+      headers.should == [ [ "Host", "0.0.0.0=5000" ], [ "Keep-Alive", "300" ] ]
+    end
+
+    it "gives each interesting header name whole when it is split across chunks" do
+      fields = []
+      @p.interesting_headers = [ "Content-Type" ]
+      @p.on_header_field { |p,data| fields << data.dup }
+      "GET / HTTP/1.1\r\nContent-Length: 0\r\nContent-Type: text/plain\r\n\r\n".each_char { |c| @p.parse_chunk( c ) }
+      fields.should == [ "Content-Type" ]
+    end
+
+    it "keeps the interesting headers it had if a name is rejected" do
+      fields = []
+      @p.interesting_headers = [ "Host" ]
+      lambda { @p.interesting_headers = [ "Accept", "x" * 65 ] }.should raise_error( ArgumentError )
+      @p.on_header_field { |p,data| fields << data.dup }
+      @p.parse( @firefox )
+      fields.should == [ "Host" ]
+    end
+
+    it "flags trailing headers delivered to the header callbacks" do
+      fields = []
+      @p.on_header_field do |p,data|
+        fields << [ data.dup, p.trailer? ]
+      end
+      @p.parse( IO.read( http_req_file( "trailing_headers" ) ) )
+      fields.should == [ [ "Transfer-Encoding", false ], [ "Vary", true ], [ "Content-Type", true ] ]
+    end
+
     it "can set an 'on_body' callback" do
       body = nil
       @p.on_body do |p,data|
@@ -85,6 +195,20 @@ describe Http::RequestParser do
       body.length.should == 30
     end
 
+    it "can set chunk callbacks" do
+      events = []
+      @p.on_chunk_extension { |p,data| events << [ :ext, data.dup ] }
+      @p.on_chunk_header    { |p| events << [ :header, p.chunk_size ] }
+      @p.on_body            { |p,data| events << [ :body, data.dup ] }
+      @p.on_chunk_complete  { |p| events << [ :complete ] }
+      @p.parse( IO.read( http_req_file( "bullshit_after_the_length" ) ) )
+      events.should == [ [ :ext, "; ihatew3;whatthefuck=aretheseparametersfor" ],
+                         [ :header, 5 ], [ :body, "hello" ], [ :complete ],
+                         [ :ext, "; blahblah; blah" ],
+                         [ :header, 6 ], [ :body, " world" ], [ :complete ],
+                         [ :header, 0 ], [ :complete ] ]
+    end
+
     it "can set an 'on_path' callback" do
       path = nil
       @p.on_path do |p, data|
@@ -144,9 +268,29 @@ describe Http::RequestParser do
     end
 
     it "raises an exception if there is an error in parsing" do
-      lambda { @p.parse( "hello world" ) }.should raise_error( Http::Parser::Error, /Failure during parsing of chunk/ )
+      lambda { @p.parse( "hello world\r\n" ) }.should raise_error( Http::Parser::Error, /Failure during parsing of chunk/ )
       @p.callback_exception.should == nil
     end
+
+    it "reports the error code and offset of the failing byte" do
+      error = nil
+      begin
+        @p.parse( "GET /hello HTTP/1.x\r\n\r\n" )
+      rescue Http::Parser::Error => e
+        error = e
+      end
+      error.code.should == :invalid_version
+      error.offset.should == 18
+      @p.error_code.should == :invalid_version
+      @p.error_offset.should == 18
+    end
+
+    it "reports a callback abort as the error code" do
+      @p.on_uri do |p, data|
+        raise "Woops!"
+      end
+      lambda { @p.parse( @uri ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :callback_abort }
+    end
   end
 
   describe "HTTP Methods" do
@@ -170,6 +314,384 @@ describe Http::RequestParser do
       end
       @parser.parse( IO.read( http_req_file("head_three_headers" )))
     end
+
+    it "PATCH" do
+      method = nil
+      @parser.on_message_complete { |p| method = p.method }
+      @parser.parse( "PATCH /users/1 HTTP/1.1\r\nContent-Length: 2\r\n\r\n{}" )
+      method.should == Http::PATCH
+    end
+
+    it "passes extension methods to on_extension_method" do
+      seen = []
+      method = nil
+      @parser.on_extension_method { |p, m| seen << m }
+      @parser.on_message_complete { |p| method = p.method }
+      @parser.parse( "BREW /pot-1 HTTP/1.1\r\n\r\n" )
+      seen.should == [ "BREW" ]
+      method.should == "BREW"
+    end
+
+    it "can reject extension methods" do
+      @parser.on_extension_method { |p, m| raise "no #{m} here" }
+      lambda { @parser.parse( "BREW /pot-1 HTTP/1.1\r\n\r\n" ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :callback_abort }
+    end
+  end
+
+  describe "Request targets" do
+    before( :each ) do
+      @seen = {}
+      @parser.on_scheme { |p, data| @seen[:scheme] = data.dup }
+      @parser.on_host   { |p, data| @seen[:host]   = data.dup }
+      @parser.on_path   { |p, data| @seen[:path]   = data.dup }
+      @parser.on_headers_complete { |p| @seen[:port] = p.port }
+    end
+
+    it "decomposes an absolute-form target" do
+      @parser.parse_chunk( "GET http://example.com:8080/a/b?c=d HTTP/1.1\r\n\r\n" )
+      @seen.should == { :scheme => "http", :host => "example.com", :port => 8080, :path => "/a/b" }
+    end
+
+    it "has no port if the absolute-form target does not give one" do
+      @parser.parse_chunk( "GET https://example.com HTTP/1.1\r\n\r\n" )
+      @seen.should == { :scheme => "https", :host => "example.com", :port => nil }
+    end
+
+    it "gives IPv6 literal hosts without their brackets" do
+      @parser.parse_chunk( "GET http://[::1]:80/ HTTP/1.1\r\n\r\n" )
+      @seen.should == { :scheme => "http", :host => "::1", :port => 80, :path => "/" }
+    end
+
+    it "decomposes the authority-form target of a CONNECT" do
+      @parser.parse_chunk( "CONNECT [2001:db8::1]:443 HTTP/1.1\r\n\r\n" )
+      @seen.should == { :host => "2001:db8::1", :port => 443 }
+    end
+
+    it "only accepts the authority-form for a CONNECT" do
+      lambda { @parser.parse( "CONNECT /tunnel HTTP/1.1\r\n\r\n" ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :invalid_uri }
+    end
+
+    it "rejects ports that are out of range" do
+      lambda { @parser.parse( "GET http://example.com:65536/ HTTP/1.1\r\n\r\n" ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :invalid_uri }
+    end
+  end
+
+  describe "Decoding" do
+    before( :each ) do
+      @decoded = nil
+      @parser.on_headers_complete { |p| @decoded = [ p.decoded_path, p.decoded_query_string ] }
+    end
+
+    it "does not decode unless a buffer size is given" do
+      @parser.parse( "GET /a%20b HTTP/1.1\r\n\r\n" )
+      @decoded.should == [ nil, nil ]
+    end
+
+    it "decodes the path and query string" do
+      @parser.decode_buffer_size = 64
+      @parser.parse( "GET /a%20b/c+d?q=a+b%26c HTTP/1.1\r\n\r\n" )
+      @decoded.should == [ "/a b/c+d", "q=a b&c" ]
+    end
+
+    it "decodes escapes split across chunks" do
+      @parser.decode_buffer_size = 64
+      "GET /a%2Fb?x=%7e HTTP/1.1\r\n\r\n".each_char { |c| @parser.parse_chunk( c ) }
+      @decoded.should == [ "/a/b", "x=~" ]
+    end
+
+    it "raises an error if the decoded path does not fit" do
+      @parser.decode_buffer_size = 4
+      lambda { @parser.parse( "GET /hello HTTP/1.1\r\n\r\n" ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :decode_overflow }
+    end
+
+    it "raises an error if the buffer size is not greater than 0" do
+      lambda { @parser.decode_buffer_size = 0 }.should raise_error( ArgumentError, /must be a number greater than 0/ )
+      lambda { @parser.decode_buffer_size = -1 }.should raise_error( ArgumentError, /must be a number greater than 0/ )
+    end
+  end
+
+  describe "Query params" do
+    before( :each ) do
+      @params = nil
+      @parser.collect_query_string = true
+    end
+
+    def query_params( request, *args )
+      @parser.on_headers_complete { |p| @params = p.query_params( *args ) }
+      @parser.parse( request )
+      @params
+    end
+
+    it "splits and decodes the query string" do
+      query_params( "GET /s?q=a+b%26c&lang=en&flag HTTP/1.1\r\n\r\n" ).should == { "q" => "a b&c", "lang" => "en", "flag" => nil }
+    end
+
+    it "has no params without a query string" do
+      query_params( "GET /s HTTP/1.1\r\n\r\n" ).should == {}
+    end
+
+    it "has no params unless the query string is collected" do
+      @parser.collect_query_string = false
+      query_params( "GET /s?q=1 HTTP/1.1\r\n\r\n" ).should == nil
+    end
+
+    it "still calls on_query_string while collecting" do
+      seen = nil
+      @parser.on_query_string { |p, data| seen = data }
+      query_params( "GET /s?q=1 HTTP/1.1\r\n\r\n" ).should == { "q" => "1" }
+      seen.should == "q=1"
+    end
+
+    it "freezes the keys" do
+      query_params( "GET /s?q=1 HTTP/1.1\r\n\r\n" ).keys.first.should be_frozen
+    end
+
+    it "nests Rack style keys when asked to" do
+      query_params( "GET /s?a[b]=1&a[c][]=2&a[c][]=3 HTTP/1.1\r\n\r\n", true ).should == { "a" => { "b" => "1", "c" => [ "2", "3" ] } }
+    end
+
+    it "handles a query string split across chunks" do
+      @parser.on_headers_complete { |p| @params = p.query_params }
+      "GET /s?first=1&second=2 HTTP/1.1\r\n\r\n".each_char { |c| @parser.parse_chunk( c ) }
+      @params.should == { "first" => "1", "second" => "2" }
+    end
+
+    it "still calls on_query_string" do
+      qs = nil
+      @parser.on_query_string { |p, data| qs = data.dup }
+      query_params( "GET /s?q=1 HTTP/1.1\r\n\r\n" ).should == { "q" => "1" }
+      qs.should == "q=1"
+    end
+  end
+
+  describe "Routing" do
+    before( :each ) do
+      router = Http::Router.new
+      router.add( "/", :root )
+      router.add( "/users/:id", :user )
+      router.add( "/users/new", :new_user )
+      router.add( "/users/:id/posts/:post", :post )
+      @parser.router = router
+      @routed = nil
+      @parser.on_route { |p| @routed = [ p.route, p.route_params ] }
+    end
+
+    it "routes the path before the headers are parsed" do
+      @parser.parse_chunk( "GET /users/42/posts/7?x=1 HTTP/1.1\r\n" )
+      @routed.should == [ :post, { "id" => "42", "post" => "7" } ]
+    end
+
+    it "prefers literal segments over parameters" do
+      @parser.parse_chunk( "GET /users/new HTTP/1.1\r\n\r\n" )
+      @routed.should == [ :new_user, {} ]
+    end
+
+    it "routes a path split across chunks" do
+      "GET /users/1234 HTTP/1.1\r\n\r\n".each_char { |c| @parser.parse_chunk( c ) }
+      @routed.should == [ :user, { "id" => "1234" } ]
+    end
+
+    it "has no route for a path that does not match" do
+      @parser.parse_chunk( "GET /wp-login.php HTTP/1.1\r\n\r\n" )
+      @routed.should == [ nil, {} ]
+    end
+
+    it "can reject a request from on_route" do
+      @parser.on_route { |p| raise "not found" unless p.route }
+      lambda { @parser.parse( "GET /nope HTTP/1.1\r\nHost: example.com\r\n\r\n" ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :callback_abort }
+    end
+
+    it "rejects invalid patterns" do
+      lambda { Http::Router.new.add( "users", :users ) }.should raise_error( ArgumentError )
+    end
+  end
+
+  describe "Token reassembly" do
+    before( :each ) do
+      @calls = []
+      @parser.on_path { |p,d| @calls << [ :path, d ] }
+      @parser.on_header_field { |p,d| @calls << [ :field, d ] }
+      @parser.on_header_value { |p,d| @calls << [ :value, d ] }
+    end
+
+    it "gives split strings whole" do
+      @parser.reassemble_tokens = 256
+      @parser.parse_chunk( "GET /some/lo" )
+      @parser.parse_chunk( "ng/path HTTP/1.1\r\nHo" )
+      @parser.parse_chunk( "st: exa" )
+      @parser.parse_chunk( "mple.com\r\n\r\n" )
+      @calls.should == [ [ :path, "/some/long/path" ], [ :field, "Host" ], [ :value, "example.com" ] ]
+    end
+
+    it "keeps long split strings in its arena" do
+      @parser.reassemble_tokens = 64
+      value = "v" * 300
+      2.times do
+        @parser.parse_chunk( "GET / HTTP/1.1\r\nX-Long: " + value[0,100] )
+        @parser.parse_chunk( value[100,100] )
+        @parser.parse_chunk( value[200,100] + "\r\n\r\n" )
+      end
+      @calls.should == [ [ :path, "/" ], [ :field, "X-Long" ], [ :value, value ] ] * 2
+    end
+
+    it "gives split strings in pieces without it" do
+      @parser.parse_chunk( "GET /some/lo" )
+      @parser.parse_chunk( "ng/path HTTP/1.1\r\n\r\n" )
+      @calls.should == [ [ :path, "/some/lo" ], [ :path, "ng/path" ] ]
+    end
+
+    it "has an error for a split string without an arena" do
+      @parser.reassemble_tokens = 0
+      @parser.parse_chunk( "GET / HTTP/1.1\r\n" )
+      lambda { @parser.parse_chunk( "X-Long: " + "a" * 10 ) }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :token_overflow }
+    end
+  end
+
+  describe "Collected headers" do
+    before( :each ) do
+      @parser.collect_headers = true
+    end
+
+    it "looks headers up case-insensitively" do
+      seen = nil
+      @parser.on_headers_complete do |p|
+        seen = [ p.header( "host" ), p.header( "X-CUSTOM" ), p.header( "Cookie" ) ]
+      end
+      @parser.parse_chunk( "GET / HTTP/1.1\r\nHost: exa" )
+      @parser.parse_chunk( "mple.com\r\nX-Custom: 1\r\n\r\n" )
+      seen.should == [ "example.com", "1", nil ]
+    end
+
+    it "joins folded values" do
+      seen = nil
+      @parser.on_headers_complete { |p| seen = p.header( "X-Folded" ) }
+      @parser.parse( "GET / HTTP/1.1\r\nX-Folded: a\r\n  b\r\n\r\n" )
+      seen.should == "a b"
+    end
+
+    it "joins many folded lines, split across chunks" do
+      seen = nil
+      @parser.on_headers_complete { |p| seen = p.header( "X-Folded" ) }
+      @parser.parse_chunk( "GET / HTTP/1.1\r\nX-Folded: a" )
+      40.times { |i| @parser.parse_chunk( "\r\n l#{i}" ) }
+      @parser.parse_chunk( "\r\n\r\n" )
+      seen.should == ( [ "a" ] + ( 0...40 ).map { |i| "l#{i}" } ).join( " " )
+    end
+
+    it "starts over for every message" do
+      seen = []
+      @parser.on_headers_complete { |p| seen << p.header( "X-One" ) }
+      @parser.parse( "GET / HTTP/1.1\r\nX-One: 1\r\n\r\nGET / HTTP/1.1\r\nX-Two: 2\r\n\r\n" )
+      seen.should == [ "1", nil ]
+    end
+
+    it "gives them all as ParsedHeaders that outlive the message" do
+      headers = nil
+      @parser.on_headers_complete { |p| headers = p.headers }
+      @parser.parse( "GET / HTTP/1.1\r\nHost: a\r\nX-Foo: 1\r\nCookie: c\r\nx-foo: 2\r\n\r\n" )
+      headers.should be_kind_of( Http::ParsedHeaders )
+      headers.keys.should == [ "Host", "X-Foo", "Cookie" ]
+      headers["x-FOO"].should == [ "1", "2" ]
+      headers.fetch( "HOST" ).should == "a"
+      headers["Accept"].should == nil
+      headers.should be_key( "cookie" )
+      headers.size.should == 3
+      headers.to_hash.should == { "Host" => "a", "X-Foo" => [ "1", "2" ], "Cookie" => "c" }
+    end
+
+    it "groups many repeated custom headers by name" do
+      headers = nil
+      @parser.on_headers_complete { |p| headers = p.headers }
+      lines = ( 0...60 ).map { |i| "X-H#{i % 20}: #{i}\r\n" }.join
+      @parser.parse( "GET / HTTP/1.1\r\n#{lines}x-h3: last\r\n\r\n" )
+      headers.size.should == 20
+      headers.keys.should == ( 0...20 ).map { |i| "X-H#{i}" }
+      headers["X-H3"].should == [ "3", "23", "43", "last" ]
+      headers.values.last.should == [ "19", "39", "59" ]
+    end
+
+    it "looks up a repeated header before going through the headers" do
+      headers = nil
+      @parser.on_headers_complete { |p| headers = p.headers }
+      @parser.parse( "GET / HTTP/1.1\r\nX-A: 1\r\nHost: h\r\nx-a: 2\r\nX-B: 3\r\nX-A: 4\r\n\r\n" )
+      headers["X-a"].should == [ "1", "2", "4" ]
+      headers["Host"].should == "h"
+      headers.keys.should == [ "X-A", "Host", "X-B" ]
+      headers["x-A"].should == [ "1", "2", "4" ]
+    end
+  end
+
+  describe "Upgrades" do
+    it "stops at the end of the headers of a WebSocket handshake" do
+      handshake = "GET /chat HTTP/1.1\r\nHost: example.com\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n"
+      completed = 0
+      @parser.on_message_complete { |p| completed += 1 }
+      @parser.parse_chunk( handshake + "\x81\x05hello" ).should == handshake.size
+      @parser.should be_upgrade
+      completed.should == 1
+      @parser.parse_chunk( "GET / HTTP/1.1\r\n\r\n" ).should == 0
+    end
+
+    it "does not stop for Connection: Upgrade without an Upgrade header" do
+      request = "GET /chat HTTP/1.1\r\nHost: example.com\r\nConnection: Upgrade\r\n\r\n"
+      completed = 0
+      @parser.on_message_complete { |p| completed += 1 }
+      @parser.parse_chunk( request + request ).should == request.size * 2
+      @parser.should_not be_upgrade
+      completed.should == 2
+    end
+
+    it "does not stop for an empty Upgrade header" do
+      request = "GET /chat HTTP/1.1\r\nHost: example.com\r\nUpgrade:\r\nConnection: Upgrade\r\n\r\n"
+      completed = 0
+      @parser.on_message_complete { |p| completed += 1 }
+      @parser.parse_chunk( request + request ).should == request.size * 2
+      @parser.should_not be_upgrade
+      completed.should == 2
+    end
+
+    it "stops at the end of the headers of a CONNECT" do
+      connect = "CONNECT example.com:443 HTTP/1.1\r\nHost: example.com:443\r\n\r\n"
+      @parser.parse_chunk( connect + "\x16\x03\x01" ).should == connect.size
+      @parser.should be_upgrade
+      @parser.method.should == "CONNECT"
+    end
+  end
+
+  describe "Headers only" do
+    before( :each ) do
+      @parser.headers_only = true
+      @completed = 0
+      @parser.on_message_complete { |p| @completed += 1 }
+    end
+
+    it "stops at the start of the body and returns its offset" do
+      headers = "POST /upload HTTP/1.1\r\nContent-Length: 10\r\n\r\n"
+      @parser.parse_chunk( headers + "0123" ).should == headers.size
+      @parser.should be_body_pending
+      @parser.consume_body( 4 ).should == 4
+      @parser.consume_body( 10 ).should == 6
+      @parser.should_not be_body_pending
+      @completed.should == 1
+      @parser.parse_chunk( "GET / HTTP/1.1\r\n\r\n" ).should == 18
+      @completed.should == 2
+    end
+
+    it "leaves a chunked body to parse_chunk" do
+      headers = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+      body = "3\r\nabc\r\n0\r\n\r\n"
+      @parser.parse_chunk( headers + body ).should == headers.size
+      @parser.should be_body_pending
+      @parser.consume_body( 3 ).should == 0
+      @parser.parse_chunk( body ).should == body.size
+      @completed.should == 1
+    end
+
+    it "does not stop for a request without a body" do
+      @parser.parse_chunk( "GET / HTTP/1.1\r\n\r\n" ).should == 18
+      @parser.should_not be_body_pending
+      @completed.should == 1
+    end
   end
 
   describe "Parses files" do
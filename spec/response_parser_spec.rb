@@ -71,6 +71,118 @@ describe Http::ResponseParser do
     lambda { @parser.parse( IO.read( http_res_file( "200_headers_0_chunked" ) ) ) }.should raise_error( Http::Parser::Error, /Failure during parsing of chunk/ )
   end
 
+  describe "responses without a body" do
+    before( :each ) do
+      @statuses = []
+      @parser.on_message_complete do |p|
+        @statuses << p.status_code
+      end
+      @next = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nhi"
+    end
+
+    [ 100, 204, 304 ].each do |code|
+      it "#{code} ignores the Content-Length" do
+        @parser.parse_chunk( "HTTP/1.1 #{code} Whatever\r\nContent-Length: 42\r\n\r\n" + @next )
+        @statuses.should == [ code, 200 ]
+      end
+    end
+
+    it "can be told to skip the body of a response to HEAD" do
+      @parser.skip_body = true
+      @parser.parse_chunk( "HTTP/1.1 200 OK\r\nContent-Length: 42\r\n\r\n" + @next )
+      @statuses.should == [ 200, 200 ]
+      @parser.should_not be_skip_body
+    end
+  end
+
+  describe "responses without framing" do
+    before( :each ) do
+      @body = ""
+      @completed = 0
+      @parser.on_body { |p,d| @body << d }
+      @parser.on_message_complete { |p| @completed += 1 }
+    end
+
+    it "reads the body until finish" do
+      @parser.parse_chunk( "HTTP/1.0 200 OK\r\nServer: legacy\r\n\r\nhello" )
+      @parser.parse_chunk( " world" )
+      @completed.should == 0
+      @parser.should_not be_keep_alive
+      @parser.finish
+      @completed.should == 1
+      @body.should == "hello world"
+    end
+
+    it "reads the body until finish if the last transfer coding is not chunked" do
+      @parser.parse_chunk( "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked, gzip\r\nContent-Length: 2\r\n\r\nhello" )
+      @parser.parse_chunk( " world" )
+      @completed.should == 0
+      @parser.finish
+      @completed.should == 1
+      @body.should == "hello world"
+    end
+
+    it "finishes when parsing an IO" do
+      File.open( http_res_file( "missing_reason_phrase" ) ) do |f|
+        @parser.parse( f, 10 )
+      end
+      @completed.should == 1
+    end
+
+    it "has an error if finished in the middle of a message" do
+      @parser.parse_chunk( "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nhello" )
+      lambda { @parser.finish }.should raise_error( Http::Parser::Error ) { |e| e.code.should == :invalid_eof_state }
+    end
+  end
+
+  describe "forwarding bodies" do
+    before( :each ) do
+      @ranges = []
+      @parser.on_body { |p,d| raise "on_body called" }
+      @parser.on_body_range { |p,o,l| @ranges << [ :body, o, l ] }
+      @parser.on_framing_range { |p,o,l| @ranges << [ :framing, o, l ] }
+    end
+
+    it "gives the stream offsets of a Content-Length body" do
+      headers = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n"
+      @parser.parse_chunk( headers + "01234" )
+      @parser.parse_chunk( "56789" )
+      @ranges.should == [ [ :body, headers.size, 5 ], [ :body, headers.size + 5, 5 ] ]
+      @parser.stream_offset.should == headers.size + 10
+    end
+
+    it "splits a chunked body into payload and framing" do
+      headers = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+      body = "3\r\nabc\r\n4\r\ndefg\r\n0\r\n\r\n"
+      @parser.parse_chunk( headers + body[0,10] )
+      @parser.parse_chunk( body[10..-1] )
+      h = headers.size
+      @ranges.should == [ [ :framing, h, 3 ], [ :body, h + 3, 3 ],
+                          [ :framing, h + 6, 4 ],
+                          [ :framing, h + 10, 1 ], [ :body, h + 11, 4 ],
+                          [ :framing, h + 15, 7 ] ]
+    end
+  end
+
+  describe "parse_chunk!" do
+    it "moves a chunked body together and calls on_body once" do
+      bodies = []
+      @parser.on_body { |p,d| bodies << d }
+      chunk = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n" +
+              "3\r\nabc\r\n4;x=y\r\ndefg\r\n0\r\n\r\n"
+      @parser.parse_chunk!( chunk ).should == chunk.size
+      bodies.should == [ "abcdefg" ]
+    end
+
+    it "calls on_body once per call for a body split across calls" do
+      bodies = []
+      @parser.on_body { |p,d| bodies << d }
+      @parser.parse_chunk!( "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2\r\nab\r\n3\r\nc" )
+      @parser.parse_chunk!( "de\r\n0\r\n\r\n" )
+      bodies.should == [ "abc", "de" ]
+    end
+  end
+
   it "knows the content length" do
     cl = nil
     @parser.on_headers_complete do |p|
@@ -81,7 +193,7 @@ describe Http::ResponseParser do
   end
 
   it "knows what its callbacks are" do
-    @parser.callback_methods.size.should == 7
+    @parser.callback_methods.size.should == 12
   end
 
 
@@ -25,4 +25,22 @@ describe Http::Response do
     @response.status_line.should == "HTTP/1.1 200 OK\r\n"
   end
 
+  it "collects the trailing headers of a chunked response" do
+    File.open( http_res_file( "with_trailers" ) ) do |f|
+      @parser.bind_and_parse( @response, f, 7 )
+    end
+    @response.headers['Trailer'].should == "Grpc-Status, Grpc-Message"
+    @response.headers['Grpc-Status'].should == nil
+    @response.body.string.should == "hello world"
+    @response.trailers['Grpc-Status'].should == "0"
+    @response.trailers['grpc-message'].should == "OK"
+  end
+
+  it "has no trailers for an identity response" do
+    File.open( http_res_file( "google" ) ) do |f|
+      @parser.bind_and_parse( @response, f )
+    end
+    @response.trailers.should be_empty
+  end
+
 end